@@ -85,7 +85,18 @@ void BackendProcessor::getStateInformation(MemoryBlock &destData)
 {
 	MemoryOutputStream output(destData, false);
 
-	ValueTree v = synthChain->exportAsValueTree();
+	createStateTree().writeToStream(output);
+}
+
+bool BackendProcessor::isCurrentState(const ValueTree& v)
+{
+	return v.isValid() && createStateTree().isEquivalentTo(v);
+}
+
+ValueTree BackendProcessor::createStateTree()
+{
+	// Only the processors that changed since the last save are exported again
+	ValueTree v = synthChain->exportAsValueTreeCached();
 
 	v.setProperty("ProjectRootFolder", GET_PROJECT_HANDLER(synthChain).getWorkDirectory().getFullPathName(), nullptr);
 
@@ -96,7 +107,7 @@ void BackendProcessor::getStateInformation(MemoryBlock &destData)
 
 	v.setProperty("InterfaceData", JSON::toString(editorInformation, true), nullptr);
 
-	v.writeToStream(output);
+	return v;
 }
 
 AudioProcessorEditor* BackendProcessor::createEditor()
@@ -90,6 +90,10 @@ public:
 	{
 		ValueTree v = ValueTree::readFromData(data, sizeInBytes);
 
+		// The host passes back the state we're already in, so there's no need to rebuild the whole tree.
+		if (isCurrentState(v))
+			return;
+
 		String fileName = v.getProperty("ProjectRootFolder", String());
 
 		if (fileName.isNotEmpty())
@@ -170,6 +174,16 @@ public:
 	void setEditorData(var editorState);
 private:
 
+	/** Checks if the given host state is equivalent to the state the plugin would save right now.
+	*
+	*	Hosts often restore the state they've just saved (undo snapshots, reopening a project). This uses the cached 
+	*	export, so the check costs as much as the next save.
+	*/
+	bool isCurrentState(const ValueTree& v);
+
+	/** Creates the tree that is saved in the host state. */
+	ValueTree createStateTree();
+
 	friend class BackendProcessorEditor;
 	friend class BackendCommandTarget;
 	friend class CombinedDebugArea;
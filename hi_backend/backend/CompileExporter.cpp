@@ -160,18 +160,23 @@ ValueTree BaseExporter::collectAllSampleMapsInDirectory()
 
 	Array<File> sampleMapFiles;
 
-	sampleMapDirectory.findChildFiles(sampleMapFiles, File::findFiles, true, "*.xml");
+	sampleMapDirectory.findChildFiles(sampleMapFiles, File::findFiles, true, "*.xml;*" + SampleMap::getBinaryFileExtension());
 
 	for (int i = 0; i < sampleMapFiles.size(); i++)
 	{
         if(sampleMapFiles[i].isHidden() || sampleMapFiles[i].getFileName().startsWith("."))
             continue;
+
+		// Skip the file if there is a newer version with the other format
+		const File& f = sampleMapFiles[i];
+
+		if (SampleMap::getSampleMapFile(f.getParentDirectory(), f.getFileNameWithoutExtension()) != f)
+			continue;
         
-		ScopedPointer<XmlElement> xml = XmlDocument::parse(sampleMapFiles[i]);
+		ValueTree sampleMap = SampleMap::loadValueTreeFromFile(sampleMapFiles[i]);
 
-		if (xml != nullptr)
+		if (sampleMap.isValid())
 		{
-			ValueTree sampleMap = ValueTree::fromXml(*xml);
 			sampleMaps.addChild(sampleMap, -1, nullptr);
 		}
 	}
@@ -30,6 +30,241 @@
 *   ===========================================================================
 */
 
+PresetDatabase::PresetDatabase(const File& rootDirectory, const File& indexFile_) :
+	Thread("Preset Index"),
+	root(rootDirectory),
+	indexFile(indexFile_)
+{
+	if (indexFile.existsAsFile())
+	{
+		FileInputStream fis(indexFile);
+
+		ValueTree storedIndex = ValueTree::readFromStream(fis);
+
+		if (storedIndex.isValid() && storedIndex.getProperty("Path").toString() == root.getFullPathName())
+			index = storedIndex;
+	}
+
+	startThread(3);
+}
+
+PresetDatabase::~PresetDatabase()
+{
+	stopThread(3000);
+}
+
+void PresetDatabase::run()
+{
+	while (!threadShouldExit())
+	{
+		rescan();
+
+		wait(4000);
+	}
+}
+
+void PresetDatabase::rescan()
+{
+	if (!root.isDirectory())
+		return;
+
+	const ValueTree oldIndex = getIndex();
+
+	ValueTree newIndex = scanDirectory(root, oldIndex);
+
+	if (threadShouldExit() || newIndex.isEquivalentTo(oldIndex))
+		return;
+
+	{
+		ScopedLock il(indexLock);
+		index = newIndex;
+	}
+
+	if (indexFile != File())
+	{
+		indexFile.deleteFile();
+
+		FileOutputStream fos(indexFile);
+		newIndex.writeToStream(fos);
+	}
+
+	triggerAsyncUpdate();
+}
+
+void PresetDatabase::handleAsyncUpdate()
+{
+	for (int i = 0; i < listeners.size(); i++)
+	{
+		if (listeners[i].get() != nullptr)
+			listeners[i]->databaseUpdated();
+	}
+}
+
+ValueTree PresetDatabase::getIndex() const
+{
+	ScopedLock sl(indexLock);
+	return index;
+}
+
+ValueTree PresetDatabase::scanDirectory(const File& directory, const ValueTree& oldIndex)
+{
+	static const Identifier dir("Directory");
+	static const Identifier preset("Preset");
+	static const Identifier path("Path");
+	static const Identifier modTime("ModTime");
+	static const Identifier size("Size");
+
+	ValueTree d(dir);
+
+	if (threadShouldExit())
+		return d;
+
+	d.setProperty(path, directory.getFullPathName(), nullptr);
+
+	// The directory modification time is not reliable on every file system (and doesn't change
+	// if a preset is overwritten), so every file is checked by its own modification time and size
+	Array<File> children;
+	directory.findChildFiles(children, File::findFilesAndDirectories, false);
+
+	// Look up the old entries by path without searching the whole directory for every file
+	HashMap<String, int> oldChildIndexes;
+
+	for (int i = 0; i < oldIndex.getNumChildren(); i++)
+		oldChildIndexes.set(oldIndex.getChild(i).getProperty(path).toString(), i);
+
+	for (int i = 0; i < children.size(); i++)
+	{
+		const File& f = children.getReference(i);
+
+		if (isHiddenFile(f))
+			continue;
+
+		const String filePath = f.getFullPathName();
+
+		const ValueTree oldChild = oldChildIndexes.contains(filePath) ? oldIndex.getChild(oldChildIndexes[filePath]) : ValueTree();
+
+		if (f.isDirectory())
+		{
+			d.addChild(scanDirectory(f, oldChild), -1, nullptr);
+		}
+		else if (f.hasFileExtension(".preset"))
+		{
+			const bool unchanged = oldChild.isValid() &&
+								   (int64)oldChild.getProperty(modTime) == f.getLastModificationTime().toMilliseconds() &&
+								   (int64)oldChild.getProperty(size) == f.getSize();
+
+			if (unchanged)
+				d.addChild(oldChild.createCopy(), -1, nullptr);
+			else
+				d.addChild(createPresetEntry(f), -1, nullptr);
+		}
+	}
+
+	return d;
+}
+
+ValueTree PresetDatabase::createPresetEntry(const File& presetFile)
+{
+	ValueTree p("Preset");
+
+	p.setProperty("Path", presetFile.getFullPathName(), nullptr);
+	p.setProperty("Name", presetFile.getFileNameWithoutExtension(), nullptr);
+	p.setProperty("Category", presetFile.getParentDirectory().getFileName(), nullptr);
+	p.setProperty("ModTime", presetFile.getLastModificationTime().toMilliseconds(), nullptr);
+	p.setProperty("Size", presetFile.getSize(), nullptr);
+	p.setProperty("Hash", MD5(presetFile).toHexString(), nullptr);
+
+	ScopedPointer<XmlElement> xml = XmlDocument::parse(presetFile);
+
+	if (xml != nullptr)
+		p.setProperty("Tags", xml->getStringAttribute("Tags"), nullptr);
+
+	return p;
+}
+
+static ValueTree findDirectoryInIndex(const ValueTree& parent, const String& path)
+{
+	if (parent.getProperty("Path").toString() == path)
+		return parent;
+
+	for (int i = 0; i < parent.getNumChildren(); i++)
+	{
+		ValueTree child = parent.getChild(i);
+
+		if (child.hasType("Directory") && path.startsWith(child.getProperty("Path").toString()))
+		{
+			ValueTree result = findDirectoryInIndex(child, path);
+
+			if (result.isValid())
+				return result;
+		}
+	}
+
+	return ValueTree();
+}
+
+static bool hasWordStartingWith(const String& text, const String& searchTerm, const String& separators)
+{
+	StringArray words = StringArray::fromTokens(text, separators, "");
+
+	for (int i = 0; i < words.size(); i++)
+	{
+		if (words[i].trim().startsWithIgnoreCase(searchTerm))
+			return true;
+	}
+
+	return false;
+}
+
+static void collectPresets(const ValueTree& parent, const String& searchTerm, Array<File>& results)
+{
+	for (int i = 0; i < parent.getNumChildren(); i++)
+	{
+		ValueTree child = parent.getChild(i);
+
+		if (child.hasType("Directory"))
+		{
+			collectPresets(child, searchTerm, results);
+			continue;
+		}
+
+		// Only the preset name and the tags are searched, not the folders above the preset
+		const bool matches = searchTerm.isEmpty() ||
+							 hasWordStartingWith(child.getProperty("Name").toString(), searchTerm, " _-") ||
+							 hasWordStartingWith(child.getProperty("Tags").toString(), searchTerm, ",");
+
+		if (matches)
+			results.add(File(child.getProperty("Path").toString()));
+	}
+}
+
+void PresetDatabase::getChildren(const File& directory, bool getPresets, Array<File>& results) const
+{
+	results.clear();
+
+	const ValueTree d = findDirectoryInIndex(getIndex(), directory.getFullPathName());
+
+	for (int i = 0; i < d.getNumChildren(); i++)
+	{
+		ValueTree child = d.getChild(i);
+
+		if (child.hasType(getPresets ? "Preset" : "Directory"))
+			results.add(File(child.getProperty("Path").toString()));
+	}
+}
+
+void PresetDatabase::search(const String& searchTerm, Array<File>& results) const
+{
+	results.clear();
+	collectPresets(getIndex(), searchTerm, results);
+}
+
+void PresetDatabase::getAllPresets(Array<File>& results) const
+{
+	results.clear();
+	collectPresets(getIndex(), String(), results);
+}
+
 void PresetBrowserColumn::ButtonLookAndFeel::drawButtonBackground(Graphics& /*g*/, Button& /*button*/, const Colour& /*backgroundColour*/, bool /*isMouseOverButton*/, bool /*isButtonDown*/)
 {
 
@@ -83,55 +318,22 @@ void MultiColumnPresetBrowser::ModalWindow::paint(Graphics& g)
 
 int PresetBrowserColumn::ColumnListModel::getNumRows()
 {
-    if(wildcard.isEmpty())
-    {   
-        if (!root.isDirectory())
-	    {
-		    entries.clear();
-		    return 0;
-	    }
+	return entries.size();
+}
 
-	    entries.clear();
-	    root.findChildFiles(entries, displayDirectories ? File::findDirectories : File::findFiles, false);
+void PresetBrowserColumn::ColumnListModel::updateEntries()
+{
+	entries.clear();
 
-		for (int i = 0; i < entries.size(); i++)
-		{
-			if (entries[i].isHidden() || entries[i].getFileName().startsWith("."))
-			{
-				entries.remove(i--);
-			}
-		}
-			
-	    entries.sort();
+	if (database == nullptr)
+		return;
 
-	    return entries.size();
-    }
-    else
-    {
-        Array<File> allFiles;
-        
-        totalRoot.findChildFiles(allFiles, File::findFiles, true);
-        
-        entries.clear();
-        
-        for(int i = 0; i < allFiles.size(); i++)
-        {
-            if(allFiles[i].getFullPathName().containsIgnoreCase(wildcard))
-                entries.add(allFiles[i]);
-        }
-        
-		for (int i = 0; i < entries.size(); i++)
-		{
-			if (entries[i].isHidden() || entries[i].getFileName().startsWith("."))
-			{
-				entries.remove(i--);
-			}
-		}
+	if (wildcard.isEmpty())
+		database->getChildren(root, !displayDirectories, entries);
+	else
+		database->search(wildcard, entries);
 
-        entries.sort();
-        
-        return entries.size();
-    }
+	entries.sort();
 }
 
 void PresetBrowserColumn::ColumnListModel::listBoxItemClicked(int row, const MouseEvent &e)
@@ -235,10 +437,12 @@ index(index_)
 
 	listModel = new ColumnListModel(index, listener);
 
-	
+    browser = dynamic_cast<MultiColumnPresetBrowser*>(listener);
+
 	listModel->setTotalRoot(rootDirectory);
-	
-	startTimer(4000);
+
+	if (browser != nullptr)
+		listModel->setDatabase(browser->getDatabase());
 	
 	if (index == 2)
 	{
@@ -258,32 +462,6 @@ index(index_)
 	listbox->getViewport()->setScrollOnDragEnabled(true);
 	
 	setSize(150, 300);
-    
-    browser = dynamic_cast<MultiColumnPresetBrowser*>(listener);
-}
-
-File PresetBrowserColumn::getChildDirectory(File& root, int level, int index)
-{
-	if (!root.isDirectory()) return File();
-
-	if (level == 0) return root;
-
-	Array<File> childDirectories;
-
-	root.findChildFiles(childDirectories, level > 2 ? File::findFiles : File::findDirectories, false);
-
-    for(int i = 0; i < childDirectories.size(); i++)
-    {
-        if(childDirectories[i].isHidden() ||
-           (!childDirectories[i].isDirectory() && childDirectories[i].getFileExtension() != ".preset"))
-        {
-            childDirectories.remove(i--);
-        }
-    }
-    
-    childDirectories.sort();
-
-	return childDirectories[index];
 }
 
 void PresetBrowserColumn::setNewRootDirectory(const File& newRootDirectory)
@@ -319,6 +497,7 @@ void PresetBrowserColumn::addEntry(const String &newName)
 		File newDirectory = currentRoot.getChildFile(newName);
 		newDirectory.createDirectory();
 
+		browser->rebuildAllPresets();
 		setNewRootDirectory(currentRoot);
 	}
 	else
@@ -338,8 +517,8 @@ void PresetBrowserColumn::addEntry(const String &newName)
 			{
 				UserPresetHelpers::saveUserPreset(mc->getMainSynthChain(), newPreset.getFullPathName());
 
-				setNewRootDirectory(currentRoot);
 				browser->rebuildAllPresets();
+				setNewRootDirectory(currentRoot);
 			}
 		}
 	}
@@ -409,6 +588,15 @@ mc(mc_)
 
 	mc->getUserPresetHandler().addListener(this);
 
+#if USE_BACKEND
+	const File indexFile = GET_PROJECT_HANDLER(mc->getMainSynthChain()).getWorkDirectory().getChildFile("presetIndex.dat");
+#else
+	const File indexFile = ProjectHandler::Frontend::getAppDataDirectory().getChildFile("presetIndex.dat");
+#endif
+
+	database = new PresetDatabase(rootFile, indexFile);
+	database->addListener(this);
+
 	addAndMakeVisible(bankColumn = new PresetBrowserColumn(mc, 0, rootFile, this));
 	addAndMakeVisible(categoryColumn = new PresetBrowserColumn(mc, 1, rootFile, this));
 	addAndMakeVisible(presetColumn = new PresetBrowserColumn(mc, 2, rootFile, this));
@@ -431,7 +619,8 @@ mc(mc_)
 	
 	setSize(width, height);
 
-	rebuildAllPresets();
+	// Use the stored index for now, the background thread will tell us if anything has changed
+	databaseUpdated();
 	
 	showLoadedPreset();
 
@@ -440,6 +629,7 @@ mc(mc_)
 MultiColumnPresetBrowser::~MultiColumnPresetBrowser()
 {
 	mc->getUserPresetHandler().removeListener(this);
+	database->removeListener(this);
 
 	searchBar->inputLabel->removeListener(this);
 	searchBar->inputLabel->removeListener(presetColumn);
@@ -469,20 +659,21 @@ void MultiColumnPresetBrowser::paint(Graphics& g)
 
 void MultiColumnPresetBrowser::rebuildAllPresets()
 {
-	allPresets.clear();
-	rootFile.findChildFiles(allPresets, File::findFiles, true, "*.preset");
+	// The columns will be refreshed by databaseUpdated() when the background thread has updated the index
+	database->triggerRescan();
+}
 
-	for (int i = 0; i < allPresets.size(); i++)
-	{
-		if (allPresets[i].isHidden() || allPresets[i].getFileName().startsWith("."))
-		{
-			allPresets.remove(i--);
-		}
-	}
+void MultiColumnPresetBrowser::databaseUpdated()
+{
+	database->getAllPresets(allPresets);
 
 	File f = mc->getUserPresetHandler().getCurrentlyLoadedFile();
 
 	currentlyLoadedPreset = allPresets.indexOf(f);
+
+	bankColumn->refreshEntries();
+	categoryColumn->refreshEntries();
+	presetColumn->refreshEntries();
 }
 
 String MultiColumnPresetBrowser::getCurrentlyLoadedPresetName()
@@ -630,7 +821,7 @@ void MultiColumnPresetBrowser::renameEntry(int columnIndex, int rowIndex, const
 	}
 	else if (columnIndex == 1)
 	{
-		currentCategoryFile = PresetBrowserColumn::getChildDirectory(currentBankFile, 2, rowIndex);
+		currentCategoryFile = categoryColumn->getFileForRow(rowIndex);
 
         
         
@@ -651,7 +842,7 @@ void MultiColumnPresetBrowser::renameEntry(int columnIndex, int rowIndex, const
 	}
 	else if (columnIndex == 2)
 	{
-		File presetFile = PresetBrowserColumn::getChildDirectory(currentCategoryFile, 3, rowIndex);
+		File presetFile = presetColumn->getFileForRow(rowIndex);
 
 		if (newName.isNotEmpty())
 		{
@@ -102,10 +102,81 @@ public:
     
 };
 
+/** An index of all user presets below a root directory.
+*
+*	The index contains the name, category, tags, modification time, size and content hash of every preset and is stored in
+*	the given index file. It is updated on a background thread which only parses the presets whose modification time or
+*	size has changed, so browsing and searching the presets never touches the file system.
+*/
+class PresetDatabase : public Thread,
+					   public AsyncUpdater
+{
+public:
+
+	class Listener
+	{
+	public:
+
+		virtual ~Listener() {};
+
+		/** Called on the message thread whenever the index has changed. */
+		virtual void databaseUpdated() = 0;
+
+	private:
+
+		friend class WeakReference<Listener>;
+		WeakReference<Listener>::Master masterReference;
+	};
+
+	PresetDatabase(const File& rootDirectory, const File& indexFile);
+	~PresetDatabase();
+
+	void addListener(Listener* l) { listeners.addIfNotAlreadyThere(l); }
+	void removeListener(Listener* l) { listeners.removeAllInstancesOf(l); }
+
+	/** Wakes up the background thread to update the index. Use this after you changed the files yourself.
+	*
+	*	This returns immediately, the listeners will be notified when the index has changed.
+	*/
+	void triggerRescan() { notify(); }
+
+	/** Fills the array with the sub directories or the presets of the given directory. */
+	void getChildren(const File& directory, bool getPresets, Array<File>& results) const;
+
+	/** Fills the array with all presets which have a word in their name or a tag starting with the search term. */
+	void search(const String& searchTerm, Array<File>& results) const;
+
+	/** Fills the array with all indexed presets. */
+	void getAllPresets(Array<File>& results) const;
+
+	void run() override;
+	void handleAsyncUpdate() override;
+
+private:
+
+	void rescan();
+
+	ValueTree scanDirectory(const File& directory, const ValueTree& oldIndex);
+	static ValueTree createPresetEntry(const File& presetFile);
+	static bool isHiddenFile(const File& f) { return f.isHidden() || f.getFileName().startsWith("."); }
+
+	ValueTree getIndex() const;
+
+	const File root;
+	const File indexFile;
+
+	CriticalSection indexLock;
+
+	ValueTree index;
+
+	Array<WeakReference<Listener>> listeners;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetDatabase);
+};
+
 class PresetBrowserColumn : public Component,
 	                       public ButtonListener,
-	                       public Label::Listener,
-	                       public Timer
+	                       public Label::Listener
 {
 public:
 
@@ -147,7 +218,13 @@ public:
 
 		ColumnListModel(int index_, Listener* listener_);
 
-		void setRootDirectory(const File& newRootDirectory) { root = newRootDirectory; }
+		void setRootDirectory(const File& newRootDirectory) { root = newRootDirectory; updateEntries(); }
+		void setDatabase(PresetDatabase* newDatabase) { database = newDatabase; }
+
+		/** Refreshes the entries from the preset database. */
+		void updateEntries();
+
+		File getFileForRow(int row) const { return entries[row]; }
 		void toggleEditMode() { editMode = !editMode; }
 		void setDisplayDirectories(bool shouldDisplayDirectories) { displayDirectories = shouldDisplayDirectories; }
 
@@ -180,6 +257,7 @@ public:
 		Image deleteIcon;
 
 		Listener* listener;
+		PresetDatabase* database = nullptr;
 		bool editMode = false;
 		bool displayDirectories = true;
 		Array<File> entries;
@@ -195,9 +273,19 @@ public:
 
 	PresetBrowserColumn(MainController* mc_, int index_, File& rootDirectory, ColumnListModel::Listener* listener);
 
-	static File getChildDirectory(File& root, int level, int index);
 	void setNewRootDirectory(const File& newRootDirectory);
 
+	/** Updates the list after the preset database has changed. */
+	void refreshEntries()
+	{
+		listModel->updateEntries();
+		listbox->updateContent();
+		listbox->repaint();
+		repaint();
+	}
+
+	File getFileForRow(int row) const { return listModel->getFileForRow(row); }
+
     void setEditMode(bool on) { listModel->setEditMode(on); listbox->repaint(); };
     
 	void setHighlightColourAndFont(Colour c, Font fo)
@@ -222,6 +310,7 @@ public:
 	void labelTextChanged(Label* l) override
 	{
 	    listModel->wildcard = l->getText();
+		listModel->updateEntries();
       
 	    listbox->deselectAllRows();
 	    listbox->updateContent();
@@ -235,14 +324,6 @@ public:
 		addButton->setVisible(!isResultBar);
 		editButton->setVisible(!isResultBar);
 	}
-
-	void timerCallback() override
-    {
-        if(!isVisible()) return;
-        
-	    listbox->updateContent();
-	    listbox->repaint();
-    }
 	
 	void setSelectedFile(const File& file, NotificationType notifyListeners=dontSendNotification)
 	{
@@ -304,7 +385,8 @@ class MultiColumnPresetBrowser : public Component,
 								 public Button::Listener,
 								 public PresetBrowserColumn::ColumnListModel::Listener,
 								 public Label::Listener,
-								 public MainController::UserPresetHandler::Listener
+								 public MainController::UserPresetHandler::Listener,
+								 public PresetDatabase::Listener
 {
 public:
 
@@ -646,7 +728,13 @@ public:
 		rebuildAllPresets();
 	}
 
+	/** Rescans the changed directories and updates the browser. */
 	void rebuildAllPresets();
+
+	void databaseUpdated() override;
+
+	PresetDatabase* getDatabase() { return database; }
+
 	String getCurrentlyLoadedPresetName();
 
 	void selectionChanged(int columnIndex, int rowIndex, const File& clickedFile, bool doubleClick);
@@ -742,6 +830,8 @@ private:
 	File currentBankFile;
 	File currentCategoryFile;
 
+	ScopedPointer<PresetDatabase> database;
+
 	ScopedPointer<PresetBrowserSearchBar> searchBar;
 	ScopedPointer<PresetBrowserColumn> bankColumn;
 	ScopedPointer<PresetBrowserColumn> categoryColumn;
@@ -244,6 +244,15 @@ Set this to 1 to enable hard clipping of the output (brickwall everything over 1
 #define USE_HARD_CLIPPER 0
 #endif
 
+/** Config: USE_DELAYED_RENDERING_FOR_FL_STUDIO
+
+The engine renders blocks of any size up to the size passed to prepareToPlay() directly. Set this to 1 to go back to
+the fixed-size rendering with 256 samples latency for FL Studio.
+*/
+#ifndef USE_DELAYED_RENDERING_FOR_FL_STUDIO
+#define USE_DELAYED_RENDERING_FOR_FL_STUDIO 0
+#endif
+
 /** Config: USE_SPLASH_SCREEN
 
 If your project contains a SplashScreen.png image file, it will use this as splash screen while loading the instrument in the background.
@@ -0,0 +1,308 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for cloused source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+AnalysisTap::AnalysisTap(AnalysisService& service_, int fftOrder) :
+	service(service_),
+	fftSize(1 << fftOrder),
+	active(0),
+	resetPending(0),
+	fifo(2 << fftOrder),
+	ringBuffer(2 << fftOrder, true),
+	fft(fftOrder, false),
+	window(1 << fftOrder),
+	history(1 << fftOrder, true),
+	fftData(2 << fftOrder, true),
+	envelopeHistory(envelopeSize, true),
+	spectrum((1 << fftOrder) / 2, true),
+	envelope(envelopeSize, true)
+{
+	for (int i = 0; i < fftSize; i++)
+		window[i] = 0.5f - 0.5f * cosf(2.0f * float_Pi * (float)i / (float)(fftSize - 1));
+
+	service.addTap(this);
+}
+
+AnalysisTap::~AnalysisTap()
+{
+	service.removeTap(this);
+}
+
+void AnalysisTap::pushSamples(const float* left, const float* right, int numSamples) noexcept
+{
+	if (!isActive())
+		return;
+
+	int start1, size1, start2, size2;
+
+	// If the analysis thread falls behind, the samples that don't fit are dropped
+	fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+	if (right != nullptr)
+	{
+		FloatVectorOperations::copyWithMultiply(ringBuffer + start1, left, 0.5f, size1);
+		FloatVectorOperations::addWithMultiply(ringBuffer + start1, right, 0.5f, size1);
+
+		if (size2 > 0)
+		{
+			FloatVectorOperations::copyWithMultiply(ringBuffer + start2, left + size1, 0.5f, size2);
+			FloatVectorOperations::addWithMultiply(ringBuffer + start2, right + size1, 0.5f, size2);
+		}
+	}
+	else
+	{
+		FloatVectorOperations::copy(ringBuffer + start1, left, size1);
+
+		if (size2 > 0)
+			FloatVectorOperations::copy(ringBuffer + start2, left + size1, size2);
+	}
+
+	fifo.finishedWrite(size1 + size2);
+}
+
+void AnalysisTap::addListener(Listener* l)
+{
+	listeners.addIfNotAlreadyThere(l);
+
+	if (!isActive())
+		setActive(true);
+}
+
+void AnalysisTap::removeListener(Listener* l)
+{
+	listeners.removeAllInstancesOf(l);
+
+	if (listeners.isEmpty() && isActive())
+		setActive(false);
+}
+
+void AnalysisTap::setActive(bool shouldBeActive)
+{
+	// The ring buffer can only be cleared by the reading thread, so this is done by the service.
+	// The reset flag is set first so that the service never analyses the old data after the activation.
+	resetPending.set(1);
+	active.set(shouldBeActive ? 1 : 0);
+
+	service.tapStateChanged();
+}
+
+void AnalysisTap::getSpectrum(float* destination) const
+{
+	SpinLock::ScopedLockType sl(resultLock);
+
+	FloatVectorOperations::copy(destination, spectrum, getSpectrumSize());
+}
+
+void AnalysisTap::getEnvelope(float* destination) const
+{
+	SpinLock::ScopedLockType sl(resultLock);
+
+	const int numAfterIndex = envelopeSize - publishedEnvelopeIndex;
+
+	FloatVectorOperations::copy(destination, envelope + publishedEnvelopeIndex, numAfterIndex);
+	FloatVectorOperations::copy(destination + numAfterIndex, envelope, publishedEnvelopeIndex);
+}
+
+void AnalysisTap::handleAsyncUpdate()
+{
+	for (int i = 0; i < listeners.size(); i++)
+	{
+		if (listeners[i].get() != nullptr)
+			listeners[i]->analysisResultsChanged(this);
+		else
+			listeners.remove(i--);
+	}
+
+	// Stop collecting data if all listeners were deleted without unsubscribing
+	if (listeners.isEmpty() && isActive())
+		setActive(false);
+}
+
+void AnalysisTap::reset()
+{
+	const int numReady = fifo.getNumReady();
+
+	if (numReady > 0)
+	{
+		int start1, size1, start2, size2;
+		fifo.prepareToRead(numReady, start1, size1, start2, size2);
+		fifo.finishedRead(size1 + size2);
+	}
+
+	FloatVectorOperations::clear(history, fftSize);
+	FloatVectorOperations::clear(envelopeHistory, envelopeSize);
+	historyIndex = 0;
+	envelopeValue = 0.0f;
+	envelopeCounter = 0;
+	envelopeIndex = 0;
+
+	SpinLock::ScopedLockType sl(resultLock);
+
+	FloatVectorOperations::clear(spectrum, getSpectrumSize());
+	FloatVectorOperations::clear(envelope, envelopeSize);
+	publishedEnvelopeIndex = 0;
+	rms = 0.0f;
+	peak = 0.0f;
+}
+
+bool AnalysisTap::analyse()
+{
+	const int numReady = fifo.getNumReady();
+
+	if (numReady == 0)
+		return false;
+
+	int start1, size1, start2, size2;
+
+	fifo.prepareToRead(numReady, start1, size1, start2, size2);
+
+	squareSum = 0.0;
+	blockPeak = 0.0f;
+
+	processSamples(ringBuffer + start1, size1);
+	processSamples(ringBuffer + start2, size2);
+
+	fifo.finishedRead(size1 + size2);
+
+	// Unroll the history (oldest sample first) and apply the window
+	const int numAfterIndex = fftSize - historyIndex;
+
+	FloatVectorOperations::multiply(fftData, history + historyIndex, window, numAfterIndex);
+	FloatVectorOperations::multiply(fftData + numAfterIndex, history, window + numAfterIndex, historyIndex);
+	FloatVectorOperations::clear(fftData + fftSize, fftSize);
+
+	fft.performFrequencyOnlyForwardTransform(fftData);
+
+	FloatVectorOperations::multiply(fftData, 1.0f / (float)fftSize, getSpectrumSize());
+
+	{
+		SpinLock::ScopedLockType sl(resultLock);
+
+		for (int i = 0; i < getSpectrumSize(); i++)
+			spectrum[i] = jmax<float>(fftData[i], spectrumDecay * spectrum[i]);
+
+		FloatVectorOperations::copy(envelope, envelopeHistory, envelopeSize);
+		publishedEnvelopeIndex = envelopeIndex;
+		rms = (float)std::sqrt(squareSum / (double)(size1 + size2));
+		peak = blockPeak;
+	}
+
+	return true;
+}
+
+void AnalysisTap::processSamples(const float* data, int numSamples)
+{
+	for (int i = 0; i < numSamples; i++)
+	{
+		const float value = data[i];
+		const float absValue = std::abs(value);
+
+		squareSum += (double)(value * value);
+		blockPeak = jmax<float>(blockPeak, absValue);
+
+		history[historyIndex] = value;
+		historyIndex = (historyIndex + 1) % fftSize;
+
+		envelopeValue = jmax<float>(envelopeValue, absValue);
+
+		if (++envelopeCounter >= envelopeDecimation)
+		{
+			envelopeHistory[envelopeIndex] = envelopeValue;
+			envelopeIndex = (envelopeIndex + 1) % envelopeSize;
+			envelopeValue = 0.0f;
+			envelopeCounter = 0;
+		}
+	}
+}
+
+AnalysisService::AnalysisService() :
+	Thread("Analysis Service")
+{
+
+}
+
+AnalysisService::~AnalysisService()
+{
+	stopThread(1000);
+}
+
+void AnalysisService::run()
+{
+	while (!threadShouldExit())
+	{
+		bool anyTapActive = false;
+
+		{
+			ScopedLock sl(tapLock);
+
+			for (int i = 0; i < taps.size(); i++)
+			{
+				AnalysisTap* tap = taps.getUnchecked(i);
+
+				if (tap->resetPending.compareAndSetBool(0, 1))
+					tap->reset();
+
+				if (tap->isActive())
+				{
+					anyTapActive = true;
+
+					if (tap->analyse())
+						tap->triggerAsyncUpdate();
+				}
+			}
+		}
+
+		// Sleep until the next tap is activated if nobody is interested in the results
+		wait(anyTapActive ? 30 : -1);
+	}
+}
+
+void AnalysisService::addTap(AnalysisTap* tap)
+{
+	ScopedLock sl(tapLock);
+
+	taps.addIfNotAlreadyThere(tap);
+}
+
+void AnalysisService::removeTap(AnalysisTap* tap)
+{
+	ScopedLock sl(tapLock);
+
+	taps.removeAllInstancesOf(tap);
+}
+
+void AnalysisService::tapStateChanged()
+{
+	if (!isThreadRunning())
+		startThread(3);
+	else
+		notify();
+}
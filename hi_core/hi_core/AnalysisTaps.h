@@ -0,0 +1,200 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for cloused source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef ANALYSISTAPS_H_INCLUDED
+#define ANALYSISTAPS_H_INCLUDED
+
+class AnalysisService;
+
+/** A wait-free tap that lets a processor publish audio for analysis.
+*	@ingroup core
+*
+*	The audio thread pushes its blocks into a single producer / single consumer ring buffer (which is just a copy)
+*	and the AnalysisService computes a windowed FFT, RMS / peak values and a decimated peak envelope on its
+*	background thread. The results are published to the listeners on the message thread, so neither the audio
+*	thread nor the UI thread has to do any analysis work.
+*
+*	As long as there are no listeners, pushing samples returns immediately.
+*/
+class AnalysisTap : public AsyncUpdater
+{
+public:
+
+	class Listener
+	{
+	public:
+
+		virtual ~Listener()
+		{
+			masterReference.clear();
+		}
+
+		/** Called on the message thread whenever new results are available. */
+		virtual void analysisResultsChanged(AnalysisTap* tap) = 0;
+
+	private:
+
+		friend class WeakReference<Listener>;
+		WeakReference<Listener>::Master masterReference;
+	};
+
+	/** Creates a tap with a FFT size of 2^fftOrder. */
+	AnalysisTap(AnalysisService& service, int fftOrder=12);
+
+	~AnalysisTap();
+
+	/** Call this from the audio thread. If right is not nullptr, both channels are summed to mono. */
+	void pushSamples(const float* left, const float* right, int numSamples) noexcept;
+
+	/** Checks if anybody is interested in the results. */
+	bool isActive() const noexcept { return active.get() != 0; }
+
+	void addListener(Listener* l);
+	void removeListener(Listener* l);
+
+	/** Sets the factor that is applied to the previous spectrum if the new magnitude is smaller (peak hold with decay). */
+	void setSpectrumDecay(float newDecay) noexcept { spectrumDecay = newDecay; }
+
+	/** Sets the amount of samples that are collapsed into one point of the peak envelope. */
+	void setEnvelopeDecimation(int newDecimation) noexcept { envelopeDecimation = jmax<int>(1, newDecimation); }
+
+	int getFFTSize() const noexcept { return fftSize; }
+
+	/** Returns the number of bins in the magnitude spectrum (half the FFT size). */
+	int getSpectrumSize() const noexcept { return fftSize / 2; }
+
+	/** Copies the latest magnitude spectrum (getSpectrumSize() values). */
+	void getSpectrum(float* destination) const;
+
+	/** Returns the number of points in the peak envelope. */
+	int getEnvelopeSize() const noexcept { return envelopeSize; }
+
+	/** Copies the latest peak envelope with the oldest value first (getEnvelopeSize() values). */
+	void getEnvelope(float* destination) const;
+
+	/** The RMS value of the samples that were analysed last. */
+	float getRMS() const noexcept { return rms; }
+
+	/** The peak value of the samples that were analysed last. */
+	float getPeak() const noexcept { return peak; }
+
+	void handleAsyncUpdate() override;
+
+private:
+
+	friend class AnalysisService;
+
+	/** Reads the new samples from the ring buffer and updates the results. Called by the AnalysisService. */
+	bool analyse();
+
+	/** Discards the samples in the ring buffer and clears the results. Called by the AnalysisService if a reset is pending. */
+	void reset();
+
+	/** Sets the tap to active or inactive and lets the AnalysisService clear the old data. */
+	void setActive(bool shouldBeActive);
+
+	void processSamples(const float* data, int numSamples);
+
+	AnalysisService& service;
+
+	const int fftSize;
+	const int envelopeSize = 256;
+
+	Atomic<int> active;
+	Atomic<int> resetPending;
+
+	float spectrumDecay = 0.9f;
+	int envelopeDecimation = 256;
+
+	// Written by the audio thread, read by the analysis thread
+	AbstractFifo fifo;
+	HeapBlock<float> ringBuffer;
+
+	// Only used by the analysis thread
+	FFT fft;
+	HeapBlock<float> window;
+	HeapBlock<float> history;
+	HeapBlock<float> fftData;
+	HeapBlock<float> envelopeHistory;
+	int historyIndex = 0;
+	float envelopeValue = 0.0f;
+	int envelopeCounter = 0;
+	int envelopeIndex = 0;
+	double squareSum = 0.0;
+	float blockPeak = 0.0f;
+
+	// Written by the analysis thread, read by the UI
+	SpinLock resultLock;
+	HeapBlock<float> spectrum;
+	HeapBlock<float> envelope;
+	int publishedEnvelopeIndex = 0;
+	float rms = 0.0f;
+	float peak = 0.0f;
+
+	Array<WeakReference<Listener>> listeners;
+
+	JUCE_DECLARE_NON_COPYABLE(AnalysisTap);
+};
+
+/** A background thread that analyses the data of all active AnalysisTaps.
+*	@ingroup core
+*
+*	There is one instance per MainController. The thread is started when the first tap gets a listener
+*	and sleeps until a tap is activated again as long as there is no active tap.
+*/
+class AnalysisService : public Thread
+{
+public:
+
+	AnalysisService();
+
+	~AnalysisService();
+
+	void run() override;
+
+private:
+
+	friend class AnalysisTap;
+
+	void addTap(AnalysisTap* tap);
+	void removeTap(AnalysisTap* tap);
+
+	/** Starts the thread if it is not running yet or wakes it up so that it can reset the tap. */
+	void tapStateChanged();
+
+	CriticalSection tapLock;
+	Array<AnalysisTap*> taps;
+
+	JUCE_DECLARE_NON_COPYABLE(AnalysisService);
+};
+
+#endif  // ANALYSISTAPS_H_INCLUDED
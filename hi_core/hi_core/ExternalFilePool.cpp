@@ -107,12 +107,33 @@ void ImagePool::restoreItemFromValueTree(ValueTree& child)
 	jassert(ne.fileName.isNotEmpty());
 
 	ne.id = id;
+
+#if HISE_SHARE_POOL_DATA_BETWEEN_INSTANCES
+
+	// The ImageCache is process wide, so other instances can reuse the decoded image.
+	// The hash includes the data so that images with the same name from another plugin won't be mixed up.
+	const int64 hashCode = (ne.fileName + MD5(*mb).toHexString()).hashCode64();
+
+	ne.data = ImageCache::getFromHashCode(hashCode);
+
+	if (!ne.data.isValid())
+	{
+		ne.data = ImageFileFormat::loadFrom(mis->getData(), mis->getDataSize());
+		ImageCache::addImageToCache(ne.data, hashCode);
+	}
+
+	mis = nullptr;
+
+#else
+
 	ne.data = ImageFileFormat::loadFrom(mis->getData(), mis->getDataSize());
 
 	mis = nullptr;
 
 	ImageCache::addImageToCache(ne.data, ne.fileName.hashCode64());
 
+#endif
+
 	notifyTable();
 
 	loadedImages.add(ne);
@@ -350,6 +371,10 @@ StringArray AudioSampleBufferPool::getTextDataForId(int index) const
 void AudioSampleBufferPool::clearData()
 {
 	loadedSamples.clear();
+
+#if HISE_SHARE_POOL_DATA_BETWEEN_INSTANCES
+	sharedCache->releaseEntries(sharedEntries);
+#endif
 }
 
 void AudioSampleBufferPool::storeItemInValueTree(ValueTree& child, int i) const
@@ -392,7 +417,7 @@ void AudioSampleBufferPool::restoreItemFromValueTree(ValueTree& child)
 
 	ne.id = id;
 
-	loadFromStream(ne, mis);
+	loadFromStream(ne, mis, ne.fileName + MD5(*mb).toHexString());
 
 	loadedSamples.add(ne);
 }
@@ -415,7 +440,7 @@ AudioSampleBuffer AudioSampleBufferPool::loadFileIntoPool(const String& fileName
 	File f = getFileFromFileNameString(fileName);
 
 	if(f.existsAsFile())
-		loadFromStream(be, new FileInputStream(f));
+		loadFromStream(be, new FileInputStream(f), f.getFullPathName() + String(f.getLastModificationTime().toMilliseconds()));
 
 	loadedSamples.add(be);
 
@@ -438,8 +463,33 @@ double AudioSampleBufferPool::getSampleRateForFile(const Identifier& id)
 	return 0.0;
 }
 
-void AudioSampleBufferPool::loadFromStream(BufferEntry& ne, InputStream* ownedStream)
+void AudioSampleBufferPool::loadFromStream(BufferEntry& ne, InputStream* ownedStream, const String& cacheKey)
 {
+#if HISE_SHARE_POOL_DATA_BETWEEN_INSTANCES
+
+	if (auto existing = sharedCache->getEntry(cacheKey))
+	{
+		delete ownedStream;
+		useSharedEntry(ne, existing);
+		return;
+	}
+
+	ScopedPointer<AudioFormatReader> reader = afm.createReaderFor(ownedStream);
+
+	if (reader != nullptr)
+	{
+		SharedAudioFileCache::Entry::Ptr newEntry = new SharedAudioFileCache::Entry(cacheKey);
+
+		newEntry->buffer.setSize(reader->numChannels, (int)reader->lengthInSamples, false, false, false);
+		reader->read(&(newEntry->buffer), 0, (int)reader->lengthInSamples, 0, true, true);
+		newEntry->sampleRate = reader->sampleRate;
+
+		// another instance might have loaded the same file in the meantime...
+		useSharedEntry(ne, sharedCache->addEntry(newEntry));
+	}
+
+#else
+
 	ScopedPointer<AudioFormatReader> reader = afm.createReaderFor(ownedStream);
 
 	if (reader != nullptr)
@@ -451,4 +501,60 @@ void AudioSampleBufferPool::loadFromStream(BufferEntry& ne, InputStream* ownedSt
 		ne.additionalData = reader->sampleRate;
 
 	}
+
+#endif
+}
+
+void AudioSampleBufferPool::useSharedEntry(BufferEntry& ne, SharedAudioFileCache::Entry* e)
+{
+#if HISE_SHARE_POOL_DATA_BETWEEN_INSTANCES
+	ne.data.setDataToReferTo(e->buffer.getArrayOfWritePointers(), e->buffer.getNumChannels(), e->buffer.getNumSamples());
+	ne.additionalData = e->sampleRate;
+
+	sharedEntries.addIfNotAlreadyThere(e);
+#else
+	ignoreUnused(ne, e);
+#endif
+}
+
+SharedAudioFileCache::Entry::Ptr SharedAudioFileCache::getEntry(const String& key) const
+{
+	ScopedLock sl(lock);
+
+	for (auto e : entries)
+	{
+		if (e->key == key)
+			return e;
+	}
+
+	return Entry::Ptr();
+}
+
+SharedAudioFileCache::Entry::Ptr SharedAudioFileCache::addEntry(Entry::Ptr newEntry)
+{
+	ScopedLock sl(lock);
+
+	for (auto e : entries)
+	{
+		if (e->key == newEntry->key)
+			return e;
+	}
+
+	entries.add(newEntry);
+
+	return newEntry;
+}
+
+void SharedAudioFileCache::releaseEntries(ReferenceCountedArray<Entry>& usedEntries)
+{
+	ScopedLock sl(lock);
+
+	for (auto e : usedEntries)
+	{
+		// Only this array and the cache hold a reference...
+		if (e->getReferenceCount() == 2)
+			entries.removeObject(e);
+	}
+
+	usedEntries.clear();
 }
@@ -140,6 +140,43 @@ protected:
 };
 
 
+/** A process wide cache for the audio files that are loaded by the AudioSampleBufferPool.
+*
+*	If HISE_SHARE_POOL_DATA_BETWEEN_INSTANCES is enabled, the pools of every plugin instance (they access this object via a SharedResourcePointer)
+*	refer to the same audio data instead of decoding their own copy. The entries are removed as soon as no pool uses them anymore.
+*/
+class SharedAudioFileCache
+{
+public:
+
+	struct Entry : public ReferenceCountedObject
+	{
+		typedef ReferenceCountedObjectPtr<Entry> Ptr;
+
+		Entry(const String& key_) :
+			key(key_)
+		{};
+
+		const String key;
+		AudioSampleBuffer buffer;
+		double sampleRate = 0.0;
+	};
+
+	/** Returns the entry with the given key or nullptr if it's not loaded yet. */
+	Entry::Ptr getEntry(const String& key) const;
+
+	/** Adds the entry to the cache. If there is already an entry with the same key, it will return this one instead. */
+	Entry::Ptr addEntry(Entry::Ptr newEntry);
+
+	/** Clears the given array and removes all entries that are not used by another pool. */
+	void releaseEntries(ReferenceCountedArray<Entry>& usedEntries);
+
+private:
+
+	CriticalSection lock;
+	ReferenceCountedArray<Entry> entries;
+};
+
 /** A pool for audio samples
 *
 *	This is used to embed impulse responses into the binary file and load it from there instead of having the impulse file as seperate audio file.
@@ -181,12 +218,19 @@ private:
 
 	ScopedPointer<AudioThumbnailCache> cache;
 
-	void loadFromStream(BufferEntry& ne, InputStream* ownedStream);
+	void loadFromStream(BufferEntry& ne, InputStream* ownedStream, const String& cacheKey);
+
+	void useSharedEntry(BufferEntry& ne, SharedAudioFileCache::Entry* e);
 
 	AudioFormatManager afm;
 
 	Array<BufferEntry> loadedSamples;
 
+#if HISE_SHARE_POOL_DATA_BETWEEN_INSTANCES
+	SharedResourcePointer<SharedAudioFileCache> sharedCache;
+	ReferenceCountedArray<SharedAudioFileCache::Entry> sharedEntries;
+#endif
+
 };
 
 
@@ -169,9 +169,10 @@ void HiseEventBuffer::addEvent(const HiseEvent& hiseEvent)
 		return;
 	}
 
-	if (numUsed == 0)
+	if (numUsed == 0 || buffer[numUsed - 1].getTimeStamp() <= hiseEvent.getTimeStamp())
 	{
-		insertEventAtPosition(hiseEvent, 0);
+		// Most events arrive in order, so skip the search and append them
+		insertEventAtPosition(hiseEvent, numUsed);
 		return;
 	}
 
@@ -241,6 +242,22 @@ void HiseEventBuffer::addEvents(const MidiBuffer& otherBuffer)
 
 void HiseEventBuffer::addEvents(const HiseEventBuffer &otherBuffer)
 {
+	if (otherBuffer.numUsed == 0)
+		return;
+
+	if (numUsed == 0 || buffer[numUsed - 1].getTimeStamp() <= otherBuffer.buffer[0].getTimeStamp())
+	{
+		// The other events are all later than this buffer, so they can be appended in one go
+		const int numToCopy = jmin<int>(otherBuffer.numUsed, HISE_EVENT_BUFFER_SIZE - numUsed);
+
+		jassert(numToCopy == otherBuffer.numUsed);
+
+		CopyHelpers::copyEvents(*this, numUsed, otherBuffer, 0, numToCopy);
+		numUsed += numToCopy;
+
+		return;
+	}
+
 	Iterator iter(otherBuffer);
 
 	while (HiseEvent* e = iter.getNextEventPointer(false, false))
@@ -292,8 +309,10 @@ void HiseEventBuffer::moveEventsBelow(HiseEventBuffer& targetBuffer, int highest
 
 	const int numRemaining = numUsed - numCopied;
 
-	for (int i = 0; i < numRemaining; i++)
-		buffer[i] = buffer[i + numCopied];
+	if (numCopied == 0)
+		return;
+
+	memmove(buffer, buffer + numCopied, sizeof(HiseEvent) * numRemaining);
 
 	HiseEvent::clear(buffer + numRemaining, numCopied);
 
@@ -412,12 +431,10 @@ void HiseEventBuffer::insertEventAtPosition(const HiseEvent& e, int positionInBu
 
 	if (numUsed > positionInBuffer)
 	{
-		for (int i = jmin<int>(numUsed-1, HISE_EVENT_BUFFER_SIZE-2); i >= positionInBuffer; i--)
-		{
-			jassert(i + 1 < HISE_EVENT_BUFFER_SIZE);
+		const int numToShift = jmin<int>(numUsed, HISE_EVENT_BUFFER_SIZE - 1) - positionInBuffer;
 
-			buffer[i + 1] = buffer[i];
-		}
+		if (numToShift > 0)
+			memmove(buffer + positionInBuffer + 1, buffer + positionInBuffer, sizeof(HiseEvent) * numToShift);
 	}
 
     if(positionInBuffer < HISE_EVENT_BUFFER_SIZE)
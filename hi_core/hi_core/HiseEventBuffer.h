@@ -324,7 +324,10 @@ private:
 	
 };
 
+/** The maximum number of events per HiseEventBuffer. The storage is allocated inline, so raise this for dense automation instead of growing it on the audio thread. */
+#ifndef HISE_EVENT_BUFFER_SIZE
 #define HISE_EVENT_BUFFER_SIZE 256
+#endif
 
 class HiseEventBuffer
 {
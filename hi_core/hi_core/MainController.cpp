@@ -34,6 +34,7 @@ MainController::MainController():
 	sampleManager(new SampleManager(this)),
 	allNotesOffFlag(false),
 	bufferSize(-1),
+	currentBlockSize(0),
 	sampleRate(-1.0),
 	temp_usage(0.0f),
 	uptime(0.0),
@@ -58,6 +59,8 @@ MainController::MainController():
 	eventIdHandler(masterEventBuffer),
 	userPresetHandler(this),
 	codeHandler(this),
+	processorRegistry(this),
+	graphEditQueue(this),
 	processorChangeHandler(this),
 	debugLogger(this),
 	presetLoadRampFlag(0),
@@ -224,18 +227,29 @@ void MainController::loadPreset(ValueTree &v, Component* /*mainEditor*/)
 
 void MainController::startCpuBenchmark(int bufferSize_)
 {
-	bufferSize.set(bufferSize_);
+	// Don't touch bufferSize here, it stores the block size the engine is prepared for
+	currentBlockSize.set(bufferSize_);
 	temp_usage = (Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks()));
 }
 
 void MainController::compileAllScripts()
 {
-	Processor::Iterator<JavascriptProcessor> it(getMainSynthChain());
+	Array<JavascriptProcessor*> scriptList = getProcessorRegistry().getProcessorsOfType<JavascriptProcessor>();
 
-	JavascriptProcessor *sp;
-		
-	while((sp = it.getNextProcessor()) != nullptr)
+	// A script's onInit might delete other script processors, so hold weak references to skip them
+	Array<WeakReference<Processor>> scriptProcessors;
+	scriptProcessors.ensureStorageAllocated(scriptList.size());
+
+	for (int i = 0; i < scriptList.size(); i++)
+		scriptProcessors.add(dynamic_cast<Processor*>(scriptList.getUnchecked(i)));
+
+	for (int i = 0; i < scriptProcessors.size(); i++)
 	{
+		JavascriptProcessor* sp = dynamic_cast<JavascriptProcessor*>(scriptProcessors[i].get());
+
+		if (sp == nullptr)
+			continue;
+
 		if (sp->isConnectedToExternalFile())
 		{
 			sp->reloadFromFile();
@@ -254,7 +268,7 @@ void MainController::allNotesOff()
 
 void MainController::stopCpuBenchmark()
 {
-	const float thisUsage = 100.0f * (float)((Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks()) - temp_usage) * sampleRate / bufferSize.get());
+	const float thisUsage = 100.0f * (float)((Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks()) - temp_usage) * sampleRate / jmax<int>(1, currentBlockSize.get()));
 	
 	const float lastUsage = usagePercent.load();
 	
@@ -450,19 +464,26 @@ void MainController::processBlockCommon(AudioSampleBuffer &buffer, MidiBuffer &m
 
 	if (!sl.isLocked())
 	{
+		graphEditQueue.setMainLockBusy();
 		buffer.clear();
 		midiMessages.clear();
 		return;
 	}
 
+	graphEditQueue.applyPendingEdit();
+
 	ModulatorSynthChain *synthChain = getMainSynthChain();
 
-	if (buffer.getNumSamples() != bufferSize.get())
+	const int numSamples = buffer.getNumSamples();
+
+	// Smaller blocks are rendered directly, so this only reallocates if the host exceeds the block size from prepareToPlay()
+	if (numSamples > bufferSize.get())
 	{
-		//debugError(synthChain, "Block size mismatch (old: " + String(bufferSize.get()) + ", new: " + String(buffer.getNumSamples()));
-		prepareToPlay(sampleRate, buffer.getNumSamples());
+		prepareToPlay(sampleRate, numSamples);
 	}
 
+	currentBlockSize.set(numSamples);
+
 #if !FRONTEND_IS_PLUGIN
     
 	keyboardState.processNextMidiBuffer(midiMessages, 0, buffer.getNumSamples(), true);
@@ -531,9 +552,12 @@ void MainController::processBlockCommon(AudioSampleBuffer &buffer, MidiBuffer &m
 	synthChain->renderNextBlockWithModulators(buffer, masterEventBuffer);
 
 #else
-	multiChannelBuffer.clear();
+	// Refers to the first samples of the multichannel buffer without allocating
+	AudioSampleBuffer thisBlock(multiChannelBuffer.getArrayOfWritePointers(), multiChannelBuffer.getNumChannels(), numSamples);
+
+	thisBlock.clear();
 
-	synthChain->renderNextBlockWithModulators(multiChannelBuffer, masterEventBuffer);
+	synthChain->renderNextBlockWithModulators(thisBlock, masterEventBuffer);
 
 	const bool isUsingMultiChannel = buffer.getNumChannels() != 2;
 
@@ -616,6 +640,7 @@ void MainController::processBlockCommon(AudioSampleBuffer &buffer, MidiBuffer &m
 void MainController::prepareToPlay(double sampleRate_, int samplesPerBlock)
 {
 	bufferSize = samplesPerBlock;
+	currentBlockSize = samplesPerBlock;
 	sampleRate = sampleRate_;
     
     thisAsProcessor = dynamic_cast<AudioProcessor*>(this);
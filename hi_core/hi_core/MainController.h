@@ -491,38 +491,269 @@ public:
 		Array<WeakReference<Listener>> listeners;
 	};
 
-	class CodeHandler: public AsyncUpdater
+	/** An index of the module tree for fast lookups by ID and by processor type.
+	*
+	*	Processor::Iterator flattens the whole tree every time it is created, so looking up a module by its ID is
+	*	a linear scan with a dynamic_cast for every processor. This class keeps a flat index of the main synth chain
+	*	which is rebuilt lazily on the next lookup after the tree has changed.
+	*
+	*	Processors mark the registry as dirty when they are created, deleted or renamed and the chain handlers do
+	*	the same when they add, remove or move a child processor.
+	*/
+	class ProcessorRegistry
 	{
 	public:
 
-		enum WarningLevel
+		ProcessorRegistry(MainController* mc_);
+
+		/** Call this whenever a processor is created, deleted, renamed or moved within the tree. */
+		void markDirty() noexcept { ++generation; }
+
+		/** Returns a counter that changes whenever the module tree was changed.
+		*
+		*	You can store it along with a pointer to a processor to check cheaply whether a cached handle might be stale.
+		*/
+		uint32 getGeneration() const noexcept { return generation.get(); }
+
+		/** Returns the first processor of the given type with the given ID (in the order of a Processor::Iterator).
+		*
+		*	If root is not nullptr, only the processors below root (including root) are searched.
+		*/
+		template <class SubTypeProcessor> SubTypeProcessor* getFirstProcessorWithId(const String& id, const Processor* root=nullptr)
 		{
-			Message = 0,
-			Error = 1
+			Array<Processor*> candidates = getProcessorsWithId(id, root);
+
+			for (int i = 0; i < candidates.size(); i++)
+			{
+				if (SubTypeProcessor* p = dynamic_cast<SubTypeProcessor*>(candidates.getUnchecked(i)))
+					return p;
+			}
+
+			return nullptr;
+		}
+
+		/** Returns all processors of the given type (in the order of a Processor::Iterator).
+		*
+		*	The list of every type is cached until the tree changes, so repeated calls don't need any dynamic casts.
+		*/
+		template <class SubTypeProcessor> Array<SubTypeProcessor*> getProcessorsOfType(const Processor* root=nullptr)
+		{
+			Array<Processor*> processors = getProcessorsOfType(typeid(SubTypeProcessor), isType<SubTypeProcessor>, root);
+
+			Array<SubTypeProcessor*> list;
+			list.ensureStorageAllocated(processors.size());
+
+			for (int i = 0; i < processors.size(); i++)
+				list.add(dynamic_cast<SubTypeProcessor*>(processors.getUnchecked(i)));
+
+			return list;
+		}
+
+		/** Returns all processors with the given ID (normally just one). */
+		Array<Processor*> getProcessorsWithId(const String& id, const Processor* root=nullptr);
+
+	private:
+
+		using TypeCheckFunction = bool(*)(Processor*);
+
+		template <class SubTypeProcessor> static bool isType(Processor* p)
+		{
+			return dynamic_cast<SubTypeProcessor*>(p) != nullptr;
+		}
+
+		Array<Processor*> getProcessorsOfType(const std::type_info& type, TypeCheckFunction typeCheck, const Processor* root);
+
+		void rebuildIfNecessary();
+
+		void addToIndex(Processor* p);
+
+		/** Returns the range of entry indexes of the subtree or false if root is not part of the main synth chain. */
+		bool getSubtreeRange(const Processor* root, Range<int>& range);
+
+		struct Entry
+		{
+			WeakReference<Processor> processor;
+			int subtreeEnd;
+			int nextWithSameId;
 		};
 
-		CodeHandler(MainController* mc);
+		struct TypeIndex
+		{
+			const std::type_info* type;
+			Array<int> indexes;
+		};
 
-		void writeToConsole(const String &t, int warningLevel, const Processor *p, Colour c);
+		MainController* mc;
 
-		void handleAsyncUpdate();
+		CriticalSection lock;
 
+		Atomic<uint32> generation;
+		uint32 indexedGeneration;
 
+		Array<Entry> entries;
+		HashMap<const Processor*, int> processorIndexes;
+		HashMap<String, int> firstIndexWithId;
+		OwnedArray<TypeIndex> typeIndexes;
+	};
 
-		enum class ConsoleMessageItems
+	/** Hands structural edits of the processor tree to the audio thread instead of locking it out.
+	*
+	*	Adding, removing or moving a child processor used to happen with the main lock held (or processing suspended), so
+	*	the audio callback failed its try-lock and rendered silence. Now the edit is prepared completely on the calling
+	*	thread (create, prepareToPlay, build the new child arrays) and only the pointer swap is passed to the audio thread
+	*	through a single pending slot. The audio thread applies it at the start of the next block and the calling thread
+	*	blocks until this happened, so the tree looks the same to the caller as before.
+	*
+	*	If the audio callback is not running (suspended or no block for 100ms) or it reported that it couldn't get the
+	*	main lock, the calling thread tries to get the main lock itself and applies the edit. This way a caller that already
+	*	holds the main lock (eg. a script compiling its onInit callback) only waits for one block and subsequent edits are
+	*	applied directly. The main lock is only ever tried while the edit lock is held, never waited for.
+	*
+	*	Arrays that are read by the audio thread must never be resized in the edit function. Use an ArrayCopy to change
+	*	them on the calling thread and swap the storage in the edit function. Removed processors stay in the copy and 
+	*	must be deleted by the caller after performEdit() returns, so their destructor never runs on the audio thread.
+	*/
+	class GraphEditQueue
+	{
+	public:
+
+		typedef std::function<void(void)> EditFunction;
+
+		GraphEditQueue(MainController* mc_);
+
+		/** Applies the edit at the start of the next audio block and waits until it was applied.
+		*
+		*	The function must not allocate, lock or delete anything. If you call this on the audio thread, the edit is applied directly.
+		*/
+		void performEdit(const EditFunction& f);
+
+		/** Called by the audio thread (with the main lock held) before it renders the next block. */
+		void applyPendingEdit();
+
+		/** Called by the audio thread if it couldn't get the main lock for the current block. */
+		void setMainLockBusy() noexcept { mainLockBusy.set(1); }
+
+		/** Hold this while you build the arrays for an edit, so that no other edit changes the original arrays in between.
+		*
+		*	If another thread holds the edit lock, this applies its pending edit when the main lock can be taken, so a thread 
+		*	that holds the main lock never waits for a thread that waits for the main lock.
+		*/
+		class ScopedEditLock
 		{
-			WarningLevel = 0,
-			Processor,
-			Message
+		public:
+
+			ScopedEditLock(GraphEditQueue& queue_);
+			~ScopedEditLock();
+
+		private:
+
+			GraphEditQueue& queue;
+
+			JUCE_DECLARE_NON_COPYABLE(ScopedEditLock);
 		};
 
-		using ConsoleMessage = std::tuple < WarningLevel, const WeakReference<Processor>, String >;
+		/** A copy of an array that is read by the audio thread.
+		*
+		*	Create it (with the edit lock held), change the copy on the calling thread and call swapWithOriginal() in the edit
+		*	function. This only swaps the storage pointers, so the audio thread never allocates or frees memory. The old storage
+		*	is freed when the copy is destroyed. The objects of an OwnedArray are never deleted by this class.
+		*/
+		template <class ArrayType> class ArrayCopy
+		{
+		public:
 
-		const CriticalSection &getLock() const { return lock; }
+			ArrayCopy(ArrayType& original_) :
+				original(original_)
+			{
+				copy.addArray(original);
+			}
 
-		std::vector<ConsoleMessage> unprintedMessages;
+			~ArrayCopy()
+			{
+				releaseWithoutDeleting(copy);
+			}
 
-		CriticalSection lock;
+			ArrayType* operator->() noexcept { return &copy; }
+
+			void swapWithOriginal() noexcept { original.swapWith(copy); }
+
+		private:
+
+			template <class ObjectType> static void releaseWithoutDeleting(OwnedArray<ObjectType>& a) { a.clear(false); }
+			template <class ElementType> static void releaseWithoutDeleting(Array<ElementType>&) {}
+
+			ArrayType& original;
+			ArrayType copy;
+
+			JUCE_DECLARE_NON_COPYABLE(ArrayCopy);
+		};
+
+	private:
+
+		void applyEdit();
+
+		struct Edit
+		{
+			Edit(const EditFunction& f_) :
+				f(f_)
+			{
+				applied.set(0);
+			}
+
+			const EditFunction& f;
+			Atomic<int> applied;
+		};
+
+		bool isAudioCallbackRunning() const;
+
+		/** Applies the pending edit if the main lock can be taken without blocking the audio thread. */
+		bool tryToApplyPendingEdit();
+
+		MainController* mc;
+
+		CriticalSection editLock;
+
+		Atomic<Edit*> pendingEdit;
+		Atomic<uint32> lastBlockTime;
+		Atomic<Thread::ThreadID> audioThreadId;
+		Atomic<int> mainLockBusy;
+	};
+
+	class CodeHandler: public AsyncUpdater,
+					   public Timer
+	{
+	public:
+
+		enum WarningLevel
+		{
+			Message = 0,
+			Error = 1
+		};
+
+		enum
+		{
+			NumMessageSlots = 128,
+			MaxMessageLength = 512,
+			MaxProcessorIdLength = 64
+		};
+
+		CodeHandler(MainController* mc);
+
+		/** Adds a message to the console.
+		*
+		*	This can be called from any thread (including the audio thread): it copies the text into a preallocated
+		*	slot without locking or allocating and the message thread picks it up later. If all slots are in use, 
+		*	the message is dropped and counted (see getNumDroppedMessages()). Messages longer than MaxMessageLength
+		*	bytes are truncated.
+		*/
+		void writeToConsole(const String &t, int warningLevel, const Processor *p, Colour c);
+
+		void handleAsyncUpdate();
+
+		void timerCallback() override;
+
+		/** Returns the number of messages that were dropped because the queue was full. */
+		int getNumDroppedMessages() const { return totalDroppedMessages.get(); }
 
 		void clearConsole()
 		{
@@ -540,7 +771,34 @@ public:
 
 	private:
 
-		bool overflowProtection = false;
+		friend class ConsoleQueueTest;
+
+		/** A preallocated message slot. 
+		*
+		*	The sequence number tells the state of the slot for the position p that maps to it: if it is p, a writer can
+		*	claim it; if it is p + 1, the message is ready to be read. After reading, it is set to p + NumMessageSlots.
+		*/
+		struct ConsoleMessage
+		{
+			Atomic<uint32> sequence;
+			WarningLevel warningLevel;
+			char processorId[MaxProcessorIdLength];
+			char text[MaxMessageLength];
+		};
+
+		/** Copies the message into the next free slot. Returns false if the queue is full. */
+		bool addMessage(const String& processorId, const String& t, WarningLevel warningLevel);
+
+		void flushMessages(String& message);
+
+		ConsoleMessage messages[NumMessageSlots];
+
+		Atomic<uint32> writeTicket;
+		uint32 readPosition = 0;
+
+		Atomic<int> pendingMessages;
+		Atomic<int> droppedMessages;
+		Atomic<int> totalDroppedMessages;
 
 		bool clearFlag = false;
 
@@ -574,6 +832,14 @@ public:
 	CodeHandler& getConsoleHandler() { return codeHandler; };
 	const CodeHandler& getConsoleHandler() const { return codeHandler; };
 
+	AnalysisService& getAnalysisService() { return analysisService; }
+
+	ProcessorRegistry& getProcessorRegistry() { return processorRegistry; }
+
+	/** Use this to add, remove or move processors without locking the audio thread. @see GraphEditQueue */
+	GraphEditQueue& getGraphEditQueue() { return graphEditQueue; }
+	const ProcessorRegistry& getProcessorRegistry() const { return processorRegistry; }
+
 	ProcessorChangeHandler& getProcessorChangeHandler() { return processorChangeHandler; }
 	const ProcessorChangeHandler& getProcessorChangeHandler() const { return processorChangeHandler; }
 
@@ -623,6 +889,14 @@ public:
 	/** Returns the uptime in seconds. */
 	double getUptime() const noexcept { return uptime; }
 
+	/** Returns the number of samples of the block that is currently rendered.
+	*
+	*	The engine is prepared for the largest block size the host announced, but hosts may call the render callback with
+	*	smaller (or irregular) blocks, which are rendered directly. Use this instead of Processor::getBlockSize() if you
+	*	need the length of the current block.
+	*/
+	int getCurrentBlockSize() const noexcept { return currentBlockSize.get(); }
+
 	/** returns the tempo as bpm. */
     double getBpm() const noexcept
     {
@@ -1003,6 +1277,9 @@ private:
 	HiseEventBuffer masterEventBuffer;
 	EventIdHandler eventIdHandler;
 	UserPresetHandler userPresetHandler;
+	AnalysisService analysisService;
+	ProcessorRegistry processorRegistry;
+	GraphEditQueue graphEditQueue;
 	ProcessorChangeHandler processorChangeHandler;
 	GlobalAsyncModuleHandler globalAsyncModuleHandler;
 
@@ -1034,6 +1311,7 @@ private:
 	Component::SafePointer<Plotter> plotter;
 
 	Atomic<int> bufferSize;
+	Atomic<int> currentBlockSize;
 
 	Atomic<int> presetLoadRampFlag;
 
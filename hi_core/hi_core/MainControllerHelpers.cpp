@@ -313,7 +313,7 @@ public:
 
 	bool shouldDelayRendering() const 
 	{
-#if IS_STANDALONE_APP || IS_STANDALONE_FRONTEND
+#if IS_STANDALONE_APP || IS_STANDALONE_FRONTEND || !USE_DELAYED_RENDERING_FOR_FL_STUDIO
 		return false;
 #else
 		return hostType.isFruityLoops();
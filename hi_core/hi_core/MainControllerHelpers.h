@@ -256,6 +256,7 @@ private:
 /** This introduces an artificial delay of max 256 samples and calls the internal processing loop with a fixed number of samples.
 *
 *	This is supposed to offer a rather ugly fallback solution for hosts who change their processing size constantly (eg. FL Studio).
+*	The engine renders variable block sizes directly now, so it is only used if USE_DELAYED_RENDERING_FOR_FL_STUDIO is enabled.
 */
 class DelayedRenderer
 {
@@ -265,7 +266,7 @@ public:
 
 	~DelayedRenderer();
 
-	/** Checks whether this should be used. It currently is only activated on FL Studio. */
+	/** Checks whether this should be used. It is only activated on FL Studio if USE_DELAYED_RENDERING_FOR_FL_STUDIO is set. */
 	bool shouldDelayRendering() const;
 
 	/** Wraps the processing and delays the processing if necessary. */
@@ -357,42 +357,393 @@ void MainController::UserPresetHandler::loadPresetInternal()
 }
 
 
+MainController::ProcessorRegistry::ProcessorRegistry(MainController* mc_) :
+	mc(mc_),
+	generation(1),
+	indexedGeneration(0)
+{
+
+}
+
+Array<Processor*> MainController::ProcessorRegistry::getProcessorsWithId(const String& id, const Processor* root)
+{
+	ScopedLock sl(lock);
+
+	rebuildIfNecessary();
+
+	Array<Processor*> list;
+	Range<int> range;
+
+	if (!getSubtreeRange(root, range))
+	{
+		// Not part of the main tree (yet), so fall back to a linear search
+		Processor::Iterator<Processor> it(root);
+
+		while (Processor* p = it.getNextProcessor())
+		{
+			if (p->getId() == id)
+				list.add(p);
+		}
+
+		return list;
+	}
+
+	if (!firstIndexWithId.contains(id))
+		return list;
+
+	for (int i = firstIndexWithId[id]; i != -1; i = entries.getReference(i).nextWithSameId)
+	{
+		if (range.contains(i))
+		{
+			if (Processor* p = entries.getReference(i).processor.get())
+				list.add(p);
+		}
+	}
+
+	return list;
+}
+
+Array<Processor*> MainController::ProcessorRegistry::getProcessorsOfType(const std::type_info& type, TypeCheckFunction typeCheck, const Processor* root)
+{
+	ScopedLock sl(lock);
+
+	rebuildIfNecessary();
+
+	Array<Processor*> list;
+	Range<int> range;
+
+	if (!getSubtreeRange(root, range))
+	{
+		Processor::Iterator<Processor> it(root);
+
+		while (Processor* p = it.getNextProcessor())
+		{
+			if (typeCheck(p))
+				list.add(p);
+		}
+
+		return list;
+	}
+
+	TypeIndex* typeIndex = nullptr;
+
+	for (int i = 0; i < typeIndexes.size(); i++)
+	{
+		if (*typeIndexes[i]->type == type)
+		{
+			typeIndex = typeIndexes[i];
+			break;
+		}
+	}
+
+	if (typeIndex == nullptr)
+	{
+		typeIndex = typeIndexes.add(new TypeIndex());
+		typeIndex->type = &type;
+
+		for (int i = 0; i < entries.size(); i++)
+		{
+			Processor* p = entries.getReference(i).processor.get();
+
+			if (p != nullptr && typeCheck(p))
+				typeIndex->indexes.add(i);
+		}
+	}
+
+	for (int i = 0; i < typeIndex->indexes.size(); i++)
+	{
+		const int index = typeIndex->indexes.getUnchecked(i);
+
+		if (index >= range.getEnd())
+			break;
+
+		if (index < range.getStart())
+			continue;
+
+		if (Processor* p = entries.getReference(index).processor.get())
+			list.add(p);
+	}
+
+	return list;
+}
+
+void MainController::ProcessorRegistry::rebuildIfNecessary()
+{
+	const uint32 currentGeneration = generation.get();
+
+	if (currentGeneration == indexedGeneration)
+		return;
+
+	entries.clearQuick();
+	processorIndexes.clear();
+	firstIndexWithId.clear();
+	typeIndexes.clear();
+
+	if (Processor* root = mc->getMainSynthChain())
+		addToIndex(root);
+
+	// Link the processors with the same ID in iteration order
+	for (int i = entries.size() - 1; i >= 0; i--)
+	{
+		Entry& e = entries.getReference(i);
+
+		if (Processor* p = e.processor.get())
+		{
+			const String& id = p->getId();
+
+			e.nextWithSameId = firstIndexWithId.contains(id) ? firstIndexWithId[id] : -1;
+			firstIndexWithId.set(id, i);
+		}
+	}
+
+	indexedGeneration = currentGeneration;
+}
+
+void MainController::ProcessorRegistry::addToIndex(Processor* p)
+{
+	const int index = entries.size();
+
+	Entry e;
+	e.processor = p;
+	e.subtreeEnd = index + 1;
+	e.nextWithSameId = -1;
+
+	entries.add(e);
+	processorIndexes.set(p, index);
+
+	for (int i = 0; i < p->getNumChildProcessors(); i++)
+	{
+		if (Processor* child = p->getChildProcessor(i))
+			addToIndex(child);
+	}
+
+	entries.getReference(index).subtreeEnd = entries.size();
+}
+
+bool MainController::ProcessorRegistry::getSubtreeRange(const Processor* root, Range<int>& range)
+{
+	if (root == nullptr)
+	{
+		range = Range<int>(0, entries.size());
+		return true;
+	}
+
+	if (!processorIndexes.contains(root))
+		return false;
+
+	const int index = processorIndexes[root];
+
+	range = Range<int>(index, entries.getReference(index).subtreeEnd);
+	return true;
+}
+
+MainController::GraphEditQueue::GraphEditQueue(MainController* mc_) :
+	mc(mc_),
+	pendingEdit(nullptr),
+	lastBlockTime(0),
+	audioThreadId(nullptr),
+	mainLockBusy(0)
+{
+
+}
+
+void MainController::GraphEditQueue::performEdit(const EditFunction& f)
+{
+	if (Thread::getCurrentThreadId() == audioThreadId.get())
+	{
+		ScopedLock sl(mc->processLock);
+		f();
+		return;
+	}
+
+	// Only one edit can be pending at a time.
+	ScopedEditLock sl(*this);
+
+	Edit edit(f);
+
+	pendingEdit.set(&edit);
+
+	while (edit.applied.get() == 0)
+	{
+		if (tryToApplyPendingEdit())
+			break;
+
+		Thread::sleep(1);
+	}
+}
+
+void MainController::GraphEditQueue::applyPendingEdit()
+{
+	audioThreadId.set(Thread::getCurrentThreadId());
+	lastBlockTime.set(Time::getMillisecondCounter());
+	mainLockBusy.set(0);
+
+	applyEdit();
+}
+
+bool MainController::GraphEditQueue::tryToApplyPendingEdit()
+{
+	// As long as the audio thread renders, it applies the edit so it never misses the lock because of us
+	if (isAudioCallbackRunning() && mainLockBusy.get() == 0)
+		return false;
+
+	// This succeeds if this thread already holds the main lock (eg. while compiling a script)
+	ScopedTryLock sl(mc->processLock);
+
+	if (!sl.isLocked())
+		return false;
+
+	applyEdit();
+	return true;
+}
+
+void MainController::GraphEditQueue::applyEdit()
+{
+	Edit* e = pendingEdit.get();
+
+	if (e != nullptr)
+	{
+		e->f();
+
+		pendingEdit.set(nullptr);
+
+		// Don't touch e after this, the waiting thread will return immediately.
+		e->applied.set(1);
+	}
+}
+
+MainController::GraphEditQueue::ScopedEditLock::ScopedEditLock(GraphEditQueue& queue_) :
+	queue(queue_)
+{
+	while (!queue.editLock.tryEnter())
+	{
+		// The other thread might wait for the main lock that this thread holds...
+		queue.tryToApplyPendingEdit();
+		Thread::sleep(1);
+	}
+}
+
+MainController::GraphEditQueue::ScopedEditLock::~ScopedEditLock()
+{
+	queue.editLock.exit();
+}
+
+bool MainController::GraphEditQueue::isAudioCallbackRunning() const
+{
+	if (mc->getAsAudioProcessor()->isSuspended())
+		return false;
+
+	const uint32 lastTime = lastBlockTime.get();
+
+	return lastTime != 0 && Time::getMillisecondCounter() - lastTime < 100;
+}
+
 MainController::CodeHandler::CodeHandler(MainController* mc_):
 	mc(mc_)
 {
+	for (int i = 0; i < NumMessageSlots; i++)
+		messages[i].sequence.set((uint32)i);
 
+	// Messages from other threads are picked up here so that writing them never has to post a message
+	startTimer(50);
 }
 
 
 
 
-void MainController::CodeHandler::writeToConsole(const String &t, int warningLevel, const Processor *p, Colour c)
+void MainController::CodeHandler::writeToConsole(const String &t, int warningLevel, const Processor *p, Colour /*c*/)
 {
-	if (overflowProtection) return;
+	if (p == nullptr)
+	{
+		jassertfalse;
+		return;
+	}
 
-	else
+	if (!addMessage(p->getId(), t, (WarningLevel)warningLevel))
 	{
-		ScopedLock sl(getLock());
+		droppedMessages += 1;
+		totalDroppedMessages += 1;
+	}
+
+	pendingMessages.set(1);
 
-		if (unprintedMessages.size() > 10)
+	MessageManager* messageManager = MessageManager::getInstanceWithoutCreating();
+
+	if (messageManager != nullptr && messageManager->isThisTheMessageThread())
+	{
+		handleAsyncUpdate();
+	}
+}
+
+bool MainController::CodeHandler::addMessage(const String& processorId, const String& t, WarningLevel warningLevel)
+{
+	uint32 position = writeTicket.get();
+
+	for (;;)
+	{
+		ConsoleMessage& m = messages[position % NumMessageSlots];
+
+		const int diff = (int)(m.sequence.get() - position);
+
+		if (diff == 0)
 		{
-			unprintedMessages.push_back(ConsoleMessage(Error, const_cast<Processor*>(p), "Console Overflow"));
-			overflowProtection = true;
-			return;
+			// The slot is free, so only now the position is taken. A dropped message never consumes a position.
+			if (writeTicket.compareAndSetBool(position + 1, position))
+			{
+				m.warningLevel = warningLevel;
+				processorId.copyToUTF8(m.processorId, MaxProcessorIdLength);
+				t.copyToUTF8(m.text, MaxMessageLength);
+
+				m.sequence.set(position + 1);
+				return true;
+			}
+
+			position = writeTicket.get();
+		}
+		else if (diff < 0)
+		{
+			// The slot still holds the message from the last round, so the queue is full
+			return false;
 		}
 		else
 		{
-			unprintedMessages.push_back(ConsoleMessage((WarningLevel)warningLevel, const_cast<Processor*>(p), t));
+			// Another writer took this position
+			position = writeTicket.get();
 		}
 	}
+}
 
-	if (MessageManager::getInstance()->isThisTheMessageThread())
-	{
+void MainController::CodeHandler::timerCallback()
+{
+	if (pendingMessages.get() != 0)
 		handleAsyncUpdate();
+}
+
+void MainController::CodeHandler::flushMessages(String& message)
+{
+	pendingMessages.set(0);
+
+	for (;;)
+	{
+		ConsoleMessage& m = messages[readPosition % NumMessageSlots];
+
+		// Stop at the first slot that is not written completely to keep the order
+		if (m.sequence.get() != readPosition + 1)
+			break;
+
+		message << String::fromUTF8(m.processorId) << ":";
+		message << (m.warningLevel == WarningLevel::Error ? "! " : " ");
+		message << String::fromUTF8(m.text) << "\n";
+
+		m.sequence.set(readPosition + NumMessageSlots);
+		readPosition++;
 	}
-	else
+
+	const int numDropped = droppedMessages.exchange(0);
+
+	if (numDropped > 0)
 	{
-		triggerAsyncUpdate();
+		message << "Console:! " << String(numDropped) << " messages were dropped because the console queue was full\n";
 	}
 }
 
@@ -410,37 +761,15 @@ void MainController::CodeHandler::handleAsyncUpdate()
 		clearFlag = false;
 	}
 
-	std::vector<ConsoleMessage> messagesForThisTime;
-	messagesForThisTime.reserve(10);
-
-	if (unprintedMessages.size() != 0)
-	{
-		ScopedLock sl(getLock());
-		messagesForThisTime.swap(unprintedMessages);
-	}
-	else return;
-
 	String message;
 
-	for (size_t i = 0; i < messagesForThisTime.size(); i++)
-	{
-		const Processor* processor = std::get<(int)ConsoleMessageItems::Processor>(messagesForThisTime[i]).get();
-
-		if (processor == nullptr)
-		{
-			jassertfalse;
-			continue;
-		}
+	flushMessages(message);
 
-		message << processor->getId() << ":";
-		message << (std::get<(int)ConsoleMessageItems::WarningLevel>(messagesForThisTime[i]) == WarningLevel::Error ? "! " : " ");
-		message << std::get<(int)ConsoleMessageItems::Message>(messagesForThisTime[i]) << "\n";
-	}
+	if (message.isEmpty())
+		return;
 
 	consoleData.insertText(consoleData.getNumCharacters(), message);
 
-	overflowProtection = false;
-
 	if (getMainConsole() != nullptr)
 	{
 		auto rootWindow = GET_BACKEND_ROOT_WINDOW(mainConsole);
@@ -451,6 +780,10 @@ void MainController::CodeHandler::handleAsyncUpdate()
 			BackendPanelHelpers::toggleVisibilityForRightColumnPanel<ConsolePanel>(rootWindow->getRootFloatingTile(), true);
 		}
 	}
+#else
+	// There is no console, but the slots must be freed anyway
+	String message;
+	flushMessages(message);
 #endif
 }
 
@@ -638,3 +971,157 @@ void MainController::EventIdHandler::addCCRemap(int firstCC_, int secondCC_)
 		secondCC_ = -1;
 	}
 }
+
+
+#if HI_RUN_UNIT_TESTS
+
+/** Checks that the console queue keeps the order of the messages after it was full. */
+class ConsoleQueueTest : public UnitTest
+{
+public:
+
+	ConsoleQueueTest() :
+		UnitTest("Testing the console message queue")
+	{
+
+	}
+
+	void runTest() override
+	{
+		MainController::CodeHandler handler(nullptr);
+
+		// The messages are flushed manually in this test
+		handler.stopTimer();
+
+		testOverflow(handler);
+		testMultipleWriters(handler);
+	}
+
+private:
+
+	static StringArray flush(MainController::CodeHandler& handler)
+	{
+		String message;
+		handler.flushMessages(message);
+
+		StringArray lines = StringArray::fromLines(message);
+		lines.removeEmptyStrings();
+		return lines;
+	}
+
+	void testOverflow(MainController::CodeHandler& handler)
+	{
+		beginTest("Messages after an overflow are delivered in order");
+
+		int nextIndex = 0;
+
+		for (int round = 0; round < 5; round++)
+		{
+			const int firstIndex = nextIndex;
+
+			for (int i = 0; i < MainController::CodeHandler::NumMessageSlots; i++)
+				expect(handler.addMessage("Test", String(nextIndex++), MainController::CodeHandler::Message));
+
+			// These are dropped without taking a slot
+			for (int i = 0; i < 10; i++)
+				expect(!handler.addMessage("Test", "Dropped", MainController::CodeHandler::Message), "The queue should be full");
+
+			StringArray lines = flush(handler);
+
+			expectEquals<int>(lines.size(), MainController::CodeHandler::NumMessageSlots);
+
+			for (int i = 0; i < lines.size(); i++)
+				expectEquals(lines[i], "Test: " + String(firstIndex + i));
+
+			// A few messages that don't fill the queue must arrive right away
+			for (int i = 0; i < round + 3; i++)
+				expect(handler.addMessage("Test", String(nextIndex++), MainController::CodeHandler::Message));
+
+			lines = flush(handler);
+
+			expectEquals<int>(lines.size(), round + 3);
+
+			for (int i = 0; i < lines.size(); i++)
+				expectEquals(lines[i], "Test: " + String(nextIndex - (round + 3) + i));
+		}
+	}
+
+	class Writer : public Thread
+	{
+	public:
+
+		Writer(MainController::CodeHandler& handler_, int index_) :
+			Thread("Console Writer"),
+			handler(handler_),
+			index(index_)
+		{}
+
+		void run() override
+		{
+			for (int i = 0; i < NumMessagesPerWriter; i++)
+			{
+				// Spinning could starve the reading thread on a single core
+				while (!handler.addMessage(String(index), String(i), MainController::CodeHandler::Message))
+					Thread::sleep(1);
+			}
+		}
+
+		MainController::CodeHandler& handler;
+		const int index;
+	};
+
+	void testMultipleWriters(MainController::CodeHandler& handler)
+	{
+		beginTest("Multiple writers");
+
+		OwnedArray<Writer> writers;
+
+		for (int i = 0; i < NumWriters; i++)
+			writers.add(new Writer(handler, i));
+
+		for (auto w : writers)
+			w->startThread();
+
+		int lastMessage[NumWriters];
+
+		for (int i = 0; i < NumWriters; i++)
+			lastMessage[i] = -1;
+
+		int numReceived = 0;
+		const uint32 timeout = Time::getMillisecondCounter() + 10000;
+
+		while (numReceived < NumWriters * NumMessagesPerWriter && Time::getMillisecondCounter() < timeout)
+		{
+			StringArray lines = flush(handler);
+
+			if (lines.isEmpty())
+				Thread::sleep(1);
+
+			for (auto& l : lines)
+			{
+				const int writer = l.upToFirstOccurrenceOf(":", false, false).getIntValue();
+				const int value = l.fromFirstOccurrenceOf(": ", false, false).getIntValue();
+
+				// The messages of one writer must arrive in order and without gaps
+				expectEquals(value, lastMessage[writer] + 1);
+				lastMessage[writer] = value;
+				numReceived++;
+			}
+		}
+
+		for (auto w : writers)
+			w->stopThread(1000);
+
+		expectEquals(numReceived, NumWriters * NumMessagesPerWriter);
+	}
+
+	enum
+	{
+		NumWriters = 4,
+		NumMessagesPerWriter = 2000
+	};
+};
+
+static ConsoleQueueTest consoleQueueTest;
+
+#endif
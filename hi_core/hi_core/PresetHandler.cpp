@@ -87,12 +87,16 @@ mc(mc_)
 {
 	userPresets = new PresetCategory("User Presets");
 
+	scanner = new Scanner(*this);
+
 	refreshPresetFileList();
 }
 
 
 UserPresetData::~UserPresetData()
 {
+	scanner = nullptr;
+
 	mc = nullptr;
 	listeners.clear();
 }
@@ -104,13 +108,13 @@ void UserPresetData::getCurrentPresetIndexes(int &category, int &preset, String
 	name = currentName;
 }
 
-void UserPresetData::addFactoryPreset(const String &name, const String &category, int id, ValueTree &v)
+void UserPresetData::addFactoryPreset(OwnedArray<PresetCategory>& categories, const String &name, const String &category, int id, const ValueTree &v)
 {
 	int index = -1;
 
-	for (int i = 0; i < factoryPresetCategories.size(); i++)
+	for (int i = 0; i < categories.size(); i++)
 	{
-		if (factoryPresetCategories[i]->name == category)
+		if (categories[i]->name == category)
 		{
 			index = i;
 			break;
@@ -121,19 +125,14 @@ void UserPresetData::addFactoryPreset(const String &name, const String &category
 	{
 		PresetCategory *newCategory = new PresetCategory(category);
 		newCategory->presets.add(Entry(name, id, v));
-		factoryPresetCategories.add(newCategory);
+		categories.add(newCategory);
 	}
 	else
 	{
-		factoryPresetCategories[index]->presets.add(Entry(name, id, v));
+		categories[index]->presets.add(Entry(name, id, v));
 	}
 }
 
-void UserPresetData::addUserPreset(const String &name, int id, const ValueTree &v)
-{
-	userPresets->presets.add(Entry(name, id, v));
-}
-
 void UserPresetData::fillCategoryList(StringArray& listToFill) const
 {
 	listToFill.clear();
@@ -271,45 +270,17 @@ void UserPresetData::refreshPresetFileList()
 {
 #if USE_BACKEND
 
-	Array<File> fileList;
-
 	ProjectHandler *handler = &GET_PROJECT_HANDLER(mc->getMainSynthChain());
 
-	handler->getFileList(fileList, ProjectHandler::SubDirectories::UserPresets, "*.preset", false, true);
-
-	factoryPresetCategories.clear();
-	userPresets->presets.clear();
-
-	for (int i = 0; i < fileList.size(); i++)
-	{
-		const File parentDirectory = fileList[i].getParentDirectory();
-		const File presetDirectory = handler->getSubDirectory(ProjectHandler::SubDirectories::UserPresets);
-		const bool useCategory = (presetDirectory != parentDirectory);
-		const String categoryName = useCategory ? fileList[i].getParentDirectory().getFileName() : "Uncategorized";
-
-		ScopedPointer<XmlElement> xml = XmlDocument::parse(fileList[i]);
+	if (!handler->isActive())
+		return;
 
-		if (xml != nullptr)
-		{
-			ValueTree v = ValueTree::fromXml(*xml);
-			addFactoryPreset(fileList[i].getFileNameWithoutExtension(), categoryName, i + 1, v);
-		}
-	}
+	scanner->scan(handler->getSubDirectory(ProjectHandler::SubDirectories::UserPresets), true, ValueTree());
 
 #else
 
 	ValueTree factoryPresets = dynamic_cast<FrontendDataHolder*>(mc)->getValueTree(ProjectHandler::SubDirectories::UserPresets);
 
-	factoryPresetCategories.clear();
-	userPresets->presets.clear();
-
-	for (int i = 1; i < factoryPresets.getNumChildren(); i++)
-	{
-		ValueTree c = factoryPresets.getChild(i);
-
-		addFactoryPreset(c.getProperty("FileName"), c.getProperty("Category"), i, c);
-	}
-
     File userPresetDirectory;
     
     try
@@ -323,24 +294,129 @@ void UserPresetData::refreshPresetFileList()
         return;
     }
 
+	scanner->scan(userPresetDirectory, false, factoryPresets);
 
-	Array<File> newUserPresets;
-	userPresetDirectory.findChildFiles(newUserPresets, File::findFiles, false, "*.preset");
+#endif
+
+}
 
-	for (int i = 0; i < newUserPresets.size(); i++)
+UserPresetData::Scanner::Scanner(UserPresetData& parent_) :
+	Thread("User Preset Scanner"),
+	parent(parent_)
+{
+	startThread(3);
+}
+
+UserPresetData::Scanner::~Scanner()
+{
+	stopThread(3000);
+	cancelPendingUpdate();
+}
+
+void UserPresetData::Scanner::scan(const File& presetDirectory, bool searchInSubfolders, const ValueTree& factoryPresets)
+{
 	{
-		ScopedPointer<XmlElement> xml = XmlDocument::parse(newUserPresets[i]);
+		ScopedLock sl(lock);
 
-		if (xml != nullptr)
+		directory = presetDirectory;
+		recursive = searchInSubfolders;
+		factoryPresetTree = factoryPresets;
+		scanPending = true;
+	}
+
+	notify();
+}
+
+void UserPresetData::Scanner::run()
+{
+	while (!threadShouldExit())
+	{
+		File dir;
+		bool searchInSubfolders;
+		ValueTree factoryPresets;
+
+		{
+			ScopedLock sl(lock);
+
+			if (!scanPending)
+			{
+				ScopedUnlock sul(lock);
+				wait(-1);
+				continue;
+			}
+
+			dir = directory;
+			searchInSubfolders = recursive;
+			factoryPresets = factoryPresetTree;
+			scanPending = false;
+		}
+
+		OwnedArray<PresetCategory> newFactoryPresets;
+		ScopedPointer<PresetCategory> newUserPresets = new PresetCategory("User Presets");
+
+		for (int i = 1; i < factoryPresets.getNumChildren(); i++)
+		{
+			ValueTree c = factoryPresets.getChild(i);
+
+			addFactoryPreset(newFactoryPresets, c.getProperty("FileName"), c.getProperty("Category"), i, c);
+		}
+
+		Array<File> fileList;
+		dir.findChildFiles(fileList, File::findFiles, searchInSubfolders, "*.preset");
+
+		for (int i = 0; i < fileList.size() && !threadShouldExit(); i++)
 		{
+			// Remove hidden OSX files (in OSX they are automatically ignored...)
+			if (fileList[i].getFileName().startsWith("."))
+				continue;
+
+			ScopedPointer<XmlElement> xml = XmlDocument::parse(fileList[i]);
+
+			if (xml == nullptr)
+				continue;
+
 			ValueTree v = ValueTree::fromXml(*xml);
 
-			addUserPreset(newUserPresets[i].getFileNameWithoutExtension(), i, v);
+#if USE_BACKEND
+			const File parentDirectory = fileList[i].getParentDirectory();
+			const bool useCategory = (dir != parentDirectory);
+			const String categoryName = useCategory ? parentDirectory.getFileName() : "Uncategorized";
+
+			addFactoryPreset(newFactoryPresets, fileList[i].getFileNameWithoutExtension(), categoryName, i + 1, v);
+#else
+			newUserPresets->presets.add(Entry(fileList[i].getFileNameWithoutExtension(), i, v));
+#endif
 		}
+
+		if (threadShouldExit())
+			return;
+
+		{
+			ScopedLock sl(lock);
+
+			// A newer scan was requested in the meantime, so this result is already outdated
+			if (scanPending)
+				continue;
+
+			scannedFactoryPresets.swapWith(newFactoryPresets);
+			scannedUserPresets = newUserPresets.release();
+		}
+
+		triggerAsyncUpdate();
 	}
+}
 
-#endif
+void UserPresetData::Scanner::handleAsyncUpdate()
+{
+	ScopedLock sl(lock);
+
+	if (scannedUserPresets == nullptr)
+		return;
 
+	parent.factoryPresetCategories.swapWith(scannedFactoryPresets);
+	parent.userPresets = scannedUserPresets.release();
+
+	scannedFactoryPresets.clear();
 }
 
 
@@ -2553,19 +2629,124 @@ void PresetPlayerHandler::addInstrumentToPackageXml(const String &instrumentFile
 
 void FrontendSampleManager::loadSamplesAfterSetup()
 {
-	
+	MainController* mc = dynamic_cast<MainController*>(this);
+
+	if (isRestoringState())
+	{
+		// The samplers don't exist yet, so this will be called again by finishStateRestore()
+		loadSamplesAfterRestore = true;
+		return;
+	}
 
 	if (shouldLoadSamplesAfterSetup())
 	{
 		LOG_START("Loading samples");
 
+		readyToPlay.store(false);
+		numLoadingTasks = 0;
+		numFinishedTasks = 0;
+
+		mc->removeListener(this);
+		mc->addListener(this);
+
 		dynamic_cast<AudioProcessor*>(this)->suspendProcessing(false);
-		dynamic_cast<MainController*>(this)->getSampleManager().setShouldSkipPreloading(false);
-		dynamic_cast<MainController*>(this)->getSampleManager().preloadEverything();
+		mc->getSampleManager().setShouldSkipPreloading(false);
+		mc->getSampleManager().preloadEverything();
+
+		// Nothing to preload, so there won't be a lastTaskRemoved() callback...
+		if (!mc->isBusy())
+			setReadyToPlay();
 	}
 	else
 	{
 		dynamic_cast<AudioProcessor*>(this)->suspendProcessing(true);
+
+		setReadyToPlay();
+	}
+}
+
+double FrontendSampleManager::getLoadingProgress() const noexcept
+{
+	if (isReadyToPlay())
+		return 1.0;
+
+	return numLoadingTasks == 0 ? 0.0 : (double)numFinishedTasks / (double)numLoadingTasks;
+}
+
+void FrontendSampleManager::taskAdded()
+{
+	numLoadingTasks++;
+}
+
+void FrontendSampleManager::taskRemoved()
+{
+	numFinishedTasks++;
+}
+
+void FrontendSampleManager::lastTaskRemoved()
+{
+	if (!isReadyToPlay())
+		setReadyToPlay();
+}
+
+bool FrontendSampleManager::setPendingStateIfLoading(const ValueTree& v)
+{
+	ScopedLock sl(pendingStateLock);
+
+	if (isReadyToPlay())
+		return false;
+
+	pendingState = v;
+	return true;
+}
+
+ValueTree FrontendSampleManager::getPendingState() const
+{
+	ScopedLock sl(pendingStateLock);
+
+	return pendingState;
+}
+
+void FrontendSampleManager::startStateRestore()
+{
+	readyToPlay.store(false);
+	restoringState.store(true);
+}
+
+void FrontendSampleManager::finishStateRestore()
+{
+	restoringState.store(false);
+
+	if (loadSamplesAfterRestore)
+	{
+		loadSamplesAfterRestore = false;
+		loadSamplesAfterSetup();
+	}
+}
+
+void FrontendSampleManager::setReadyToPlay()
+{
+	numFinishedTasks = numLoadingTasks;
+
+	while (true)
+	{
+		ValueTree v;
+
+		{
+			ScopedLock sl(pendingStateLock);
+
+			v = pendingState;
+			pendingState = ValueTree();
+
+			// Set the flag while holding the lock so that no state can slip in after the last check
+			if (!v.isValid())
+			{
+				readyToPlay.store(true);
+				return;
+			}
+		}
+
+		restoreDeferredState(v);
 	}
 }
 
@@ -349,13 +349,19 @@ public:
 	virtual File getSampleLocation() const = 0;
 };
 
-/** This base class handles missing samples. */
-class FrontendSampleManager
+/** This base class handles missing samples and the progressive startup of a compiled plugin.
+*
+*	The preloading of the samples is done by the background preload threads after the constructor returned.
+*	Until all tasks are finished, isReadyToPlay() returns false so that the audio callback can render silence
+*	and the host state can be cached without touching the half-loaded signal chain.
+*/
+class FrontendSampleManager: public ThreadWithQuasiModalProgressWindow::Holder::Listener
 {
 public:
 
 	virtual ~FrontendSampleManager() {};
 
+	/** Starts the background preloading and sets the instance to the loading state until every task is finished. */
 	void loadSamplesAfterSetup();
 
 	virtual bool shouldLoadSamplesAfterSetup() const { return samplesCorrectlyLoaded; };
@@ -368,8 +374,54 @@ public:
 	void checkAllSampleReferences();
 	bool areSampleReferencesCorrect() const;
 
+	/** Returns true if the background loading has finished. This can be called from the audio thread. */
+	bool isReadyToPlay() const noexcept { return readyToPlay.load(); }
+
+	/** Returns the progress of the background loading (0.0 - 1.0). */
+	double getLoadingProgress() const noexcept;
+
+	/** Returns true while the signal chain is restored by the background loader. */
+	bool isRestoringState() const noexcept { return restoringState.load(); }
+
+	/** Stores a host state if the instance is still loading. It will be passed to restoreDeferredState() when the loading is finished.
+	*
+	*	Returns false if the instance is ready, in which case you have to restore the state yourself.
+	*/
+	bool setPendingStateIfLoading(const ValueTree& v);
+
+	/** Returns a copy of the host state that is waiting to be restored (or an invalid tree if there is none). */
+	ValueTree getPendingState() const;
+
+	void taskAdded() override;
+	void taskRemoved() override;
+	void lastTaskRemoved() override;
+
+protected:
+
+	/** Call this before the signal chain is restored on a background thread. loadSamplesAfterSetup() will wait until finishStateRestore() is called. */
+	void startStateRestore();
+
+	/** Call this on the message thread when the signal chain is restored. It starts the sample loading if it was requested in the meantime. */
+	void finishStateRestore();
+
+	/** Overwrite this and restore the state that was set while the instance was loading. */
+	virtual void restoreDeferredState(const ValueTree& /*v*/) {};
+
 private:
 
+	void setReadyToPlay();
+
+	std::atomic<bool> readyToPlay { true };
+	std::atomic<bool> restoringState { false };
+
+	bool loadSamplesAfterRestore = false;
+
+	CriticalSection pendingStateLock;
+	ValueTree pendingState;
+
+	int numLoadingTasks = 0;
+	int numFinishedTasks = 0;
+
 #if HISE_IOS
 	bool samplesCorrectlyLoaded = true;
 #else
@@ -400,7 +452,11 @@ public:
 
 	// ================================================================================================================
 
-	/** Call this when the amount of presets has changed. */
+	/** Call this when the amount of presets has changed.
+	*
+	*	The preset files are listed and parsed on a background thread, and the new list replaces the old one
+	*	on the message thread when it's done.
+	*/
 	void refreshPresetFileList();
 
 	/** Loads a preset with the given category and preset index.
@@ -453,10 +509,39 @@ private:
 		Array<Entry> presets;
 	};
 
+	/** Lists and parses the preset files on a background thread. */
+	class Scanner : public Thread,
+					public AsyncUpdater
+	{
+	public:
+
+		Scanner(UserPresetData& parent_);
+		~Scanner();
+
+		/** Starts a new scan. If a scan is running, it will be repeated with the new settings when it's finished. */
+		void scan(const File& presetDirectory, bool searchInSubfolders, const ValueTree& factoryPresets);
+
+		void run() override;
+		void handleAsyncUpdate() override;
+
+	private:
+
+		UserPresetData& parent;
+
+		CriticalSection lock;
+
+		File directory;
+		bool recursive = false;
+		ValueTree factoryPresetTree;
+		bool scanPending = false;
+
+		OwnedArray<PresetCategory> scannedFactoryPresets;
+		ScopedPointer<PresetCategory> scannedUserPresets;
+	};
+
 	// ================================================================================================================
 
-	void addFactoryPreset(const String &name, const String &category, int id, ValueTree &v);
-	void addUserPreset(const String &name, int id, const ValueTree &v);
+	static void addFactoryPreset(OwnedArray<PresetCategory>& categories, const String &name, const String &category, int id, const ValueTree &v);
 	const PresetCategory* getPresetCategory(int index) const;
 
 	MainController* mc;
@@ -465,6 +550,8 @@ private:
 	OwnedArray<PresetCategory> factoryPresetCategories;
 	ScopedPointer<PresetCategory> userPresets;
 
+	ScopedPointer<Scanner> scanner;
+
 	mutable String currentName = "Default";
 	mutable int currentCategoryIndex = 0;
 	mutable	int currentPresetIndex = 0;
@@ -84,6 +84,7 @@ using namespace juce;
 #include "Popup.cpp"
 #include "Console.cpp"
 #include "BackgroundThreads.cpp"
+#include "AnalysisTaps.cpp"
 #include "SettingsWindows.cpp"
 #include "MiscComponents.cpp"
 #include "JavascriptTokeniser.cpp"
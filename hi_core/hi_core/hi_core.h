@@ -79,6 +79,7 @@ namespace hise
 #include "UpdateMerger.h"
 #include "ExternalFilePool.h"
 #include "BackgroundThreads.h"
+#include "AnalysisTaps.h"
 #include "SettingsWindows.h"
 
 #include "PresetHandler.h"
@@ -45,6 +45,8 @@ void Processor::restoreFromValueTree(const ValueTree &previouslyExportedProcesso
 
 	const ValueTree &v = previouslyExportedProcessorState;
 
+	markValueTreeDirty();
+
 	jassert(Identifier(v.getProperty("Type", String())) == getType());
 
 	jassert(v.getProperty("ID", String()) == getId());
@@ -83,6 +85,76 @@ void Processor::restoreFromValueTree(const ValueTree &previouslyExportedProcesso
 	}
 };
 
+ValueTree Processor::exportAsValueTreeCached() const
+{
+	ScopedLock sl(valueTreeCacheLock);
+
+	if (!isValueTreeCacheValid())
+	{
+		// Clear the flag before exporting so that a change during the export is not lost
+		valueTreeDirty.set(0);
+
+		cachedChildTrees.clearQuick();
+
+		// A plain exportAsValueTree() on another thread must not use or change the cache
+		cachedExportThread.set(Thread::getCurrentThreadId());
+		cachedValueTree = exportAsValueTree();
+		cachedExportThread.set(nullptr);
+	}
+
+	// The tree of the last export might still be a child of the parent's old tree
+	ValueTree parent = cachedValueTree.getParent();
+
+	if (parent.isValid())
+		parent.removeChild(cachedValueTree, nullptr);
+
+	return cachedValueTree;
+}
+
+bool Processor::canCacheValueTree() const
+{
+	return dynamic_cast<const LookupTableProcessor*>(this) == nullptr &&
+		   dynamic_cast<const SliderPackProcessor*>(this) == nullptr &&
+		   dynamic_cast<const AudioSampleProcessor*>(this) == nullptr &&
+		   dynamic_cast<const ProcessorWithScriptingContent*>(this) == nullptr;
+}
+
+ValueTree Processor::exportChildAsValueTree(int childIndex) const
+{
+	const Processor* child = getChildProcessor(childIndex);
+
+	if (cachedExportThread.get() != Thread::getCurrentThreadId())
+		return child->exportAsValueTree();
+
+	ValueTree childTree = child->exportAsValueTreeCached();
+	cachedChildTrees.add(childTree);
+	return childTree;
+}
+
+bool Processor::isValueTreeCacheValid() const
+{
+	ScopedLock sl(valueTreeCacheLock);
+
+	if (valueTreeDirty.get() != 0 || !cachedValueTree.isValid() || !canCacheValueTree())
+		return false;
+
+	if (cachedChildTrees.size() != getNumChildProcessors())
+		return false;
+
+	for (int i = 0; i < getNumChildProcessors(); i++)
+	{
+		const Processor* child = getChildProcessor(i);
+
+		ScopedLock childLock(child->valueTreeCacheLock);
+
+		// A child that was added, moved or exported again invalidates this tree
+		if (!child->isValueTreeCacheValid() || child->cachedValueTree != cachedChildTrees[i])
+			return false;
+	}
+
+	return true;
+}
+
 void Processor::setConstrainerForAllInternalChains(BaseConstrainer *constrainer)
 {
 	FactoryType::Constrainer* c = static_cast<FactoryType::Constrainer*>(constrainer);
@@ -248,16 +320,9 @@ String FactoryType::getUniqueName(Processor *id, String name/*=String()*/)
 
 Processor *ProcessorHelpers::getFirstProcessorWithName(const Processor *root, const String &name)
 {
-	Processor::Iterator<Processor> iter(const_cast<Processor*>(root), false);
-
-	Processor *p;
+	MainController* mc = const_cast<Processor*>(root)->getMainController();
 
-	while((p = iter.getNextProcessor()) != nullptr)
-	{
-		if(p->getId() == name) return p;
-	}
-
-	return nullptr;
+	return mc->getProcessorRegistry().getProcessorsWithId(name, root).getFirst();
 }
 
 const Processor *ProcessorHelpers::findParentProcessor(const Processor *childProcessor, bool getParentSynth)
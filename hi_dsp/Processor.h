@@ -111,11 +111,14 @@ public:
 		{
 			idAsIdentifier = Identifier(id);
 		}
+
+		getMainController()->getProcessorRegistry().markDirty();
 	};
 
 	/** Overwrite this if you need custom destruction behaviour. */
 	virtual ~Processor()
 	{
+		getMainController()->getProcessorRegistry().markDirty();
 		getMainController()->getMacroManager().removeMacroControlsFor(this);
 		masterReference.clear();
 		removeAllChangeListeners();	
@@ -196,7 +199,7 @@ public:
 
 		for(int i = 0; i < getNumChildProcessors(); i++)
 		{
-			v.addChild(getChildProcessor(i)->exportAsValueTree(), i, nullptr);
+			v.addChild(exportChildAsValueTree(i), i, nullptr);
 		};
 
 #else
@@ -207,7 +210,7 @@ public:
 
 		for(int i = 0; i < getNumChildProcessors(); i++)
 		{
-			childProcessors.addChild(getChildProcessor(i)->exportAsValueTree(), i, nullptr);
+			childProcessors.addChild(exportChildAsValueTree(i), i, nullptr);
 		};
 
 		v.addChild(childProcessors, -1, nullptr);
@@ -215,6 +218,30 @@ public:
 		return v;
 
 	};
+
+	/** Returns the same tree as exportAsValueTree(), but reuses the subtrees of unchanged processors.
+	*
+	*	Every processor keeps the tree of its last cached export. It is only exported again if it was marked dirty
+	*	with markValueTreeDirty() or if one of its child processors was exported again, so the cost of saving
+	*	scales with the amount of changed processors.
+	*
+	*	The cache is locked during the export, so this can be called from any thread. The returned tree must not be 
+	*	modified except for the root processor (which never caches its own tree if it is the main synth chain).
+	*/
+	ValueTree exportAsValueTreeCached() const;
+
+	/** Invalidates the cached tree of this processor. 
+	*
+	*	This is called automatically for attribute, bypass, ID and editor state changes. Call it from your subclass wherever
+	*	you change any other state that is saved in exportAsValueTree(). This is lock-free and can be called from any thread.
+	*/
+	void markValueTreeDirty() noexcept { valueTreeDirty.set(1); }
+
+	/** Overwrite this and return false if the state of your processor can change without calling markValueTreeDirty(). 
+	*
+	*	By default, processors with tables, slider packs, audio files or scripts are never cached.
+	*/
+	virtual bool canCacheValueTree() const;
 	
 	/** Restores a previously saved ValueTree. 
 	*
@@ -286,6 +313,8 @@ public:
 					 
 	{
 		setInternalAttribute(parameterIndex, newValue);
+		markValueTreeDirty();
+
 		if(notifyEditor == sendNotification) sendChangeMessage();
 	}
 
@@ -360,6 +389,9 @@ public:
 			idAsIdentifier = Identifier();
 		}
 
+		getMainController()->getProcessorRegistry().markDirty();
+		markValueTreeDirty();
+
 		sendChangeMessage();
 
 		if (notifyChangeHandler)
@@ -377,6 +409,7 @@ public:
 	{ 
 		bypassed = shouldBeBypassed; 
 		currentValues.clear();
+		markValueTreeDirty();
 
 		if (notifyChangeHandler)
 			getMainController()->getProcessorChangeHandler().sendProcessorChangeMessage(this, MainController::ProcessorChangeHandler::EventType::ProcessorBypassed, false);
@@ -435,6 +468,7 @@ public:
 		const Identifier stateId = getEditorStateForIndex(state);
 
 		editorStateValueSet.set(stateId, isOn);
+		markValueTreeDirty();
 
         if(notifyView)
 		{
@@ -452,6 +486,7 @@ public:
 		jassert(state.isValid());
 
 		editorStateValueSet.set(state, stateValue);
+		markValueTreeDirty();
 
 		if(notifyView)
 		{
@@ -810,8 +845,18 @@ protected:
 
 private:
 
+	ValueTree exportChildAsValueTree(int childIndex) const;
+
+	bool isValueTreeCacheValid() const;
+
 	Array<WeakReference<DeleteListener>> deleteListeners;
 
+	mutable CriticalSection valueTreeCacheLock;
+	mutable ValueTree cachedValueTree;
+	mutable Array<ValueTree> cachedChildTrees;
+	mutable Atomic<Thread::ThreadID> cachedExportThread;
+	Atomic<int> valueTreeDirty;
+
 	CriticalSection dummyLock;
 
 	bool onAir = false;
@@ -34,6 +34,7 @@
 
 RoutableProcessor::MatrixData::MatrixData(RoutableProcessor *p) :
 owningProcessor(p),
+thisAsProcessor(nullptr),
 numSourceChannels(2),
 numDestinationChannels(2),
 resizeAllowed(false),
@@ -524,6 +525,9 @@ void RoutableProcessor::MatrixData::refreshSourceUseStates()
 
 	owningProcessor->connectionChanged();
 
+	if (thisAsProcessor != nullptr)
+		thisAsProcessor->markValueTreeDirty();
+
 	sendChangeMessage();
 }
 
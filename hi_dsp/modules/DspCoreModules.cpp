@@ -0,0 +1,1318 @@
+/*
+  ==============================================================================
+
+    DspCoreModules.cpp
+    Created: 10 Jul 2016 1:00:04pm
+    Author:  Christoph
+
+  ==============================================================================
+*/
+
+
+DelayLine::DelayLine() :
+	bufferSize(0),
+	bufferMask(0),
+	maxDelayTime(0.0),
+	maxDelaySamples(DefaultMaxDelaySamples),
+	sampleRate(44100.0), // better safe than sorry...
+	currentDelayTime(0),
+	oldDelayTime(0),
+	writeIndex(0),
+	fadeCounter(-1),
+	fadeLength(1024)
+{
+	targetDelayTime.set(0);
+	fadeTimeSamples.set(1024);
+}
+
+void DelayLine::setMaxDelayTimeSeconds(double newMaxDelayTime)
+{
+	maxDelayTime = newMaxDelayTime;
+}
+
+void DelayLine::prepareToPlay(double sampleRate_, int maxBlockSize)
+{
+	sampleRate = sampleRate_;
+
+	maxDelaySamples = maxDelayTime > 0.0 ? (int)std::ceil(maxDelayTime * sampleRate) : (int)DefaultMaxDelaySamples;
+
+	const int newBufferSize = nextPowerOfTwo(maxDelaySamples + jmax<int>(1, maxBlockSize));
+
+	if (newBufferSize != bufferSize)
+	{
+		delayBuffer.allocate(newBufferSize, true);
+		bufferSize = newBufferSize;
+		bufferMask = newBufferSize - 1;
+	}
+
+	reset();
+}
+
+void DelayLine::reset()
+{
+	if (delayBuffer != nullptr)
+		FloatVectorOperations::clear(delayBuffer, bufferSize);
+
+	writeIndex = 0;
+	fadeCounter = -1;
+	currentDelayTime = jmin<int>(targetDelayTime.get(), maxDelaySamples);
+	oldDelayTime = currentDelayTime;
+}
+
+void DelayLine::processBlock(float* data, int numSamples)
+{
+	if (delayBuffer == nullptr)
+	{
+		// You need to call prepareToPlay() first
+		jassertfalse;
+		return;
+	}
+
+	while (numSamples > 0)
+	{
+		if (fadeCounter < 0)
+			startFade();
+
+		const int readIndex = (writeIndex - currentDelayTime) & bufferMask;
+
+		// Split the block so that no read or write wraps around and that the
+		// samples we read are not overwritten by the samples we write.
+		int numThisTime = jmin<int>(numSamples, bufferSize - writeIndex, bufferSize - readIndex);
+
+		// This only splits blocks that are longer than the block size from prepareToPlay()
+		if (fadeCounter < 0)
+		{
+			numThisTime = jmin<int>(numThisTime, bufferSize - currentDelayTime);
+
+			FloatVectorOperations::copy(delayBuffer + writeIndex, data, numThisTime);
+			FloatVectorOperations::copy(data, delayBuffer + readIndex, numThisTime);
+		}
+		else
+		{
+			const int oldReadIndex = (writeIndex - oldDelayTime) & bufferMask;
+
+			numThisTime = jmin<int>(numThisTime, bufferSize - oldReadIndex, fadeLength - fadeCounter);
+			numThisTime = jmin<int>(numThisTime, bufferSize - jmax<int>(currentDelayTime, oldDelayTime));
+
+			FloatVectorOperations::copy(delayBuffer + writeIndex, data, numThisTime);
+
+			const float* newValues = delayBuffer + readIndex;
+			const float* oldValues = delayBuffer + oldReadIndex;
+
+			const float delta = 1.0f / (float)fadeLength;
+			const float startMix = (float)fadeCounter * delta;
+
+			for (int i = 0; i < numThisTime; i++)
+			{
+				const float mix = startMix + (float)i * delta;
+				data[i] = oldValues[i] + (newValues[i] - oldValues[i]) * mix;
+			}
+
+			fadeCounter += numThisTime;
+
+			if (fadeCounter >= fadeLength)
+				fadeCounter = -1;
+		}
+
+		writeIndex = (writeIndex + numThisTime) & bufferMask;
+		data += numThisTime;
+		numSamples -= numThisTime;
+	}
+}
+
+void DelayLine::startFade()
+{
+	const int newDelayTime = jmin<int>(targetDelayTime.get(), maxDelaySamples);
+
+	if (newDelayTime == currentDelayTime)
+		return;
+
+	oldDelayTime = currentDelayTime;
+	currentDelayTime = newDelayTime;
+
+	fadeLength = fadeTimeSamples.get();
+	fadeCounter = 0;
+}
+
+SharedOscillatorTables::SharedOscillatorTables()
+{
+	for (int i = 0; i < SineTableSize; i++)
+		sineTable[i] = (float)std::sin((double)i * 2.0 * double_Pi / (double)SineTableSize);
+
+	sineTable[SineTableSize] = sineTable[0];
+}
+
+double SharedOscillatorTables::renderSine(float* data, int numSamples, double uptime, double uptimeDelta, const float* pitchValues) const
+{
+	const float* table = sineTable;
+
+	if (pitchValues == nullptr)
+	{
+		// Without pitch modulation every position can be computed independently, so this loop is vectorised
+		for (int i = 0; i < numSamples; i++)
+		{
+			const double position = uptime + (double)i * uptimeDelta;
+			const int index = (int)position;
+			const float alpha = (float)(position - (double)index);
+			const int tableIndex = index & SineTableMask;
+
+			data[i] = table[tableIndex] + alpha * (table[tableIndex + 1] - table[tableIndex]);
+		}
+
+		uptime += (double)numSamples * uptimeDelta;
+	}
+	else
+	{
+		for (int i = 0; i < numSamples; i++)
+		{
+			const int index = (int)uptime;
+			const float alpha = (float)(uptime - (double)index);
+			const int tableIndex = index & SineTableMask;
+
+			data[i] = table[tableIndex] + alpha * (table[tableIndex + 1] - table[tableIndex]);
+
+			uptime += uptimeDelta * (double)pitchValues[i];
+		}
+	}
+
+	// Keep the uptime small so that it doesn't lose precision on long notes
+	return uptime - (double)SineTableSize * std::floor(uptime / (double)SineTableSize);
+}
+
+/** A linear phase half-band FIR filter with a Kaiser window.
+*
+*	With numSideTaps = K the filter has 4K - 1 taps. All coefficients with an even distance to the centre
+*	are zero, so one polyphase branch is a 2K tap FIR filter and the other one is a pure delay.
+*/
+class Oversampler::FirStage : public Oversampler::Stage
+{
+public:
+
+	FirStage(int numSideTaps_, double transitionBandwidth) :
+		numSideTaps(numSideTaps_),
+		historySize(2 * numSideTaps_ - 1)
+	{
+		// Transition bandwidth is relative to the higher sample rate around the half-band point
+		const double attenuation = jmin<double>(120.0, 14.36 * transitionBandwidth * 2.0 * (4 * numSideTaps - 2) + 7.95);
+		const double beta = attenuation > 50.0 ? 0.1102 * (attenuation - 8.7) : 0.5842 * pow(attenuation - 21.0, 0.4) + 0.07886 * (attenuation - 21.0);
+
+		const int numTaps = 4 * numSideTaps - 1;
+		const int centre = numTaps / 2;
+		const double i0Beta = besselI0(beta);
+
+		Array<double> branch;
+		double sum = 0.0;
+
+		for (int j = 0; j < 2 * numSideTaps; j++)
+		{
+			const int n = 2 * j;
+			const double x = (double)(n - centre);
+			const double r = x / (double)centre;
+
+			const double sinc = sin(double_Pi * x * 0.5) / (double_Pi * x);
+			const double window = besselI0(beta * sqrt(jmax<double>(0.0, 1.0 - r * r))) / i0Beta;
+
+			branch.add(sinc * window);
+			sum += sinc * window;
+		}
+
+		// The centre tap is 0.5, so the other branch must add up to 0.5 for unity gain at DC
+		for (int j = 0; j < branch.size(); j++)
+			coefficients.add((float)(branch[j] * 0.5 / sum));
+	}
+
+	void prepare(int numChannels, int maxNumSamples) override
+	{
+		upHistory.setSize(numChannels, historySize + maxNumSamples);
+		downEvenHistory.setSize(numChannels, historySize + maxNumSamples);
+		downOddHistory.setSize(numChannels, numSideTaps + maxNumSamples);
+		scratch.setSize(1, maxNumSamples);
+
+		reset();
+	}
+
+	void reset() override
+	{
+		upHistory.clear();
+		downEvenHistory.clear();
+		downOddHistory.clear();
+	}
+
+	void processUp(const float* input, float* output, int numSamples, int channel) override
+	{
+		float* x = upHistory.getWritePointer(channel);
+		float* even = scratch.getWritePointer(0);
+
+		FloatVectorOperations::copy(x + historySize, input, numSamples);
+
+		convolve(even, x, numSamples, 2.0f);
+
+		const float* delayed = x + historySize - (numSideTaps - 1);
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			output[2 * i] = even[i];
+			output[2 * i + 1] = delayed[i];
+		}
+
+		memmove(x, x + numSamples, sizeof(float) * historySize);
+	}
+
+	void processDown(const float* input, float* output, int numSamples, int channel) override
+	{
+		float* even = downEvenHistory.getWritePointer(channel);
+		float* odd = downOddHistory.getWritePointer(channel);
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			even[historySize + i] = input[2 * i];
+			odd[numSideTaps + i] = input[2 * i + 1];
+		}
+
+		convolve(output, even, numSamples, 1.0f);
+
+		FloatVectorOperations::addWithMultiply(output, odd, 0.5f, numSamples);
+
+		memmove(even, even + numSamples, sizeof(float) * historySize);
+		memmove(odd, odd + numSamples, sizeof(float) * numSideTaps);
+	}
+
+	float getLatency() const override
+	{
+		return (float)historySize;
+	}
+
+private:
+
+	/** Computes the non-zero branch for numSamples. The input starts with historySize samples of the last block. */
+	void convolve(float* output, const float* input, int numSamples, float gain) const
+	{
+		FloatVectorOperations::clear(output, numSamples);
+
+		for (int j = 0; j < coefficients.size(); j++)
+			FloatVectorOperations::addWithMultiply(output, input + historySize - j, gain * coefficients[j], numSamples);
+	}
+
+	static double besselI0(double x)
+	{
+		double sum = 1.0;
+		double term = 1.0;
+
+		for (int k = 1; k < 50; k++)
+		{
+			const double t = x / (2.0 * (double)k);
+			term *= t * t;
+			sum += term;
+
+			if (term < sum * 1e-12)
+				break;
+		}
+
+		return sum;
+	}
+
+	const int numSideTaps;
+	const int historySize;
+
+	Array<float> coefficients;
+
+	AudioSampleBuffer upHistory;
+	AudioSampleBuffer downEvenHistory;
+	AudioSampleBuffer downOddHistory;
+	AudioSampleBuffer scratch;
+};
+
+
+/** A minimum phase half-band IIR filter made of two parallel chains of allpass filters.
+*
+*	The coefficients are calculated for the given amount of allpass sections and transition bandwidth
+*	using the elliptic design from Valenzuela & Constantinides.
+*/
+class Oversampler::IirStage : public Oversampler::Stage
+{
+public:
+
+	IirStage(int numCoefficients, double transitionBandwidth) :
+		numChannels(0)
+	{
+		double k = tan((1.0 - transitionBandwidth * 2.0) * double_Pi / 4.0);
+		k *= k;
+
+		const double kkSqrt = pow(1.0 - k * k, 0.25);
+		const double e = 0.5 * (1.0 - kkSqrt) / (1.0 + kkSqrt);
+		const double e4 = e * e * e * e;
+		const double q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+
+		const int order = numCoefficients * 2 + 1;
+
+		for (int i = 0; i < numCoefficients; i++)
+		{
+			const int c = i + 1;
+
+			double num = 0.0;
+			double sign = 1.0;
+
+			for (int j = 0; j < 64; j++)
+			{
+				const double t = pow(q, (double)(j * (j + 1))) * sin((double)(j * 2 + 1) * c * double_Pi / (double)order) * sign;
+				num += t;
+				sign = -sign;
+
+				if (fabs(t) < 1e-100) break;
+			}
+
+			double den = 0.0;
+			sign = -1.0;
+
+			for (int j = 1; j < 64; j++)
+			{
+				const double t = pow(q, (double)(j * j)) * cos((double)(j * 2) * c * double_Pi / (double)order) * sign;
+				den += t;
+				sign = -sign;
+
+				if (fabs(t) < 1e-100) break;
+			}
+
+			const double ww = (num * pow(q, 0.25)) / (den + 0.5);
+			const double wwSquared = ww * ww;
+			const double x = sqrt((1.0 - wwSquared * k) * (1.0 - wwSquared / k)) / (1.0 + wwSquared);
+
+			coefficients.add((float)((1.0 - x) / (1.0 + x)));
+		}
+	}
+
+	void prepare(int numChannels_, int /*maxNumSamples*/) override
+	{
+		numChannels = numChannels_;
+
+		// x and y for each coefficient, one set for upsampling and one for downsampling
+		states.setSize(numChannels * 2, coefficients.size() * 2);
+
+		reset();
+	}
+
+	void reset() override
+	{
+		states.clear();
+	}
+
+	void processUp(const float* input, float* output, int numSamples, int channel) override
+	{
+		float* state = states.getWritePointer(channel);
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			float s0 = input[i];
+			float s1 = input[i];
+
+			processAllpassChains(s0, s1, state);
+
+			output[2 * i] = s0;
+			output[2 * i + 1] = s1;
+		}
+	}
+
+	void processDown(const float* input, float* output, int numSamples, int channel) override
+	{
+		float* state = states.getWritePointer(numChannels + channel);
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			float s0 = input[2 * i + 1];
+			float s1 = input[2 * i];
+
+			processAllpassChains(s0, s1, state);
+
+			output[i] = 0.5f * (s0 + s1);
+		}
+	}
+
+	float getLatency() const override
+	{
+		// Every allpass section delays low frequencies by (1 - a) / (1 + a) samples at the lower rate. The extra sample
+		// of the second chain adds half a sample when upsampling and the sample pairing of the downsampler removes it again.
+		double delay = 0.0;
+
+		for (int i = 0; i < coefficients.size(); i++)
+		{
+			const double a = (double)coefficients[i];
+			delay += (1.0 - a) / (1.0 + a);
+		}
+
+		return (float)delay;
+	}
+
+private:
+
+	/** Runs s0 through the even and s1 through the odd allpass sections. */
+	void processAllpassChains(float& s0, float& s1, float* state) const
+	{
+		float* x = state;
+		float* y = state + coefficients.size();
+
+		const int numCoefficients = coefficients.size();
+
+		int i = 0;
+
+		for (; i < numCoefficients - 1; i += 2)
+		{
+			const float t0 = (s0 - y[i]) * coefficients[i] + x[i];
+			const float t1 = (s1 - y[i + 1]) * coefficients[i + 1] + x[i + 1];
+
+			x[i] = s0;
+			x[i + 1] = s1;
+			y[i] = t0;
+			y[i + 1] = t1;
+			s0 = t0;
+			s1 = t1;
+		}
+
+		if (i < numCoefficients)
+		{
+			const float t0 = (s0 - y[i]) * coefficients[i] + x[i];
+
+			x[i] = s0;
+			y[i] = t0;
+			s0 = t0;
+		}
+	}
+
+	int numChannels;
+
+	Array<float> coefficients;
+
+	AudioSampleBuffer states;
+};
+
+
+Oversampler::Oversampler() :
+	factor(NoOversampling),
+	filterType(LinearPhase),
+	numChannels(0),
+	maxBlockSize(0)
+{
+
+}
+
+Oversampler::~Oversampler()
+{
+	stages.clear();
+}
+
+void Oversampler::setOversampling(Factor newFactor, FilterType newFilterType)
+{
+	if (newFactor == factor && newFilterType == filterType)
+		return;
+
+	factor = newFactor;
+	filterType = newFilterType;
+
+	stages.clear();
+
+	for (int i = 0; i < (int)factor; i++)
+		stages.add(createStage(i));
+
+	if (numChannels > 0 && maxBlockSize > 0)
+		prepareToPlay(numChannels, maxBlockSize);
+}
+
+void Oversampler::prepareToPlay(int numChannels_, int maxBlockSize_)
+{
+	numChannels = numChannels_;
+	maxBlockSize = maxBlockSize_;
+
+	for (int i = 0; i < numFactors; i++)
+	{
+		const int numSamples = i <= (int)factor ? (maxBlockSize << i) : 0;
+
+		buffers[i].setSize(numChannels, numSamples);
+		buffers[i].clear();
+	}
+
+	for (int i = 0; i < stages.size(); i++)
+		stages[i]->prepare(numChannels, maxBlockSize << i);
+}
+
+void Oversampler::reset()
+{
+	for (int i = 0; i < stages.size(); i++)
+		stages[i]->reset();
+}
+
+float Oversampler::getLatencyInSamples() const
+{
+	float latency = 0.0f;
+
+	for (int i = 0; i < stages.size(); i++)
+		latency += stages[i]->getLatency() / (float)(1 << i);
+
+	return latency;
+}
+
+AudioSampleBuffer& Oversampler::upsample(const AudioSampleBuffer& input, int startSample, int numSamples)
+{
+	jassert(numSamples <= maxBlockSize);
+	jassert(input.getNumChannels() >= numChannels);
+
+	if (factor == NoOversampling)
+	{
+		for (int c = 0; c < numChannels; c++)
+			buffers[0].copyFrom(c, 0, input, c, startSample, numSamples);
+
+		return buffers[0];
+	}
+
+	for (int c = 0; c < numChannels; c++)
+	{
+		const float* source = input.getReadPointer(c, startSample);
+
+		for (int i = 0; i < stages.size(); i++)
+		{
+			float* destination = buffers[i + 1].getWritePointer(c);
+
+			stages[i]->processUp(source, destination, numSamples << i, c);
+
+			source = destination;
+		}
+	}
+
+	return buffers[(int)factor];
+}
+
+void Oversampler::downsample(AudioSampleBuffer& output, int startSample, int numSamples)
+{
+	jassert(numSamples <= maxBlockSize);
+	jassert(output.getNumChannels() >= numChannels);
+
+	if (factor == NoOversampling)
+	{
+		for (int c = 0; c < numChannels; c++)
+			output.copyFrom(c, startSample, buffers[0], c, 0, numSamples);
+
+		return;
+	}
+
+	for (int c = 0; c < numChannels; c++)
+	{
+		for (int i = stages.size() - 1; i >= 0; i--)
+		{
+			const float* source = buffers[i + 1].getReadPointer(c);
+			float* destination = i == 0 ? output.getWritePointer(c, startSample) : buffers[i].getWritePointer(c);
+
+			stages[i]->processDown(source, destination, numSamples << i, c);
+		}
+	}
+}
+
+Oversampler::Stage* Oversampler::createStage(int index) const
+{
+	// The first stage needs the steepest filter, the later ones only have to remove the images above the original Nyquist frequency
+	static const int firSideTaps[numFactors - 1] = { 16, 6, 4 };
+	static const double firTransition[numFactors - 1] = { 0.05, 0.15, 0.2 };
+
+	static const int iirCoefficients[numFactors - 1] = { 10, 4, 3 };
+	static const double iirTransition[numFactors - 1] = { 0.05, 0.15, 0.2 };
+
+	jassert(index >= 0 && index < numFactors - 1);
+
+	if (filterType == LinearPhase)
+		return new FirStage(firSideTaps[index], firTransition[index]);
+	else
+		return new IirStage(iirCoefficients[index], iirTransition[index]);
+}
+
+
+// The envelopes never fall below this value to avoid denormals (same as in the chunkware classes)
+#define BLOCK_DYNAMICS_DC_OFFSET 1.0e-25f
+
+BlockDynamics::BlockDynamics(Mode mode_) :
+	mode(mode_),
+	sampleRate(44100.0),
+	thresholdDb(0.0f),
+	threshold(1.0f),
+	attackMs(mode_ == Compressor ? 10.0f : 1.0f),
+	releaseMs(mode_ == Limiter ? 10.0f : 100.0f),
+	ratio(1.0f),
+	attackCoefficient(0.0f),
+	releaseCoefficient(0.0f),
+	envelope(0.0f),
+	maxGainFactor(1.0f),
+	useLookahead(true),
+	peakHoldSamples(0),
+	peakTimer(0),
+	maxPeak(1.0f),
+	lookaheadMask(0),
+	lookaheadWriteIndex(0)
+{
+	updateCoefficients();
+	reset();
+}
+
+void BlockDynamics::prepareToPlay(double sampleRate_, int maxBlockSize)
+{
+	sampleRate = sampleRate_;
+
+	updateCoefficients();
+
+	scratchBuffer.setSize(2, maxBlockSize);
+
+	if (mode == Limiter)
+	{
+		// The peak hold time is limited to 4095 samples like the chunkware limiter
+		const int bufferSize = nextPowerOfTwo(4096 + maxBlockSize);
+
+		lookaheadBuffer.setSize(2, bufferSize);
+		lookaheadMask = bufferSize - 1;
+	}
+
+	reset();
+}
+
+void BlockDynamics::reset()
+{
+	switch (mode)
+	{
+	case Gate:
+	case Compressor:	envelope = BLOCK_DYNAMICS_DC_OFFSET; break;
+	case Limiter:		envelope = threshold; break;
+	case numModes:		break;
+	}
+
+	maxPeak = threshold;
+	peakTimer = 0;
+	lookaheadWriteIndex = 0;
+	maxGainFactor = 1.0f;
+
+	lookaheadBuffer.clear();
+}
+
+void BlockDynamics::setThreshold(float newThresholdDb)
+{
+	thresholdDb = newThresholdDb;
+	threshold = Decibels::decibelsToGain(newThresholdDb, -1000.0f);
+}
+
+void BlockDynamics::setAttack(float newAttackMs)
+{
+	attackMs = jmax<float>(0.01f, newAttackMs);
+	updateCoefficients();
+}
+
+void BlockDynamics::setRelease(float newReleaseMs)
+{
+	releaseMs = jmax<float>(0.01f, newReleaseMs);
+	updateCoefficients();
+}
+
+void BlockDynamics::setLookahead(bool shouldUseLookahead)
+{
+	if (useLookahead != shouldUseLookahead)
+	{
+		useLookahead = shouldUseLookahead;
+		lookaheadBuffer.clear();
+	}
+}
+
+void BlockDynamics::updateCoefficients()
+{
+	const double attackSamples = (double)attackMs * sampleRate;
+	const double releaseSamples = (double)releaseMs * sampleRate;
+
+	if (mode == Limiter)
+	{
+		// The limiter envelope reaches 99% within the time constant
+		attackCoefficient = (float)pow(0.01, 1000.0 / attackSamples);
+		releaseCoefficient = (float)pow(0.01, 1000.0 / releaseSamples);
+
+		peakHoldSamples = jlimit<int>(0, 4095, (int)(0.001 * attackSamples));
+	}
+	else
+	{
+		attackCoefficient = (float)exp(-1000.0 / attackSamples);
+		releaseCoefficient = (float)exp(-1000.0 / releaseSamples);
+	}
+}
+
+void BlockDynamics::process(float* l, float* r, int numSamples)
+{
+	jassert(numSamples <= scratchBuffer.getNumSamples());
+
+	switch (mode)
+	{
+	case Gate:			processGate(l, r, numSamples); break;
+	case Compressor:	processCompressor(l, r, numSamples); break;
+	case Limiter:		processLimiter(l, r, numSamples); break;
+	case numModes:		break;
+	}
+}
+
+void BlockDynamics::processGate(float* l, float* r, int numSamples)
+{
+	float* key = scratchBuffer.getWritePointer(0);
+	float* gain = scratchBuffer.getWritePointer(1);
+
+	FloatVectorOperations::abs(key, l, numSamples);
+	FloatVectorOperations::abs(gain, r, numSamples);
+	FloatVectorOperations::max(key, key, gain, numSamples);
+
+	const float thresh = threshold;
+
+	for (int i = 0; i < numSamples; i++)
+		key[i] = (key[i] > thresh ? 1.0f : 0.0f) + BLOCK_DYNAMICS_DC_OFFSET;
+
+	envelope = processEnvelope(key, gain, numSamples, envelope, attackCoefficient, releaseCoefficient);
+
+	FloatVectorOperations::add(gain, -BLOCK_DYNAMICS_DC_OFFSET, numSamples);
+
+	const Range<float> gainRange = FloatVectorOperations::findMinAndMax(gain, numSamples);
+
+	maxGainFactor = gainRange.getEnd();
+
+	// The gate is fully open
+	if (gainRange.getStart() == 1.0f)
+		return;
+
+	FloatVectorOperations::multiply(l, gain, numSamples);
+	FloatVectorOperations::multiply(r, gain, numSamples);
+}
+
+void BlockDynamics::processCompressor(float* l, float* r, int numSamples)
+{
+	float* key = scratchBuffer.getWritePointer(0);
+	float* gain = scratchBuffer.getWritePointer(1);
+
+	FloatVectorOperations::abs(key, l, numSamples);
+	FloatVectorOperations::abs(gain, r, numSamples);
+	FloatVectorOperations::max(key, key, gain, numSamples);
+	FloatVectorOperations::add(key, BLOCK_DYNAMICS_DC_OFFSET, numSamples);
+
+	FastDecibels::gainToDecibels(key, numSamples);
+
+	FloatVectorOperations::add(key, -thresholdDb, numSamples);
+	FloatVectorOperations::max(key, key, 0.0f, numSamples);
+	FloatVectorOperations::add(key, BLOCK_DYNAMICS_DC_OFFSET, numSamples);
+
+	envelope = processEnvelope(key, gain, numSamples, envelope, attackCoefficient, releaseCoefficient);
+
+	FloatVectorOperations::add(gain, -BLOCK_DYNAMICS_DC_OFFSET, numSamples);
+
+	const float maxOverDb = FloatVectorOperations::findMaximum(gain, numSamples);
+
+	// Nothing above the threshold in this block (less than 0.0001dB gain reduction)
+	if (maxOverDb * (1.0f - ratio) < 0.0001f)
+	{
+		maxGainFactor = 1.0f;
+		return;
+	}
+
+	FloatVectorOperations::multiply(gain, ratio - 1.0f, numSamples);
+
+	FastDecibels::decibelsToGain(gain, numSamples);
+
+	maxGainFactor = FloatVectorOperations::findMaximum(gain, numSamples);
+
+	FloatVectorOperations::multiply(l, gain, numSamples);
+	FloatVectorOperations::multiply(r, gain, numSamples);
+}
+
+void BlockDynamics::processLimiter(float* l, float* r, int numSamples)
+{
+	float* key = scratchBuffer.getWritePointer(0);
+	float* gain = scratchBuffer.getWritePointer(1);
+
+	FloatVectorOperations::abs(key, l, numSamples);
+	FloatVectorOperations::abs(gain, r, numSamples);
+	FloatVectorOperations::max(key, key, gain, numSamples);
+	FloatVectorOperations::max(key, key, threshold, numSamples);
+
+	float peak = maxPeak;
+
+	for (int i = 0; i < numSamples; i++)
+	{
+		// Hold the maximum peak for the lookahead time so the envelope can attack it before it arrives
+		const bool newPeak = (++peakTimer >= peakHoldSamples) | (key[i] > peak);
+
+		peakTimer = newPeak ? 0 : peakTimer;
+		peak = newPeak ? key[i] : peak;
+
+		key[i] = peak;
+	}
+
+	maxPeak = peak;
+
+	envelope = processEnvelope(key, gain, numSamples, envelope, attackCoefficient, releaseCoefficient);
+
+	const float maxEnvelope = FloatVectorOperations::findMaximum(gain, numSamples);
+
+	if (useLookahead)
+		applyLookahead(l, r, numSamples);
+
+	if (maxEnvelope <= threshold)
+	{
+		maxGainFactor = 1.0f;
+		return;
+	}
+
+	for (int i = 0; i < numSamples; i++)
+		gain[i] = threshold / gain[i];
+
+	maxGainFactor = FloatVectorOperations::findMaximum(gain, numSamples);
+
+	FloatVectorOperations::multiply(l, gain, numSamples);
+	FloatVectorOperations::multiply(r, gain, numSamples);
+}
+
+float BlockDynamics::processEnvelope(const float* input, float* output, int numSamples, float state, float attack, float release)
+{
+	// Shorter runs are cheaper to compute with the recursive filter
+	static const int minRunLength = 16;
+
+	int i = 0;
+
+	while (i < numSamples)
+	{
+		const float value = input[i];
+
+		int runEnd = i + 1;
+
+		while (runEnd < numSamples && input[runEnd] == value)
+			runEnd++;
+
+		if (runEnd - i >= minRunLength)
+		{
+			// The envelope approaches a constant input from one side, so the coefficient doesn't change within the run
+			const float c = value > state ? attack : release;
+
+			float powers[8];
+
+			powers[0] = c;
+
+			for (int j = 1; j < 8; j++)
+				powers[j] = powers[j - 1] * c;
+
+			float delta = state - value;
+
+			for (; i + 8 <= runEnd; i += 8)
+			{
+				for (int j = 0; j < 8; j++)
+					output[i + j] = value + powers[j] * delta;
+
+				delta *= powers[7];
+			}
+
+			for (int j = 0; i < runEnd; i++, j++)
+				output[i] = value + powers[j] * delta;
+
+			state = output[runEnd - 1];
+		}
+		else
+		{
+			// Calculate both directions so that the comparison isn't part of the dependency chain
+			const float attackInput = (1.0f - attack) * value;
+			const float releaseInput = (1.0f - release) * value;
+
+			for (; i < runEnd; i++)
+			{
+				const float attackState = attack * state + attackInput;
+				const float releaseState = release * state + releaseInput;
+
+				state = value > state ? attackState : releaseState;
+				output[i] = state;
+			}
+		}
+	}
+
+	return state;
+}
+
+void BlockDynamics::applyLookahead(float* l, float* r, int numSamples)
+{
+	const int bufferSize = lookaheadBuffer.getNumSamples();
+
+	jassert(numSamples + peakHoldSamples <= bufferSize);
+
+	const int readIndex = (lookaheadWriteIndex - peakHoldSamples) & lookaheadMask;
+
+	float* channels[2] = { l, r };
+
+	for (int c = 0; c < 2; c++)
+	{
+		float* data = lookaheadBuffer.getWritePointer(c);
+
+		const int numBeforeWrap = jmin<int>(numSamples, bufferSize - lookaheadWriteIndex);
+
+		FloatVectorOperations::copy(data + lookaheadWriteIndex, channels[c], numBeforeWrap);
+		FloatVectorOperations::copy(data, channels[c] + numBeforeWrap, numSamples - numBeforeWrap);
+
+		const int numBeforeReadWrap = jmin<int>(numSamples, bufferSize - readIndex);
+
+		FloatVectorOperations::copy(channels[c], data + readIndex, numBeforeReadWrap);
+		FloatVectorOperations::copy(channels[c] + numBeforeReadWrap, data, numSamples - numBeforeReadWrap);
+	}
+
+	lookaheadWriteIndex = (lookaheadWriteIndex + numSamples) & lookaheadMask;
+}
+
+#undef BLOCK_DYNAMICS_DC_OFFSET
+
+
+#if HI_RUN_UNIT_TESTS
+
+/** Compares the block processing of the DelayLine with a sample by sample reference while the delay time changes. */
+class DelayLineTest : public UnitTest
+{
+public:
+
+	DelayLineTest() :
+		UnitTest("Testing delay line")
+	{
+
+	}
+
+	void runTest() override
+	{
+		beginTest("Block processing matches the reference");
+
+		Random r(42);
+
+		DelayLine d;
+		d.setMaxDelayTimeSeconds(0.1);
+		d.setFadeTimeSamples(300);
+		d.prepareToPlay(44100.0, 512);
+
+		const int maxDelay = d.getMaxDelaySamples();
+
+		HeapBlock<float> reference;
+		reference.calloc(maxDelay + 1);
+
+		int writeIndex = 0;
+		int currentDelay = 0;
+		int oldDelay = 0;
+		int target = 0;
+		int fadeCounter = -1;
+
+		float block[1024];
+		float maxError = 0.0f;
+
+		for (int i = 0; i < 400; i++)
+		{
+			// Include delay times that are longer than the block size and the maximum
+			if (r.nextInt(3) == 0)
+			{
+				target = r.nextInt(maxDelay + 500);
+				d.setDelayTimeSamples(target);
+			}
+
+			const int numSamples = 1 + r.nextInt(1024);
+
+			for (int j = 0; j < numSamples; j++)
+				block[j] = r.nextFloat() * 2.0f - 1.0f;
+
+			float expected[1024];
+
+			for (int j = 0; j < numSamples; j++)
+			{
+				if (fadeCounter < 0 && jmin<int>(target, maxDelay) != currentDelay)
+				{
+					oldDelay = currentDelay;
+					currentDelay = jmin<int>(target, maxDelay);
+					fadeCounter = 0;
+				}
+
+				reference[writeIndex] = block[j];
+
+				const float newValue = reference[(writeIndex - currentDelay + maxDelay + 1) % (maxDelay + 1)];
+				const float oldValue = reference[(writeIndex - oldDelay + maxDelay + 1) % (maxDelay + 1)];
+
+				if (fadeCounter < 0)
+				{
+					expected[j] = newValue;
+				}
+				else
+				{
+					const float mix = (float)fadeCounter / 300.0f;
+					expected[j] = newValue * mix + oldValue * (1.0f - mix);
+
+					if (++fadeCounter >= 300)
+						fadeCounter = -1;
+				}
+
+				writeIndex = (writeIndex + 1) % (maxDelay + 1);
+			}
+
+			d.processBlock(block, numSamples);
+
+			for (int j = 0; j < numSamples; j++)
+				maxError = jmax<float>(maxError, std::abs(block[j] - expected[j]));
+		}
+
+		expect(maxError < 1e-5f, "Max error: " + String(maxError));
+	}
+};
+
+static DelayLineTest delayLineTest;
+
+/** Measures the passband gain, the aliasing rejection, the latency and the CPU usage of every oversampling configuration. */
+class OversamplerTest : public UnitTest
+{
+public:
+
+	OversamplerTest() :
+		UnitTest("Testing oversampler")
+	{
+
+	}
+
+	void runTest() override
+	{
+		for (int type = 0; type < Oversampler::numFilterTypes; type++)
+		{
+			for (int factor = Oversampler::TwoTimes; factor < Oversampler::numFactors; factor++)
+			{
+				Oversampler o;
+
+				o.setOversampling((Oversampler::Factor)factor, (Oversampler::FilterType)type);
+				o.prepareToPlay(2, blockSize);
+
+				beginTest(String(type == Oversampler::LinearPhase ? "Linear phase " : "Minimum phase ") + String(o.getOversamplingFactor()) + "x");
+
+				testPassband(o);
+				testAliasing(o);
+				measureCpuUsage(o);
+			}
+		}
+	}
+
+private:
+
+	void testPassband(Oversampler& o)
+	{
+		AudioSampleBuffer b(2, blockSize * numBlocks);
+
+		// Use a low frequency with a whole number of cycles in the measured half so the phase doesn't wrap around
+		const int offset = b.getNumSamples() / 2;
+		const double frequency = 37.0 * sampleRate / (double)offset;
+
+		for (int i = 0; i < b.getNumSamples(); i++)
+		{
+			b.setSample(0, i, (float)sin(2.0 * double_Pi * frequency / sampleRate * (double)i));
+			b.setSample(1, i, 0.0f);
+		}
+
+		o.reset();
+
+		for (int i = 0; i < numBlocks; i++)
+		{
+			o.upsample(b, i * blockSize, blockSize);
+			o.downsample(b, i * blockSize, blockSize);
+		}
+
+		// Correlate the last half with a sine and a cosine to get the gain and the phase delay
+		double re = 0.0;
+		double im = 0.0;
+
+		for (int i = offset; i < b.getNumSamples(); i++)
+		{
+			const double phase = 2.0 * double_Pi * frequency / sampleRate * (double)i;
+
+			im += b.getSample(0, i) * sin(phase);
+			re += b.getSample(0, i) * cos(phase);
+		}
+
+		const double gain = 2.0 * sqrt(re * re + im * im) / (double)offset;
+		const double delay = atan2(-re, im) / (2.0 * double_Pi * frequency / sampleRate);
+
+		expectWithinAbsoluteError<double>(Decibels::gainToDecibels(gain), 0.0, 0.05, "Passband gain");
+		expectWithinAbsoluteError<double>(delay, (double)o.getLatencyInSamples(), 0.5, "Reported latency");
+	}
+
+	void testAliasing(Oversampler& o)
+	{
+		const int factor = o.getOversamplingFactor();
+		const double oversampledRate = sampleRate * (double)factor;
+
+		AudioSampleBuffer b(2, blockSize * numBlocks);
+
+		b.clear();
+
+		// A sine wave in the oversampled signal between the original and the oversampled Nyquist frequency must be removed
+		for (double frequency = 30000.0; frequency < oversampledRate * 0.5; frequency *= 2.0)
+		{
+			o.reset();
+
+			for (int i = 0; i < numBlocks; i++)
+			{
+				AudioSampleBuffer& os = o.upsample(b, i * blockSize, blockSize);
+
+				for (int j = 0; j < blockSize * factor; j++)
+				{
+					const float value = (float)sin(2.0 * double_Pi * frequency / oversampledRate * (double)(i * blockSize * factor + j));
+
+					os.setSample(0, j, value);
+					os.setSample(1, j, value);
+				}
+
+				o.downsample(b, i * blockSize, blockSize);
+			}
+
+			const int offset = b.getNumSamples() / 2;
+			const float rejection = Decibels::gainToDecibels(b.getRMSLevel(0, offset, offset) * (float)sqrt(2.0), -200.0f);
+
+			logMessage("Aliasing at " + String(frequency / 1000.0, 1) + "kHz: " + String(rejection, 1) + "dB");
+
+			expect(rejection < -90.0f, "Aliasing rejection at " + String(frequency) + "Hz: " + String(rejection) + "dB");
+		}
+	}
+
+	void measureCpuUsage(Oversampler& o)
+	{
+		AudioSampleBuffer b(2, blockSize);
+
+		for (int i = 0; i < blockSize; i++)
+		{
+			b.setSample(0, i, r.nextFloat());
+			b.setSample(1, i, r.nextFloat());
+		}
+
+		const int numBenchmarkBlocks = (int)(10.0 * sampleRate) / blockSize;
+
+		const double start = Time::getMillisecondCounterHiRes();
+
+		for (int i = 0; i < numBenchmarkBlocks; i++)
+		{
+			o.upsample(b, 0, blockSize);
+			o.downsample(b, 0, blockSize);
+		}
+
+		const double usage = (Time::getMillisecondCounterHiRes() - start) / 100.0;
+
+		logMessage("CPU usage (stereo, 44.1kHz): " + String(usage, 3) + "%, latency: " + String(o.getLatencyInSamples(), 2) + " samples");
+	}
+
+	static const int blockSize = 512;
+	static const int numBlocks = 64;
+
+	const double sampleRate = 44100.0;
+
+	Random r;
+};
+
+static OversamplerTest oversamplerTest;
+
+/** Renders a chain that is prepared once for the maximum block size with random smaller blocks (like hosts that split 
+*	their blocks at automation points) and checks that the output matches a render with full blocks and that no buffer 
+*	is reallocated.
+*/
+class VariableBlockSizeTest : public UnitTest
+{
+public:
+
+	VariableBlockSizeTest() :
+		UnitTest("Testing variable block sizes")
+	{
+
+	}
+
+	void runTest() override
+	{
+		AudioSampleBuffer input(2, maxBlockSize * numBlocks);
+
+		Random r(42);
+
+		for (int i = 0; i < input.getNumSamples(); i++)
+		{
+			input.setSample(0, i, r.nextFloat() * 2.0f - 1.0f);
+			input.setSample(1, i, (float)sin(2.0 * double_Pi * 440.0 / 44100.0 * (double)i));
+		}
+
+		for (int type = 0; type < Oversampler::numFilterTypes; type++)
+		{
+			beginTest(type == Oversampler::LinearPhase ? "Linear phase" : "Minimum phase");
+
+			AudioSampleBuffer expected(input);
+			AudioSampleBuffer actual(input);
+
+			Chain reference((Oversampler::FilterType)type);
+			Chain chain((Oversampler::FilterType)type);
+
+			for (int i = 0; i < numBlocks; i++)
+				reference.process(expected, i * maxBlockSize, maxBlockSize);
+
+			const float* oversampledData = chain.process(actual, 0, maxBlockSize);
+
+			int numBlocksWithOtherBuffer = 0;
+
+			for (int i = maxBlockSize; i < actual.getNumSamples();)
+			{
+				const int numSamples = jmin<int>(1 + r.nextInt(maxBlockSize), actual.getNumSamples() - i);
+
+				if (chain.process(actual, i, numSamples) != oversampledData)
+					numBlocksWithOtherBuffer++;
+
+				i += numSamples;
+			}
+
+			expectEquals(numBlocksWithOtherBuffer, 0, "Reallocated blocks");
+
+			float maxError = 0.0f;
+
+			for (int c = 0; c < 2; c++)
+			{
+				for (int i = 0; i < actual.getNumSamples(); i++)
+					maxError = jmax<float>(maxError, std::abs(actual.getSample(c, i) - expected.getSample(c, i)));
+			}
+
+			expect(maxError < 1e-5f, "Max error: " + String(maxError));
+		}
+	}
+
+private:
+
+	/** A saturator with 4x oversampling followed by a delay that is longer than a block. */
+	struct Chain
+	{
+		Chain(Oversampler::FilterType filterType)
+		{
+			oversampler.setOversampling(Oversampler::FourTimes, filterType);
+			oversampler.prepareToPlay(2, maxBlockSize);
+
+			for (int c = 0; c < 2; c++)
+			{
+				delays[c].setMaxDelayTimeSeconds(0.1);
+				delays[c].prepareToPlay(44100.0, maxBlockSize);
+				delays[c].setDelayTimeSamples(1000);
+			}
+		}
+
+		/** Processes the region and returns the oversampled buffer, which must never be reallocated. */
+		const float* process(AudioSampleBuffer& b, int startSample, int numSamples)
+		{
+			AudioSampleBuffer& os = oversampler.upsample(b, startSample, numSamples);
+
+			for (int c = 0; c < 2; c++)
+			{
+				float* data = os.getWritePointer(c);
+
+				for (int i = 0; i < numSamples * 4; i++)
+					data[i] = tanhf(2.0f * data[i]);
+			}
+
+			oversampler.downsample(b, startSample, numSamples);
+
+			for (int c = 0; c < 2; c++)
+				delays[c].processBlock(b.getWritePointer(c, startSample), numSamples);
+
+			return os.getReadPointer(0);
+		}
+
+		Oversampler oversampler;
+		DelayLine delays[2];
+	};
+
+	static const int maxBlockSize = 512;
+	static const int numBlocks = 128;
+};
+
+static VariableBlockSizeTest variableBlockSizeTest;
+
+#endif
@@ -13,136 +13,408 @@
 
 
 
-#define DELAY_BUFFER_SIZE 65536
-#define DELAY_BUFFER_MASK 65536-1
-
+/** A delay line with a smooth crossfade when the delay time changes.
+*
+*	The buffer is allocated in prepareToPlay() and is sized to the maximum delay time, so use
+*	setMaxDelayTimeSeconds() if you don't need the default of DefaultMaxDelaySamples.
+*
+*	The delay time can be changed from any thread. The audio thread picks up the new value at the start of
+*	the next processBlock() call (or when the running crossfade is finished) and fades from the old to the new
+*	read position over the fade time.
+*/
 class DelayLine
 {
 public:
 
-	DelayLine() :
-		readIndex(0),
-		oldReadIndex(0),
-		writeIndex(0),
-		lastIgnoredDelayTime(-1),
-		sampleRate(44100.0), // better safe than sorry...
-		currentDelayTime(0),
-		fadeCounter(-1),
-		fadeTimeSamples(1024)
-	{
-		FloatVectorOperations::clear(delayBuffer, DELAY_BUFFER_SIZE);
-	}
-
-	void prepareToPlay(double sampleRate_)
+	enum
 	{
-		SpinLock::ScopedLockType sl(processLock);
+		DefaultMaxDelaySamples = 65535
+	};
 
-		sampleRate = sampleRate_;
-	}
+	DelayLine();
+
+	/** Sets the maximum delay time. This will be applied (and the buffer resized) at the next prepareToPlay() call. */
+	void setMaxDelayTimeSeconds(double newMaxDelayTime);
+
+	/** Allocates the buffer for the maximum delay time at the given samplerate. 
+	*
+	*	The buffer holds the maximum delay plus one block, so blocks up to maxBlockSize are processed in one go.
+	*/
+	void prepareToPlay(double sampleRate_, int maxBlockSize);
+
+	/** Clears the buffer and jumps to the target delay time. */
+	void reset();
 
 	void setDelayTimeSeconds(double delayInSeconds)
 	{
 		setDelayTimeSamples((int)(delayInSeconds * sampleRate));
 	}
 
+	/** Sets the delay time in samples. It will be limited to the maximum delay time. */
 	void setDelayTimeSamples(int delayInSamples)
 	{
-		SpinLock::ScopedLockType sl(processLock);
-
-		setInternalDelayTime(delayInSamples);
+		targetDelayTime.set(jmax<int>(0, delayInSamples));
 	}
 
 	void setFadeTimeSamples(int newFadeTimeInSamples)
 	{
-		SpinLock::ScopedLockType sl(processLock);
-
-		fadeTimeSamples = newFadeTimeInSamples;
+		fadeTimeSamples.set(jmax<int>(1, newFadeTimeInSamples));
 	}
 
+	int getMaxDelaySamples() const { return maxDelaySamples; }
+
+	/** Replaces the data with the delayed signal. */
+	void processBlock(float* data, int numSamples);
+
+	/** Convenience function for a single sample. Use processBlock() whenever you can. */
 	float getDelayedValue(float inputValue)
 	{
-		SpinLock::ScopedLockType sl(processLock);
+		processBlock(&inputValue, 1);
+		return inputValue;
+	}
+
+private:
+
+	void startFade();
+
+	HeapBlock<float> delayBuffer;
+	int bufferSize;
+	int bufferMask;
+
+	double maxDelayTime;
+	int maxDelaySamples;
+	double sampleRate;
+
+	Atomic<int> targetDelayTime;
+	Atomic<int> fadeTimeSamples;
+
+	int currentDelayTime;
+	int oldDelayTime;
+
+	int writeIndex;
+	int fadeCounter;
+	int fadeLength;
+
+	JUCE_DECLARE_NON_COPYABLE(DelayLine);
+};
+
+
+
+/** Read-only oscillator tables that are shared by all voices in the process.
+*
+*	Every voice should access them through a SharedResourcePointer so that there is only one copy in the cache:
+*
+*	@code
+*	SharedResourcePointer<SharedOscillatorTables> tables;
+*	@endcode
+*/
+class SharedOscillatorTables
+{
+public:
+
+	enum
+	{
+		SineTableSize = 2048,
+		SineTableMask = SineTableSize - 1
+	};
+
+	SharedOscillatorTables();
+
+	/** Returns one cycle of a sine wave with SineTableSize samples plus a guard sample at the end. */
+	const float* getSineTable() const { return sineTable; }
+
+	/** Renders a linear interpolated sine wave and returns the new uptime.
+	*
+	*	@param uptime the phase in table samples (SineTableSize per cycle). The returned uptime is wrapped to one cycle.
+	*	@param pitchValues if not nullptr, the uptimeDelta is multiplied with these values for each sample.
+	*/
+	double renderSine(float* data, int numSamples, double uptime, double uptimeDelta, const float* pitchValues = nullptr) const;
+
+private:
+
+	float sineTable[SineTableSize + 1];
+
+	JUCE_DECLARE_NON_COPYABLE(SharedOscillatorTables);
+};
+
+
+
+/** A polyphase oversampling stage that nonlinear effects can wrap around their inner loop.
+*
+*	It cascades up to three half-band stages (2x, 4x and 8x). Each stage is either a linear phase FIR filter
+*	(where every second coefficient is zero) or a minimum phase IIR filter (two parallel allpass chains).
+*	Both are implemented as polyphase structures so every filter runs at the lower of its two sample rates.
+*	The FIR kernels are computed with FloatVectorOperations and are therefore vectorised.
+*
+*	All memory is allocated in setOversampling() and prepareToPlay(), so the processing is allocation free:
+*
+*	@code
+*	AudioSampleBuffer& oversampledBuffer = oversampler.upsample(buffer, startSample, numSamples);
+*
+*	// process numSamples * oversampler.getOversamplingFactor() samples...
+*
+*	oversampler.downsample(buffer, startSample, numSamples);
+*	@endcode
+*/
+class Oversampler
+{
+public:
+
+	enum Factor
+	{
+		NoOversampling = 0,
+		TwoTimes,
+		FourTimes,
+		EightTimes,
+		numFactors
+	};
+
+	enum FilterType
+	{
+		LinearPhase = 0,
+		MinimumPhase,
+		numFilterTypes
+	};
+
+	Oversampler();
+
+	~Oversampler();
+
+	/** Changes the factor and the filter type. This reallocates the filter stages, so make sure it isn't called during processing. */
+	void setOversampling(Factor newFactor, FilterType newFilterType);
+
+	/** Allocates the buffers for the given channel amount and block size and clears the filter states. */
+	void prepareToPlay(int numChannels, int maxBlockSize);
+
+	/** Clears the filter states. */
+	void reset();
+
+	Factor getFactor() const { return factor; }
+
+	FilterType getFilterType() const { return filterType; }
+
+	/** Returns the ratio between the oversampled and the original sample rate (1, 2, 4 or 8). */
+	int getOversamplingFactor() const { return 1 << (int)factor; }
+
+	/** Returns the delay of an up- and downsampling round trip in samples at the original sample rate.
+	*
+	*	For the minimum phase filters this is the group delay at low frequencies.
+	*/
+	float getLatencyInSamples() const;
+
+	/** Upsamples the given region into the internal buffer and returns it.
+	*
+	*	The buffer might be bigger than needed, only the first numSamples * getOversamplingFactor() samples are valid.
+	*/
+	AudioSampleBuffer& upsample(const AudioSampleBuffer& input, int startSample, int numSamples);
+
+	/** Filters the internal buffer back to the original sample rate and writes it into the given region. */
+	void downsample(AudioSampleBuffer& output, int startSample, int numSamples);
+
+private:
+
+	class Stage
+	{
+	public:
+
+		virtual ~Stage() {};
 
-		delayBuffer[writeIndex++] = inputValue;
+		virtual void prepare(int numChannels, int maxNumSamples) = 0;
 
-		if (fadeCounter < 0)
-		{
-			const float returnValue = delayBuffer[readIndex++];
+		virtual void reset() = 0;
 
-			readIndex &= DELAY_BUFFER_MASK;
-			writeIndex &= DELAY_BUFFER_MASK;
-			return returnValue;
-		}
-		else
-		{
-			const float oldValue = delayBuffer[oldReadIndex++];
-			const float newValue = delayBuffer[readIndex++];
+		/** Writes numSamples * 2 samples into output. */
+		virtual void processUp(const float* input, float* output, int numSamples, int channel) = 0;
 
-			const float mix = (float)fadeCounter / (float)fadeTimeSamples;
+		/** Reads numSamples * 2 samples from input. */
+		virtual void processDown(const float* input, float* output, int numSamples, int channel) = 0;
 
-			const float returnValue = newValue * mix + oldValue * (1.0f - mix);
+		/** Returns the round trip delay in samples at the lower sample rate. */
+		virtual float getLatency() const = 0;
+	};
 
-			oldReadIndex &= DELAY_BUFFER_MASK;
-			readIndex &= DELAY_BUFFER_MASK;
-			writeIndex &= DELAY_BUFFER_MASK;
+	class FirStage;
+	class IirStage;
 
-			fadeCounter++;
+	Stage* createStage(int index) const;
 
-			if (fadeCounter >= fadeTimeSamples)
-			{
-				fadeCounter = -1;
-				if (lastIgnoredDelayTime != 0)
-				{
-					setInternalDelayTime(lastIgnoredDelayTime);
-				}
-			}
+	Factor factor;
+	FilterType filterType;
 
-			return returnValue;
-		}
+	int numChannels;
+	int maxBlockSize;
+
+	OwnedArray<Stage> stages;
+
+	AudioSampleBuffer buffers[numFactors];
+
+	JUCE_DECLARE_NON_COPYABLE(Oversampler);
+};
+
+
+/** Fast approximations of the decibel conversions for gain computers.
+*
+*	They split the float into exponent and mantissa and use a polynomial for the fractional part.
+*	The error is below 0.0001dB for gainToDecibels() and below 0.00003dB for decibelsToGain().
+*	The array versions contain no branches, so the compiler can vectorise them.
+*/
+struct FastDecibels
+{
+	static inline float gainToDecibels(float gain)
+	{
+		return 6.0205999f * log2(gain);
+	}
+
+	static inline float decibelsToGain(float dB)
+	{
+		return exp2(jmax<float>(-126.0f, jmin<float>(126.0f, dB * 0.1660964f)));
+	}
+
+	static void gainToDecibels(float* data, int numSamples)
+	{
+		for (int i = 0; i < numSamples; i++)
+			data[i] = 6.0205999f * log2(data[i]);
+	}
+
+	static void decibelsToGain(float* data, int numSamples)
+	{
+		// Clamping inside the loop would prevent the vectorisation
+		FloatVectorOperations::multiply(data, 0.1660964f, numSamples);
+		FloatVectorOperations::clip(data, data, -126.0f, 126.0f, numSamples);
+
+		for (int i = 0; i < numSamples; i++)
+			data[i] = exp2(data[i]);
 	}
 
 private:
 
-	void setInternalDelayTime(int delayInSamples)
+	static inline float log2(float x)
 	{
-		delayInSamples = jmin<int>(delayInSamples, DELAY_BUFFER_SIZE - 1);
+		union { float f; uint32 i; } v;
+		v.f = x;
+
+		const float exponent = (float)((int)((v.i >> 23) & 0xff) - 127);
 
-		if (fadeCounter != -1)
-		{
-			lastIgnoredDelayTime = delayInSamples;
-			return;
-		}
-		else
-		{
-			lastIgnoredDelayTime = 0;
-		}
+		v.i = (v.i & 0x007fffff) | 0x3f800000;
 
-		currentDelayTime = delayInSamples;
+		const float t = v.f - 1.0f;
 
-		oldReadIndex = readIndex;
+		return exponent + t * (1.4418798f + t * (-0.7088643f + t * (0.4152425f + t * (-0.1935124f + t * 0.0452664f))));
+	}
+
+	/** x must be within -126 and 126. */
+	static inline float exp2(float x)
+	{
+		const int floored = (int)x - (int)(x < 0.0f);
+		const float t = x - (float)floored;
 
-		fadeCounter = 0;
+		union { float f; uint32 i; } v;
+		v.i = (uint32)(floored + 127) << 23;
 
-		readIndex = (writeIndex - delayInSamples) & DELAY_BUFFER_MASK;
+		return v.f * (1.0f + t * (0.6930440f + t * (0.2412828f + t * (0.0522406f + t * 0.0134267f))));
 	}
+};
 
-	SpinLock processLock;
 
-	double maxDelayTime;
-	int currentDelayTime;
+/** A block based gate, compressor or limiter with the same curves as the chunkware dynamics classes.
+*
+*	Instead of processing a stereo pair at a time in double precision, a block is processed in a few passes:
+*	the peak detection and the gain computer are vectorised (using FloatVectorOperations and FastDecibels)
+*	and only the attack / release envelope runs sample by sample. Blocks where the envelope stays at unity
+*	gain skip the gain stage completely.
+*
+*	The gain matches the chunkware implementation within 0.01dB.
+*/
+class BlockDynamics
+{
+public:
+
+	enum Mode
+	{
+		Gate = 0,
+		Compressor,
+		Limiter,
+		numModes
+	};
+
+	BlockDynamics(Mode mode_);
+
+	/** Allocates the scratch buffers and the lookahead buffer and clears the state. */
+	void prepareToPlay(double sampleRate, int maxBlockSize);
+
+	/** Clears the envelope and the lookahead buffer. */
+	void reset();
+
+	void setThreshold(float newThresholdDb);
+	void setAttack(float newAttackMs);
+	void setRelease(float newReleaseMs);
+
+	/** Sets the slope of the compressor. 1.0 is no compression, 0.25 is a 4:1 ratio. */
+	void setRatio(float newRatio) { ratio = newRatio; };
+
+	/** Enables the lookahead delay of the limiter. If disabled, the limiter has no latency but lets the attack phase through. */
+	void setLookahead(bool shouldUseLookahead);
+
+	float getThreshold() const { return thresholdDb; }
+	float getAttack() const { return attackMs; }
+	float getRelease() const { return releaseMs; }
+	float getRatio() const { return ratio; }
+	bool isUsingLookahead() const { return useLookahead; }
+
+	/** Returns the delay of the limiter lookahead in samples. */
+	int getLatencySamples() const { return (mode == Limiter && useLookahead) ? peakHoldSamples : 0; }
+
+	/** Returns the highest gain factor of the last block. */
+	float getMaxGainFactor() const { return maxGainFactor; }
+
+	/** Applies the dynamics to both channels. numSamples must not exceed the block size passed into prepareToPlay(). */
+	void process(float* l, float* r, int numSamples);
+
+private:
+
+	void processGate(float* l, float* r, int numSamples);
+	void processCompressor(float* l, float* r, int numSamples);
+	void processLimiter(float* l, float* r, int numSamples);
+
+	void updateCoefficients();
+
+	/** Runs the attack / release envelope over the input and returns the last value.
+	*
+	*	Runs of equal input values (a closed gate, a signal below the compressor threshold or a held limiter peak)
+	*	are calculated in closed form, so only the samples where the input changes need the recursive filter.
+	*/
+	static float processEnvelope(const float* input, float* output, int numSamples, float state, float attack, float release);
+
+	void applyLookahead(float* l, float* r, int numSamples);
+
+	const Mode mode;
+
 	double sampleRate;
 
-	int lastIgnoredDelayTime;
+	float thresholdDb;
+	float threshold;
+	float attackMs;
+	float releaseMs;
+	float ratio;
 
-	float delayBuffer[DELAY_BUFFER_SIZE];
+	float attackCoefficient;
+	float releaseCoefficient;
 
-	int readIndex;
-	int oldReadIndex;
-	int writeIndex;
+	float envelope;
+	float maxGainFactor;
 
-	int fadeCounter;
+	bool useLookahead;
+	int peakHoldSamples;
+	int peakTimer;
+	float maxPeak;
+
+	AudioSampleBuffer scratchBuffer;
+
+	AudioSampleBuffer lookaheadBuffer;
+	int lookaheadMask;
+	int lookaheadWriteIndex;
 
-	int fadeTimeSamples;
+	JUCE_DECLARE_NON_COPYABLE(BlockDynamics);
 };
 
 
@@ -337,7 +337,7 @@ public:
 
 			float *samples[2] = { leftChannel, rightChannel };
 
-			const int samplesToUse = getBlockSize();
+			const int samplesToUse = buffer.getNumSamples();
 
 			AudioSampleBuffer stereoBuffer(samples, 2, buffer.getNumSamples());
 
@@ -137,29 +137,42 @@ void EffectProcessorChain::EffectChainHandler::add(Processor *newProcessor, Proc
 	
 
 	{
-		MainController::ScopedSuspender ss(chain->getMainController(), MainController::ScopedSuspender::LockType::Lock);
-
 		newProcessor->setIsOnAir(true);
 
-		if (VoiceEffectProcessor* vep = dynamic_cast<VoiceEffectProcessor*>(newProcessor))
-		{
-			const int index = chain->voiceEffects.indexOf(dynamic_cast<VoiceEffectProcessor*>(siblingToInsertBefore));
-			chain->voiceEffects.insert(index, vep);
-		}
-		else if (MasterEffectProcessor* mep = dynamic_cast<MasterEffectProcessor*>(newProcessor))
-		{
-			const int index = chain->masterEffects.indexOf(dynamic_cast<MasterEffectProcessor*>(siblingToInsertBefore));
-			chain->masterEffects.insert(index, mep);
-		}
-		else if (MonophonicEffectProcessor* moep = dynamic_cast<MonophonicEffectProcessor*>(newProcessor))
-		{
-			const int index = chain->monoEffects.indexOf(dynamic_cast<MonophonicEffectProcessor*>(siblingToInsertBefore));
-			chain->monoEffects.insert(index, moep);
+		VoiceEffectProcessor* vep = dynamic_cast<VoiceEffectProcessor*>(newProcessor);
+		MasterEffectProcessor* mep = dynamic_cast<MasterEffectProcessor*>(newProcessor);
+		MonophonicEffectProcessor* moep = dynamic_cast<MonophonicEffectProcessor*>(newProcessor);
+		EffectProcessor* ep = dynamic_cast<EffectProcessor*>(newProcessor);
+
+		jassert(vep != nullptr || mep != nullptr || moep != nullptr);
 
+		MainController::GraphEditQueue& queue = chain->getMainController()->getGraphEditQueue();
+
+		{
+			MainController::GraphEditQueue::ScopedEditLock sl(queue);
+
+			// Build the new arrays here so that the audio thread only has to swap them
+			MainController::GraphEditQueue::ArrayCopy<OwnedArray<VoiceEffectProcessor>> newVoiceEffects(chain->voiceEffects);
+			MainController::GraphEditQueue::ArrayCopy<OwnedArray<MasterEffectProcessor>> newMasterEffects(chain->masterEffects);
+			MainController::GraphEditQueue::ArrayCopy<OwnedArray<MonophonicEffectProcessor>> newMonoEffects(chain->monoEffects);
+			MainController::GraphEditQueue::ArrayCopy<Array<EffectProcessor*>> newAllEffects(chain->allEffects);
+
+			if (vep != nullptr)			newVoiceEffects->insert(chain->voiceEffects.indexOf(dynamic_cast<VoiceEffectProcessor*>(siblingToInsertBefore)), vep);
+			else if (mep != nullptr)	newMasterEffects->insert(chain->masterEffects.indexOf(dynamic_cast<MasterEffectProcessor*>(siblingToInsertBefore)), mep);
+			else if (moep != nullptr)	newMonoEffects->insert(chain->monoEffects.indexOf(dynamic_cast<MonophonicEffectProcessor*>(siblingToInsertBefore)), moep);
+
+			newAllEffects->add(ep);
+
+			queue.performEdit([&]()
+			{
+				newVoiceEffects.swapWithOriginal();
+				newMasterEffects.swapWithOriginal();
+				newMonoEffects.swapWithOriginal();
+				newAllEffects.swapWithOriginal();
+			});
 		}
-		else jassertfalse;
 
-		chain->allEffects.add(dynamic_cast<EffectProcessor*>(newProcessor));
+		chain->getMainController()->getProcessorRegistry().markDirty();
 
 		jassert(chain->allEffects.size() == (chain->masterEffects.size() + chain->voiceEffects.size() + chain->monoEffects.size()));
 	}
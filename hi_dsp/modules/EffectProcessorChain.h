@@ -211,19 +211,50 @@ public:
 
 		void remove(Processor *processorToBeRemoved) override
 		{
-			ScopedLock sl(chain->getMainController()->getLock());
-
 			jassert(dynamic_cast<EffectProcessor*>(processorToBeRemoved) != nullptr);
-			
-			chain->allEffects.removeAllInstancesOf(dynamic_cast<EffectProcessor*>(processorToBeRemoved));
 
-			if(VoiceEffectProcessor* vep = dynamic_cast<VoiceEffectProcessor*>(processorToBeRemoved)) chain->voiceEffects.removeObject(vep);
-			else if (MasterEffectProcessor* mep = dynamic_cast<MasterEffectProcessor*>(processorToBeRemoved)) chain->masterEffects.removeObject(mep);
-			else if (MonophonicEffectProcessor* moep = dynamic_cast<MonophonicEffectProcessor*>(processorToBeRemoved)) chain->monoEffects.removeObject(moep);
-			else jassertfalse;
+			EffectProcessor* ep = dynamic_cast<EffectProcessor*>(processorToBeRemoved);
+
+			ScopedPointer<Processor> removedProcessor;
+
+			{
+				MainController::GraphEditQueue& queue = chain->getMainController()->getGraphEditQueue();
+
+				MainController::GraphEditQueue::ScopedEditLock sl(queue);
+
+				MainController::GraphEditQueue::ArrayCopy<OwnedArray<VoiceEffectProcessor>> newVoiceEffects(chain->voiceEffects);
+				MainController::GraphEditQueue::ArrayCopy<OwnedArray<MasterEffectProcessor>> newMasterEffects(chain->masterEffects);
+				MainController::GraphEditQueue::ArrayCopy<OwnedArray<MonophonicEffectProcessor>> newMonoEffects(chain->monoEffects);
+				MainController::GraphEditQueue::ArrayCopy<Array<EffectProcessor*>> newAllEffects(chain->allEffects);
+
+				const int voiceIndex = newVoiceEffects->indexOf(dynamic_cast<VoiceEffectProcessor*>(processorToBeRemoved));
+				const int masterIndex = newMasterEffects->indexOf(dynamic_cast<MasterEffectProcessor*>(processorToBeRemoved));
+				const int monoIndex = newMonoEffects->indexOf(dynamic_cast<MonophonicEffectProcessor*>(processorToBeRemoved));
+
+				jassert(voiceIndex != -1 || masterIndex != -1 || monoIndex != -1);
+
+				newAllEffects->removeAllInstancesOf(ep);
+
+				if (voiceIndex != -1)		removedProcessor = newVoiceEffects->removeAndReturn(voiceIndex);
+				else if (masterIndex != -1) removedProcessor = newMasterEffects->removeAndReturn(masterIndex);
+				else if (monoIndex != -1)	removedProcessor = newMonoEffects->removeAndReturn(monoIndex);
+
+				// The effect is only taken out of the chain on the audio thread and deleted here afterwards.
+				queue.performEdit([&]()
+				{
+					newVoiceEffects.swapWithOriginal();
+					newMasterEffects.swapWithOriginal();
+					newMonoEffects.swapWithOriginal();
+					newAllEffects.swapWithOriginal();
+				});
+			}
+
+			removedProcessor = nullptr;
 
 			jassert(chain->allEffects.size() == (chain->masterEffects.size() + chain->voiceEffects.size() + chain->monoEffects.size()));
 
+			chain->getMainController()->getProcessorRegistry().markDirty();
+
 			sendChangeMessage();
 		}
 
@@ -241,11 +272,16 @@ public:
 
 				if (indexOfProcessor != indexOfSwapProcessor)
 				{
-					ScopedLock sl(chain->getMainController()->getLock());
+					EffectProcessorChain* c = chain;
 
-					chain->masterEffects.swap(indexOfProcessor, indexOfSwapProcessor);
-					chain->allEffects.swap(indexOfProcessorInAllEffects, indexOfSwapProcessorInAllEfects);
+					chain->getMainController()->getGraphEditQueue().performEdit([=]()
+					{
+						c->masterEffects.swap(indexOfProcessor, indexOfSwapProcessor);
+						c->allEffects.swap(indexOfProcessorInAllEffects, indexOfSwapProcessorInAllEfects);
+					});
 				}
+
+				chain->getMainController()->getProcessorRegistry().markDirty();
 			}
 		}
 
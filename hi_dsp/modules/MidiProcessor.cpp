@@ -94,7 +94,7 @@ void MidiProcessorChain::addArtificialEvent(const HiseEvent& m)
 
 	//jassert(m.isArtificial());
 
-	const int thisBlockSize = dynamic_cast<AudioProcessor*>(getMainController())->getBlockSize();
+	const int thisBlockSize = getMainController()->getCurrentBlockSize();
 
 	if (timeStamp > thisBlockSize)
 	{
@@ -238,19 +238,32 @@ bool MidiProcessorFactoryType::allowType(const Identifier &typeName) const
 
 void MidiProcessorChain::MidiProcessorChainHandler::add(Processor *newProcessor, Processor *siblingToInsertBefore)
 {
-	ScopedLock sl(chain->getMainController()->getLock());
-
 	MidiProcessor *m = dynamic_cast<MidiProcessor*>(newProcessor);
 
 	jassert(m != nullptr);
 
-	const int index = siblingToInsertBefore == nullptr ? -1 : chain->processors.indexOf(dynamic_cast<MidiProcessor*>(siblingToInsertBefore));
-
     newProcessor->prepareToPlay(chain->getSampleRate(), chain->getBlockSize());
     
     newProcessor->setIsOnAir(true);
-    
-	chain->processors.insert(index, m);
+
+	{
+		MainController::GraphEditQueue& queue = chain->getMainController()->getGraphEditQueue();
+
+		MainController::GraphEditQueue::ScopedEditLock sl(queue);
+
+		const int index = siblingToInsertBefore == nullptr ? -1 : chain->processors.indexOf(dynamic_cast<MidiProcessor*>(siblingToInsertBefore));
+
+		MainController::GraphEditQueue::ArrayCopy<OwnedArray<MidiProcessor>> newProcessors(chain->processors);
+
+		newProcessors->insert(index, m);
+
+		queue.performEdit([&]()
+		{
+			newProcessors.swapWithOriginal();
+		});
+	}
+
+	chain->getMainController()->getProcessorRegistry().markDirty();
 
 	if (JavascriptMidiProcessor* sp = dynamic_cast<JavascriptMidiProcessor*>(newProcessor))
 	{	
@@ -191,6 +191,15 @@ public:
 
 	void renderNextHiseEventBuffer(HiseEventBuffer &buffer, int numSamples);
 
+	/** Returns true if the next call to renderNextHiseEventBuffer() might change the buffer. 
+	*
+	*	If this returns false, the synth can render the events of its parent without copying them. 
+	*/
+	bool needsToProcessEvents() const noexcept
+	{
+		return allNotesOffAtNextBuffer || processors.size() != 0 || !futureEventBuffer.isEmpty() || !artificialEvents.isEmpty();
+	}
+
 	/** Sequentially processes all processors. */
 	void processHiseEvent(HiseEvent &m) override
 	{
@@ -231,18 +240,29 @@ public:
 
 		void remove(Processor *processorToBeRemoved)
 		{
-			ScopedLock sl(chain->getMainController()->getLock());
-
 			jassert(dynamic_cast<MidiProcessor*>(processorToBeRemoved) != nullptr);
-			for(int i = 0; i < chain->processors.size(); i++)
+
+			ScopedPointer<MidiProcessor> removedProcessor;
+
 			{
-				if (chain->processors[i] == processorToBeRemoved)
+				MainController::GraphEditQueue& queue = chain->getMainController()->getGraphEditQueue();
+
+				MainController::GraphEditQueue::ScopedEditLock sl(queue);
+
+				MainController::GraphEditQueue::ArrayCopy<OwnedArray<MidiProcessor>> newProcessors(chain->processors);
+
+				removedProcessor = newProcessors->removeAndReturn(newProcessors->indexOf(dynamic_cast<MidiProcessor*>(processorToBeRemoved)));
+
+				queue.performEdit([&]()
 				{
-					chain->processors.remove(i);
-					break;
-				}
+					newProcessors.swapWithOriginal();
+				});
 			}
 
+			removedProcessor = nullptr;
+
+			chain->getMainController()->getProcessorRegistry().markDirty();
+
 			sendChangeMessage();
 		};
 
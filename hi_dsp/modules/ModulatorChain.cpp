@@ -35,16 +35,20 @@ ModulatorChain::ModulatorChain(MainController *mc, const String &uid, int numVoi
 	Modulation(m),
 	handler(this),
 	parentProcessor(p),
+	timeVariantSignalType(ConstantSignal),
+	timeVariantSignalIsUnity(true),
 	isVoiceStartChain(false)
 {
 	internalVoiceBuffer = AudioSampleBuffer(numVoices, 0);
-	envelopeTempBuffer = AudioSampleBuffer(1, 0);
 
 	activeVoices.setRange(0, numVoices, false);
 	setFactoryType(new ModulatorChainFactoryType(numVoices, m, p));
 
 	FloatVectorOperations::fill(lastVoiceValues, 1.0, NUM_POLYPHONIC_VOICES);
 
+	for (int i = 0; i < NUM_POLYPHONIC_VOICES; i++)
+		voiceSignalTypes[i] = ConstantSignal;
+
 	if (Identifier::isValidIdentifier(uid))
 	{
 		chainIdentifier = Identifier(uid);
@@ -201,7 +205,6 @@ void ModulatorChain::prepareToPlay(double sampleRate, int samplesPerBlock)
 	blockSize = samplesPerBlock;
 
 	ProcessorHelpers::increaseBufferIfNeeded(internalVoiceBuffer, samplesPerBlock);
-	ProcessorHelpers::increaseBufferIfNeeded(envelopeTempBuffer, samplesPerBlock);
 
 	for(int i = 0; i < envelopeModulators.size(); i++) envelopeModulators[i]->prepareToPlay(sampleRate, samplesPerBlock);
 	for(int i = 0; i < variantModulators.size(); i++) variantModulators[i]->prepareToPlay(sampleRate, samplesPerBlock);
@@ -248,38 +251,47 @@ void ModulatorChain::ModulatorChainHandler::addModulator(Modulator *newModulator
 	if (chain->isInitialized())
 		newModulator->prepareToPlay(chain->getSampleRate(), chain->blockSize);
 	
-	const int index = siblingToInsertBefore == nullptr ? -1 : chain->allModulators.indexOf(dynamic_cast<Modulator*>(siblingToInsertBefore));
+	newModulator->setIsOnAir(true);
+
+	VoiceStartModulator *vsm = dynamic_cast<VoiceStartModulator*>(newModulator);
+	EnvelopeModulator *em = dynamic_cast<EnvelopeModulator*>(newModulator);
+	TimeVariantModulator *tvm = dynamic_cast<TimeVariantModulator*>(newModulator);
+
+	jassert(vsm != nullptr || em != nullptr || tvm != nullptr);
 
 	{
-		MainController::ScopedSuspender ss(chain->getMainController());
+		MainController::GraphEditQueue& queue = chain->getMainController()->getGraphEditQueue();
 
-		newModulator->setIsOnAir(true);
+		MainController::GraphEditQueue::ScopedEditLock sl(queue);
 
-		if (dynamic_cast<VoiceStartModulator*>(newModulator) != nullptr)
-		{
-			VoiceStartModulator *m = static_cast<VoiceStartModulator*>(newModulator);
-			chain->voiceStartModulators.add(m);
-		}
-		else if (dynamic_cast<EnvelopeModulator*>(newModulator) != nullptr)
-		{
-			EnvelopeModulator *m = static_cast<EnvelopeModulator*>(newModulator);
-			chain->envelopeModulators.add(m);
-		}
-		else if (dynamic_cast<TimeVariantModulator*>(newModulator) != nullptr)
-		{
-			TimeVariantModulator *m = static_cast<TimeVariantModulator*>(newModulator);
-			chain->variantModulators.add(m);
-		}
-		else jassertfalse;
+		// Build the new arrays here so that the audio thread only has to swap them
+		MainController::GraphEditQueue::ArrayCopy<OwnedArray<VoiceStartModulator>> newVoiceStartModulators(chain->voiceStartModulators);
+		MainController::GraphEditQueue::ArrayCopy<OwnedArray<EnvelopeModulator>> newEnvelopeModulators(chain->envelopeModulators);
+		MainController::GraphEditQueue::ArrayCopy<OwnedArray<TimeVariantModulator>> newVariantModulators(chain->variantModulators);
+		MainController::GraphEditQueue::ArrayCopy<Array<Modulator*>> newAllModulators(chain->allModulators);
+
+		if (vsm != nullptr)		 newVoiceStartModulators->add(vsm);
+		else if (em != nullptr)	 newEnvelopeModulators->add(em);
+		else if (tvm != nullptr) newVariantModulators->add(tvm);
 
-		chain->allModulators.insert(index, newModulator);
+		const int index = siblingToInsertBefore == nullptr ? -1 : chain->allModulators.indexOf(dynamic_cast<Modulator*>(siblingToInsertBefore));
 
-		jassert(chain->checkModulatorStructure());
+		newAllModulators->insert(index, newModulator);
 
-		if (JavascriptProcessor* sp = dynamic_cast<JavascriptProcessor*>(newModulator))
+		queue.performEdit([&]()
 		{
-			sp->compileScript();
-		}
+			newVoiceStartModulators.swapWithOriginal();
+			newEnvelopeModulators.swapWithOriginal();
+			newVariantModulators.swapWithOriginal();
+			newAllModulators.swapWithOriginal();
+		});
+	}
+
+	jassert(chain->checkModulatorStructure());
+
+	if (JavascriptProcessor* sp = dynamic_cast<JavascriptProcessor*>(newModulator))
+	{
+		sp->compileScript();
 	}
 
 	chain->sendChangeMessage();
@@ -288,48 +300,70 @@ void ModulatorChain::ModulatorChainHandler::addModulator(Modulator *newModulator
 
 void ModulatorChain::ModulatorChainHandler::add(Processor *newProcessor, Processor *siblingToInsertBefore)
 {
-	//ScopedLock sl(chain->getMainController()->getLock());
-
 	jassert(dynamic_cast<Modulator*>(newProcessor) != nullptr);
 
-	dynamic_cast<AudioProcessor*>(chain->getMainController())->suspendProcessing(true);
-
 	addModulator(dynamic_cast<Modulator*>(newProcessor), siblingToInsertBefore);
 
+	chain->getMainController()->getProcessorRegistry().markDirty();
+
 	const bool isPitchChain = chain->getMode() == Modulation::PitchMode;
 	if (isPitchChain)
 	{
 		ModulatorSynth *p = dynamic_cast<ModulatorSynth*>(chain->getParentProcessor());
 
-		if(p != nullptr) p->enablePitchModulation(true);
+		if (p != nullptr)
+		{
+			chain->getMainController()->getGraphEditQueue().performEdit([p]()
+			{
+				p->enablePitchModulation(true);
+			});
+		}
 	}
 
-	dynamic_cast<AudioProcessor*>(chain->getMainController())->suspendProcessing(false);
-
 	sendChangeMessage();
 }
 
 void ModulatorChain::ModulatorChainHandler::deleteModulator(Modulator *modulatorToBeDeleted)
 {
-	for(int i = 0; i < getNumModulators(); ++i)
-	{
-		if(chain->allModulators[i] == modulatorToBeDeleted) chain->allModulators.remove(i);
-	};
-		
-	for(int i = 0; i < chain->variantModulators.size(); ++i)
-	{
-		if(chain->variantModulators[i] == modulatorToBeDeleted) chain->variantModulators.remove(i, true);
-	};
+	ScopedPointer<Modulator> removedModulator;
 
-	for(int i = 0; i < chain->envelopeModulators.size(); ++i)
-	{
-		if(chain->envelopeModulators[i] == modulatorToBeDeleted) chain->envelopeModulators.remove(i, true);
-	};
+	const bool disablePitchModulation = chain->getMode() == Modulation::PitchMode && getNumModulators() == 1;
+	ModulatorSynth* synth = dynamic_cast<ModulatorSynth*>(chain->getParentProcessor());
 
-	for(int i = 0; i < chain->voiceStartModulators.size(); ++i) 
 	{
-		if(chain->voiceStartModulators[i] == modulatorToBeDeleted) chain->voiceStartModulators.remove(i, true);
-	};
+		MainController::GraphEditQueue& queue = chain->getMainController()->getGraphEditQueue();
+
+		MainController::GraphEditQueue::ScopedEditLock sl(queue);
+
+		MainController::GraphEditQueue::ArrayCopy<OwnedArray<VoiceStartModulator>> newVoiceStartModulators(chain->voiceStartModulators);
+		MainController::GraphEditQueue::ArrayCopy<OwnedArray<EnvelopeModulator>> newEnvelopeModulators(chain->envelopeModulators);
+		MainController::GraphEditQueue::ArrayCopy<OwnedArray<TimeVariantModulator>> newVariantModulators(chain->variantModulators);
+		MainController::GraphEditQueue::ArrayCopy<Array<Modulator*>> newAllModulators(chain->allModulators);
+
+		newAllModulators->removeFirstMatchingValue(modulatorToBeDeleted);
+
+		const int variantIndex = newVariantModulators->indexOf(dynamic_cast<TimeVariantModulator*>(modulatorToBeDeleted));
+		const int envelopeIndex = newEnvelopeModulators->indexOf(dynamic_cast<EnvelopeModulator*>(modulatorToBeDeleted));
+		const int voiceStartIndex = newVoiceStartModulators->indexOf(dynamic_cast<VoiceStartModulator*>(modulatorToBeDeleted));
+
+		if (variantIndex != -1)			removedModulator = newVariantModulators->removeAndReturn(variantIndex);
+		else if (envelopeIndex != -1)	removedModulator = newEnvelopeModulators->removeAndReturn(envelopeIndex);
+		else if (voiceStartIndex != -1)	removedModulator = newVoiceStartModulators->removeAndReturn(voiceStartIndex);
+
+		// The modulator is only taken out of the chain on the audio thread and deleted here afterwards.
+		queue.performEdit([&]()
+		{
+			newVoiceStartModulators.swapWithOriginal();
+			newEnvelopeModulators.swapWithOriginal();
+			newVariantModulators.swapWithOriginal();
+			newAllModulators.swapWithOriginal();
+
+			if (disablePitchModulation && synth != nullptr)
+				synth->enablePitchModulation(false);
+		});
+	}
+
+	removedModulator = nullptr;
 
 	jassert(chain->checkModulatorStructure());
 	chain->sendChangeMessage();
@@ -338,16 +372,10 @@ void ModulatorChain::ModulatorChainHandler::deleteModulator(Modulator *modulator
 
 void ModulatorChain::ModulatorChainHandler::remove(Processor *processorToBeRemoved)
 {
-	ScopedLock sl(chain->getMainController()->getLock());
-
 	jassert(dynamic_cast<Modulator*>(processorToBeRemoved) != nullptr);
 	deleteModulator(dynamic_cast<Modulator*>(processorToBeRemoved));
-    
-	const bool isPitchChainOfNonGroup = chain->getMode() == Modulation::PitchMode;
-	if (isPitchChainOfNonGroup && getNumModulators() == 0)
-	{
-		dynamic_cast<ModulatorSynth*>(chain->getParentProcessor())->enablePitchModulation(false);
-	}
+
+	chain->getMainController()->getProcessorRegistry().markDirty();
 
 	sendChangeMessage();
 }
@@ -415,6 +443,9 @@ void ModulatorChain::renderVoice(int voiceIndex, int startSample, int numSamples
 	const int startIndex = startSample;
 	const int sampleAmount = numSamples;
 
+	// If nothing is processed, the buffer content is unknown
+	SignalType signalType = DynamicSignal;
+
 	if( shouldBeProcessed(true))
 	{
 		const float constantVoiceValue = getConstantVoiceValue(voiceIndex);
@@ -431,14 +462,21 @@ void ModulatorChain::renderVoice(int voiceIndex, int startSample, int numSamples
 				bufferPointer[i] = rampedGain;
 				rampedGain += stepSize;
 			}
+
+			signalType = RampSignal;
 		}
 		else
 		{
 			FloatVectorOperations::fill(internalBuffer.getWritePointer(0, startSample), constantVoiceValue, numSamples);
+			signalType = ConstantSignal;
 		}
 
 		lastVoiceValues[voiceIndex] = constantVoiceValue;
 
+		// Envelopes with a static value for this block (eg. in their sustain phase) are not rendered,
+		// but collected into a single factor that is applied to the (constant or ramped) values.
+		float staticFactor = 1.0f;
+
 		for(int i = 0; i < envelopeModulators.size(); i++)
 		{
 			EnvelopeModulator *m = envelopeModulators[i];
@@ -447,11 +485,19 @@ void ModulatorChain::renderVoice(int voiceIndex, int startSample, int numSamples
 
 			if (m->isInMonophonicMode())
 				continue;
+
+			float staticValue;
+
+			if (!m->isPlotted() && m->getStaticVoiceValue(voiceIndex, staticValue))
+			{
+				staticFactor *= m->getStaticModulationFactor(staticValue);
+				continue;
+			}
+
+			signalType = DynamicSignal;
 			
 			m->polyManager.setCurrentVoice(voiceIndex);
 
-			FloatVectorOperations::fill(envelopeTempBuffer.getWritePointer(0, startSample), 1.0f, numSamples);
-
 			float* bufferPointer = internalBuffer.getWritePointer(0, 0);
 
 			AudioSampleBuffer b1(&bufferPointer, 1, startSample + numSamples);
@@ -461,8 +507,12 @@ void ModulatorChain::renderVoice(int voiceIndex, int startSample, int numSamples
 			m->polyManager.clearCurrentVoice();
 		}
 
+		if (staticFactor != 1.0f)
+			FloatVectorOperations::multiply(internalBuffer.getWritePointer(0, startSample), staticFactor, numSamples);
 	}
 
+	voiceSignalTypes[voiceIndex] = signalType;
+
 	CHECK_AND_LOG_BUFFER_DATA_WITH_ID(parentProcessor, chainIdentifier, DebugLogger::Location::ModulatorChainVoiceRendering, internalBuffer.getReadPointer(0, startIndex), true, sampleAmount);
 
 	if(getMode() != Modulation::PitchMode)
@@ -492,10 +542,16 @@ void ModulatorChain::renderNextBlock(AudioSampleBuffer& buffer, int startSample,
 
 		initializeBuffer(internalBuffer, startSample, numSamples);
 
+		timeVariantSignalType = ConstantSignal;
+		timeVariantSignalIsUnity = true;
+
 		for (auto v : variantModulators)
 		{
 			if (v->isBypassed()) continue;
 			v->renderNextBlock(internalBuffer, startSample, numSamples);
+
+			timeVariantSignalType = DynamicSignal;
+			timeVariantSignalIsUnity = false;
 		}
 
 		for (auto m : envelopeModulators)
@@ -504,6 +560,9 @@ void ModulatorChain::renderNextBlock(AudioSampleBuffer& buffer, int startSample,
 			if (!m->isInMonophonicMode()) continue;
 
 			m->renderNextBlock(internalBuffer, startSample, numSamples);
+
+			timeVariantSignalType = DynamicSignal;
+			timeVariantSignalIsUnity = false;
 		}
 
 #if ENABLE_PLOTTER
@@ -71,6 +71,19 @@ public:
 
 	class ModulatorChainHandler;
 
+	/** The shape of the values that were calculated for the last block.
+	*
+	*	The chain combines the values of its modulators symbolically where possible, so that the consumer of the values can
+	*	skip per-sample operations if the block is constant (which is the case for voices in their sustain phase).
+	*/
+	enum SignalType
+	{
+		ConstantSignal = 0, ///< every value in the block is the same
+		RampSignal, ///< the values form a linear ramp
+		DynamicSignal, ///< arbitrary values
+		numSignalTypes
+	};
+
 	/** Creates a new modulator chain. You have to specify the voice amount and the Modulation::Mode */
 	ModulatorChain(MainController *mc, const String &id, int numVoices, Modulation::Mode m, Processor *p);
 
@@ -175,6 +188,32 @@ public:
 	const float *getVoiceValues(int voiceIndex) const noexcept
 	{ return internalVoiceBuffer.getReadPointer(voiceIndex); }
 
+	/** Returns the shape of the voice values that were calculated by the last renderVoice() call for the given voice.
+	*
+	*	The values are always written into the voice buffer, so you can ignore this, but if it returns ConstantSignal, you can
+	*	use the first value as scalar instead of processing the whole block.
+	*/
+	SignalType getVoiceSignalType(int voiceIndex) const noexcept { return voiceSignalTypes[voiceIndex]; }
+
+	/** Checks if the voice values of the last renderVoice() call are constant and returns the value. */
+	bool isVoiceValueConstant(int voiceIndex, int startSample, float& constantValue) const noexcept
+	{
+		if (voiceSignalTypes[voiceIndex] != ConstantSignal)
+			return false;
+
+		constantValue = internalVoiceBuffer.getSample(voiceIndex, startSample);
+		return true;
+	}
+
+	/** Returns the shape of the values that were calculated by the last renderNextBlock() call. */
+	SignalType getTimeVariantSignalType() const noexcept { return timeVariantSignalType; }
+
+	/** Returns true if the last renderNextBlock() call did not calculate anything and just filled the buffer with 1.0f. 
+	*
+	*	In this case the caller can skip the multiplication with the time variant values.
+	*/
+	bool isTimeVariantSignalUnity() const noexcept { return timeVariantSignalType == ConstantSignal && timeVariantSignalIsUnity; }
+
 	/** This ocverrides the TimeVariant::renderNextBlock method and only calculates the TimeVariant modulators.
 	*
 	*	It assumes that the other modulators are calculated before with renderVoice().
@@ -326,8 +365,6 @@ private:
 	
 	// A AudioSampleBuffer with one channel per voice
 	AudioSampleBuffer internalVoiceBuffer;
-	
-	AudioSampleBuffer envelopeTempBuffer;
 
 	ModulatorChainHandler handler;
 
@@ -353,6 +390,11 @@ private:
 
 	float lastVoiceValues[NUM_POLYPHONIC_VOICES];
 
+	SignalType voiceSignalTypes[NUM_POLYPHONIC_VOICES];
+
+	SignalType timeVariantSignalType;
+	bool timeVariantSignalIsUnity;
+
 	bool isVoiceStartChain;
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModulatorChain)
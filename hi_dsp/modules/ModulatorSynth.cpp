@@ -204,10 +204,12 @@ void ModulatorSynth::synthTimerCallback(uint8 index)
 	{
 		ADD_GLITCH_DETECTOR(this, DebugLogger::Location::TimerCallback);
 
-		const double thisUptime = getMainController()->getUptime() - (getBlockSize() / getSampleRate());
+		const int numSamples = getMainController()->getCurrentBlockSize();
+
+		const double thisUptime = getMainController()->getUptime() - (numSamples / getSampleRate());
 		uint16 offsetInBuffer = (uint16)((nextTimerCallbackTimes[index] - thisUptime) * getSampleRate());
 
-		while (synthTimerIntervals[index] > 0.0 && offsetInBuffer < getBlockSize())
+		while (synthTimerIntervals[index] > 0.0 && offsetInBuffer < numSamples)
 		{
 			eventBuffer.addEvent(HiseEvent::createTimerEvent(index, offsetInBuffer));
 			nextTimerCallbackTimes[index].store(nextTimerCallbackTimes[index].load() + synthTimerIntervals[index].load());
@@ -288,16 +290,33 @@ ProcessorEditorBody *ModulatorSynth::createEditor(ProcessorEditor *parentEditor)
 
 void ModulatorSynth::processHiseEventBuffer(const HiseEventBuffer &inputBuffer, int numSamples)
 {
+	currentEventBuffer = &eventBuffer;
+
 	if(handleSoftBypass())
 	{
+		const bool timer0 = checkTimerCallback(0);
+		const bool timer1 = checkTimerCallback(1);
+		const bool timer2 = checkTimerCallback(2);
+		const bool timer3 = checkTimerCallback(3);
+
+		const bool isMainChain = getMainController()->getMainSynthChain() == this;
+
+		if (!(timer0 || timer1 || timer2 || timer3 || isMainChain || midiProcessorChain->needsToProcessEvents()))
+		{
+			// Nothing will change the events, so render the parent buffer directly
+			eventBuffer.clear();
+			currentEventBuffer = &inputBuffer;
+			return;
+		}
+
 		eventBuffer.copyFrom(inputBuffer);
 
-		if (checkTimerCallback(0)) synthTimerCallback(0);
-		if (checkTimerCallback(1)) synthTimerCallback(1);
-		if (checkTimerCallback(2)) synthTimerCallback(2);
-		if (checkTimerCallback(3)) synthTimerCallback(3);
+		if (timer0) synthTimerCallback(0);
+		if (timer1) synthTimerCallback(1);
+		if (timer2) synthTimerCallback(2);
+		if (timer3) synthTimerCallback(3);
 
-		if (getMainController()->getMainSynthChain() == this)
+		if (isMainChain)
 		{
 			handleHostInfoHiseEvents();
 		}
@@ -350,7 +369,8 @@ void ModulatorSynth::renderNextBlockWithModulators(AudioSampleBuffer& outputBuff
 
     ADD_GLITCH_DETECTOR(this, DebugLogger::Location::SynthRendering);
     
-	int numSamples = getBlockSize(); //outputBuffer.getNumSamples();
+	// The host block can be smaller than the block size from prepareToPlay()
+	int numSamples = jmin<int>(outputBuffer.getNumSamples(), getBlockSize());
 
 	const int numSamplesFixed = numSamples;
 
@@ -365,9 +385,9 @@ void ModulatorSynth::renderNextBlockWithModulators(AudioSampleBuffer& outputBuff
 	processHiseEventBuffer(inputMidiBuffer, numSamplesFixed);
 
 
-	midiInputFlag = !eventBuffer.isEmpty();
+	midiInputFlag = !currentEventBuffer->isEmpty();
 
-	HiseEventBuffer::Iterator eventIterator(eventBuffer);
+	HiseEventBuffer::Iterator eventIterator(*currentEventBuffer);
 
 	HiseEvent m;
 	int midiEventPos;
@@ -423,7 +443,12 @@ void ModulatorSynth::renderNextBlockWithModulators(AudioSampleBuffer& outputBuff
 	}
 	
 
-	effectChain->renderMasterEffects(internalBuffer);
+	{
+		// Refers to the rendered part of the internal buffer without allocating
+		AudioSampleBuffer thisBlock(internalBuffer.getArrayOfWritePointers(), internalBuffer.getNumChannels(), numSamplesFixed);
+
+		effectChain->renderMasterEffects(thisBlock);
+	}
 
 	for (int i = 0; i < internalBuffer.getNumChannels(); i++)
 	{
@@ -493,12 +518,15 @@ void ModulatorSynth::postVoiceRendering(int startSample, int numThisTime)
 
 	CHECK_AND_LOG_BUFFER_DATA_WITH_ID(this, getIDAsIdentifier(), DebugLogger::Location::SynthPostVoiceRenderingGainMod, gainBuffer.getReadPointer(0, startSample), true, numThisTime);
 
-	// Apply all gain modulators to the rendered voices
-	for (int i = 0; i < internalBuffer.getNumChannels(); i++)
+	// Apply all gain modulators to the rendered voices (skip this if there are no active time variant modulators)
+	if (!gainChain->isTimeVariantSignalUnity())
 	{
-		FloatVectorOperations::multiply(internalBuffer.getWritePointer(i, startSample), gainBuffer.getReadPointer(0, startSample), numThisTime);
+		for (int i = 0; i < internalBuffer.getNumChannels(); i++)
+		{
+			FloatVectorOperations::multiply(internalBuffer.getWritePointer(i, startSample), gainBuffer.getReadPointer(0, startSample), numThisTime);
 
-		CHECK_AND_LOG_BUFFER_DATA_WITH_ID(this, getIDAsIdentifier(), DebugLogger::Location::SynthPostVoiceRendering, internalBuffer.getReadPointer(i, startSample), i % 2 != 0, numThisTime);
+			CHECK_AND_LOG_BUFFER_DATA_WITH_ID(this, getIDAsIdentifier(), DebugLogger::Location::SynthPostVoiceRendering, internalBuffer.getReadPointer(i, startSample), i % 2 != 0, numThisTime);
+		}
 	}
 
 	if (!isChainDisabled(EffectChain)) effectChain->renderNextBlock(internalBuffer, startSample, numThisTime);
@@ -597,7 +625,9 @@ void ModulatorSynth::handleHostInfoHiseEvents()
 	{
 		double ppq = getMainController()->getHostInfoObject()->getProperty(ppqPosition);
 
-		const double bufferAsMilliseconds = getBlockSize() / getSampleRate();
+		const int numSamples = getMainController()->getCurrentBlockSize();
+
+		const double bufferAsMilliseconds = numSamples / getSampleRate();
 		const double bufferAsPPQ = bufferAsMilliseconds * (getMainController()->getBpm() / 60.0);
 		const double ppqAtEndOfBuffer = ppq + bufferAsPPQ;
 
@@ -612,7 +642,7 @@ void ModulatorSynth::handleHostInfoHiseEvents()
 			const double remainingTime = (60.0 / getMainController()->getBpm()) * remaining;
 			const double remainingSamples = getSampleRate() * remainingTime;
 
-			if (remainingSamples < getBlockSize())
+			if (remainingSamples < numSamples)
 			{
 				ppqTimeStamp = (int)remainingSamples;
 			}
@@ -183,6 +183,7 @@ public:
 	void setIconColour(Colour newIconColour)
 	{ 
 		iconColour = newIconColour; 
+		markValueTreeDirty();
 		getMainController()->getProcessorChangeHandler().sendProcessorChangeMessage(this, MainController::ProcessorChangeHandler::EventType::ProcessorColourChange);
 	};
 
@@ -378,11 +379,25 @@ public:
 	{
         pitchChain->renderVoice(voiceIndex, startSample, numSamples);
 		float *voicePitchValues = pitchChain->getVoiceValues(voiceIndex);
-		const float *timeVariantPitchValues = getConstantPitchValues();
-		FloatVectorOperations::multiply(voicePitchValues, timeVariantPitchValues, startSample + numSamples);
+
+		if (!pitchChain->isTimeVariantSignalUnity())
+		{
+			const float *timeVariantPitchValues = getConstantPitchValues();
+			FloatVectorOperations::multiply(voicePitchValues, timeVariantPitchValues, startSample + numSamples);
+		}
+
 		if (scriptPitchValue != 1.0f) FloatVectorOperations::multiply(voicePitchValues, scriptPitchValue, startSample + numSamples);
 	}
 
+	/** Checks if the gain values of the last calculateGainValuesForVoice() call are constant and returns the value.
+	*
+	*	Use this in the voice rendering to apply the gain as scalar.
+	*/
+	bool isGainConstantForVoice(int voiceIndex, int startSample, float& constantGain) const noexcept
+	{
+		return gainChain->isVoiceValueConstant(voiceIndex, startSample, constantGain);
+	}
+
 	/** Returns a read pointer to the calculated pitch values. */
 	const float *getPitchValuesForVoice(int voiceIndex) const { return pitchChain->getVoiceValues(voiceIndex);};
 
@@ -392,6 +407,10 @@ public:
 	ModulatorSynthVoice* getFreeVoice(SynthesiserSound* s, int midiChannel, int midiNoteNumber);
 
 	HiseEventBuffer eventBuffer;
+
+	/** Points either to the eventBuffer or to the (unmodified) buffer of the parent synth. Use this for rendering. */
+	const HiseEventBuffer* currentEventBuffer = &eventBuffer;
+
 	AudioSampleBuffer internalBuffer;
 
 	UpdateMerger vuMerger;
@@ -536,6 +555,35 @@ public:
 		return getOwnerSynth()->calculateGainValuesForVoice(voiceIndex, scriptGainValue, startSample, numSamples);
 	}
 
+	/** Checks if the gain values that were calculated with getVoiceGainValues() are constant for this block. */
+	bool isVoiceGainConstant(int startSample, float& constantGain) const noexcept
+	{
+		return getOwnerSynth()->isGainConstantForVoice(voiceIndex, startSample, constantGain);
+	}
+
+	/** Multiplies the voice buffer with the gain values calculated by getVoiceGainValues().
+	*
+	*	If the gain values are constant for this block, it uses a scalar multiplication (or skips it completely if the gain is 1.0f).
+	*/
+	void applyVoiceGainValues(const float* modValues, int startSample, int numSamples)
+	{
+		float constantGain;
+
+		if (isVoiceGainConstant(startSample, constantGain))
+		{
+			if (constantGain != 1.0f)
+			{
+				for (int i = 0; i < voiceBuffer.getNumChannels(); i++)
+					FloatVectorOperations::multiply(voiceBuffer.getWritePointer(i, startSample), constantGain, numSamples);
+			}
+		}
+		else
+		{
+			for (int i = 0; i < voiceBuffer.getNumChannels(); i++)
+				FloatVectorOperations::multiply(voiceBuffer.getWritePointer(i, startSample), modValues + startSample, numSamples);
+		}
+	}
+
 	/** This only checks if the sound is valid, but you can override this with the desired behaviour. */
 	virtual bool canPlaySound(SynthesiserSound *s) override
 	{
@@ -165,6 +165,11 @@ ValueTree ModulatorSynthChain::exportAsValueTree() const
 	return v;
 }
 
+bool ModulatorSynthChain::canCacheValueTree() const
+{
+	return this != getMainController()->getMainSynthChain() && ModulatorSynth::canCacheValueTree();
+}
+
 void ModulatorSynthChain::addProcessorsWhenEmpty()
 {
 	
@@ -211,9 +216,10 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 		}
 	}
 
-	const int numSamples = getBlockSize();//buffer.getNumSamples();
+	// The host block can be smaller than the block size from prepareToPlay()
+	const int numSamples = jmin<int>(buffer.getNumSamples(), getBlockSize());
 
-	jassert(numSamples <= buffer.getNumSamples());
+	jassert(numSamples == buffer.getNumSamples());
 
 	initRenderCallback();
 
@@ -225,13 +231,16 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 
 	processHiseEventBuffer(inputMidiBuffer, numSamples);
 
-	// Shrink the internal buffer to the output buffer size 
-	internalBuffer.setSize(getMatrix().getNumSourceChannels(), numSamples, true, false, true);
+	// Only adapt the channel amount, the size stays at the prepared block size so that this never reallocates
+	if (internalBuffer.getNumChannels() != getMatrix().getNumSourceChannels())
+		internalBuffer.setSize(getMatrix().getNumSourceChannels(), internalBuffer.getNumSamples(), true, false, true);
+
+	AudioSampleBuffer thisBlock(internalBuffer.getArrayOfWritePointers(), internalBuffer.getNumChannels(), numSamples);
 
 	// Process the Synths and add store their output in the internal buffer
-	for (int i = 0; i < synths.size(); i++) if (!synths[i]->isSoftBypassed()) synths[i]->renderNextBlockWithModulators(internalBuffer, eventBuffer);
+	for (int i = 0; i < synths.size(); i++) if (!synths[i]->isSoftBypassed()) synths[i]->renderNextBlockWithModulators(thisBlock, *currentEventBuffer);
 
-	HiseEventBuffer::Iterator eventIterator(eventBuffer);
+	HiseEventBuffer::Iterator eventIterator(*currentEventBuffer);
 
 	while (auto e = eventIterator.getNextConstEventPointer(true, false))
 	{
@@ -245,7 +254,7 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 
 	postVoiceRendering(0, numSamples);
 
-	effectChain->renderMasterEffects(internalBuffer);
+	effectChain->renderMasterEffects(thisBlock);
 
 	if (internalBuffer.getNumChannels() != 2)
 	{
@@ -412,7 +421,12 @@ void ModulatorSynthChain::restoreInterfaceValues(const ValueTree &v)
 				{
 					ScriptingApi::Content *content = sp->getScriptingContent();
 
-					content->restoreAllControlsFromPreset(child);
+					// Skip the control callbacks if the host passes back the values we already have
+					ValueTree currentValues = content->exportAsValueTree();
+					currentValues.setProperty("Processor", sp->getId(), nullptr);
+
+					if (!currentValues.isEquivalentTo(child))
+						content->restoreAllControlsFromPreset(child);
 
 					break;
 				}
@@ -475,29 +489,59 @@ void ModulatorSynthChain::ModulatorSynthChainHandler::add(Processor *newProcesso
 
 	jassert(ms != nullptr);
 
-	const int index = siblingToInsertBefore == nullptr ? -1 : synth->synths.indexOf(dynamic_cast<ModulatorSynth*>(siblingToInsertBefore));
-
 	ms->getMatrix().setNumDestinationChannels(synth->getMatrix().getNumSourceChannels());
 	ms->getMatrix().setTargetProcessor(synth);
 
 	ms->prepareToPlay(synth->getSampleRate(), synth->getBlockSize());
 
+	ms->setIsOnAir(true);
+
 	{
-		MainController::ScopedSuspender ss(synth->getMainController());
-		ms->setIsOnAir(true);
-		synth->synths.insert(index, ms);
+		MainController::GraphEditQueue& queue = synth->getMainController()->getGraphEditQueue();
+
+		MainController::GraphEditQueue::ScopedEditLock sl(queue);
+
+		const int index = siblingToInsertBefore == nullptr ? -1 : synth->synths.indexOf(dynamic_cast<ModulatorSynth*>(siblingToInsertBefore));
+
+		MainController::GraphEditQueue::ArrayCopy<OwnedArray<ModulatorSynth>> newSynths(synth->synths);
+
+		newSynths->insert(index, ms);
+
+		queue.performEdit([&]()
+		{
+			newSynths.swapWithOriginal();
+		});
 	}
 
+	synth->getMainController()->getProcessorRegistry().markDirty();
+
 	sendChangeMessage();
 }
 
 void ModulatorSynthChain::ModulatorSynthChainHandler::remove(Processor *processorToBeRemoved)
 {
+	ScopedPointer<ModulatorSynth> removedSynth;
+
 	{
-		MainController::ScopedSuspender ss(synth->getMainController(), MainController::ScopedSuspender::LockType::Lock);
-		synth->synths.removeObject(dynamic_cast<ModulatorSynth*>(processorToBeRemoved));
+		MainController::GraphEditQueue& queue = synth->getMainController()->getGraphEditQueue();
+
+		MainController::GraphEditQueue::ScopedEditLock sl(queue);
+
+		MainController::GraphEditQueue::ArrayCopy<OwnedArray<ModulatorSynth>> newSynths(synth->synths);
+
+		removedSynth = newSynths->removeAndReturn(newSynths->indexOf(dynamic_cast<ModulatorSynth*>(processorToBeRemoved)));
+
+		// The synth is only taken out of the chain on the audio thread and deleted here afterwards.
+		queue.performEdit([&]()
+		{
+			newSynths.swapWithOriginal();
+		});
 	}
 
+	removedSynth = nullptr;
+
+	synth->getMainController()->getProcessorRegistry().markDirty();
+
 	sendChangeMessage();
 }
 
@@ -142,6 +142,9 @@ public:
 
 	ValueTree exportAsValueTree() const override;
 
+	/** The main synth chain also saves the macros, views and MIDI automation, so it is never cached. */
+	bool canCacheValueTree() const override;
+
 	void addProcessorsWhenEmpty() override;;
 
 	Processor *getParentProcessor() {return nullptr;};
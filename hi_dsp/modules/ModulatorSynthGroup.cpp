@@ -37,7 +37,15 @@ ModulatorSynthGroupVoice::ModulatorSynthGroupVoice(ModulatorSynth *ownerSynth) :
 {
 	enablePitchModulation(true);
 
-	
+	fmPitchBuffer = AudioSampleBuffer(1, 0);
+}
+
+
+void ModulatorSynthGroupVoice::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+	ModulatorSynthVoice::prepareToPlay(sampleRate, samplesPerBlock);
+
+	ProcessorHelpers::increaseBufferIfNeeded(fmPitchBuffer, samplesPerBlock);
 }
 
 
@@ -168,11 +176,7 @@ void ModulatorSynthGroupVoice::calculateBlock(int startSample, int numSamples)
 
 	ModulatorSynthGroup *group = static_cast<ModulatorSynthGroup*>(getOwnerSynth());
 
-	if (numUnisonoVoices > 1)
-	{
-		detuneValues.detuneModValue = static_cast<ModulatorSynthGroup*>(ownerSynth)->calculateDetuneModulationValuesForVoice(voiceIndex, startSample, numSamples)[0];
-		detuneValues.spreadModValue = static_cast<ModulatorSynthGroup*>(ownerSynth)->calculateSpreadModulationValuesForVoice(voiceIndex, startSample, numSamples)[0];
-	}
+	calculateUnisonoValues(startSample, numSamples);
 
 	if (useFMForVoice)
 	{
@@ -218,13 +222,13 @@ void ModulatorSynthGroupVoice::calculateNoFMVoiceInternal(ModulatorSynth * child
 	if (childVoiceIndex >= NUM_POLYPHONIC_VOICES)
 		return;
 
-	calculateDetuneMultipliers(childVoiceIndex);
+	const int unisonoIndex = childVoiceIndex % numUnisonoVoices;
 
 	auto& childContainer = getChildContainer(childVoiceIndex);
 
 	const float gain = childSynth->getGain();
-	const float g_left = detuneValues.getGainFactor(false) * gain * childSynth->getBalance(false);
-	const float g_right = detuneValues.getGainFactor(true) * gain * childSynth->getBalance(true);
+	const float g_left = unisonoValues.gainLeft[unisonoIndex] * gain * childSynth->getBalance(false);
+	const float g_right = unisonoValues.gainRight[unisonoIndex] * gain * childSynth->getBalance(true);
 
 	for (int i = 0; i < childContainer.size(); i++)
 	{
@@ -239,7 +243,7 @@ void ModulatorSynthGroupVoice::calculateNoFMVoiceInternal(ModulatorSynth * child
 
 		if (childPitchValues != nullptr && voicePitchValues != nullptr)
 		{
-			FloatVectorOperations::multiply(childPitchValues + startSample, voicePitchValues + startSample, detuneValues.multiplier, numSamples);
+			FloatVectorOperations::multiply(childPitchValues + startSample, voicePitchValues + startSample, unisonoValues.pitchFactors[unisonoIndex], numSamples);
 		}
 
 		childVoice->calculateBlock(startSample, numSamples);
@@ -260,35 +264,59 @@ void ModulatorSynthGroupVoice::calculateNoFMVoiceInternal(ModulatorSynth * child
 }
 
 
-void ModulatorSynthGroupVoice::calculateDetuneMultipliers(int childVoiceIndex)
+ModulatorSynthGroupVoice::UnisonoValues::UnisonoValues()
 {
-	if (numUnisonoVoices != 1)
+	calculate(1, 0.0f, 0.0f, 1.0f, 1.0f);
+}
+
+void ModulatorSynthGroupVoice::UnisonoValues::calculate(int numUnisonoVoices, float detune, float spread, float detuneModValue, float spreadModValue)
+{
+	if (numUnisonoVoices == 1)
 	{
-		// 0 ... voiceAmount -> -detune ... detune
+		pitchFactors[0] = 1.0f;
+		gainLeft[0] = 1.0f;
+		gainRight[0] = 1.0f;
+		return;
+	}
 
-		const float detune = ownerSynth->getAttribute(ModulatorSynthGroup::SpecialParameters::UnisonoDetune);
-		const float balance = ownerSynth->getAttribute(ModulatorSynthGroup::SpecialParameters::UnisonoSpread);
+	jassert(numUnisonoVoices <= NUM_MAX_UNISONO_VOICES);
 
-		const int unisonoIndex = childVoiceIndex % numUnisonoVoices;
+	const float gainFactor = 1.0f / sqrtf((float)numUnisonoVoices);
 
-		detuneValues.gainFactor = 1.0f / sqrtf((float)numUnisonoVoices);
+	for (int i = 0; i < numUnisonoVoices; i++)
+	{
+		// 0 ... voiceAmount -> -detune ... detune
 
-		const float normalizedVoiceIndex = (float)unisonoIndex / (float)(numUnisonoVoices - 1);
+		const float normalizedVoiceIndex = (float)i / (float)(numUnisonoVoices - 1);
 		const float normalizedDetuneAmount = normalizedVoiceIndex * 2.0f - 1.0f;
-		const float detuneOctaveAmount = detune * normalizedDetuneAmount * detuneValues.detuneModValue;
-		detuneValues.multiplier = Modulation::PitchConverters::octaveRangeToPitchFactor(detuneOctaveAmount);
+		const float detuneOctaveAmount = detune * normalizedDetuneAmount * detuneModValue;
+
+		pitchFactors[i] = Modulation::PitchConverters::octaveRangeToPitchFactor(detuneOctaveAmount);
+
+		const float detuneBalanceAmount = normalizedDetuneAmount * 100.0f * spread * spreadModValue;
+
+		gainLeft[i] = gainFactor * BalanceCalculator::getGainFactorForBalance(detuneBalanceAmount, true);
+		gainRight[i] = gainFactor * BalanceCalculator::getGainFactorForBalance(detuneBalanceAmount, false);
+	}
+}
+
+void ModulatorSynthGroupVoice::calculateUnisonoValues(int startSample, int numSamples)
+{
+	if (numUnisonoVoices > 1)
+	{
+		ModulatorSynthGroup* group = static_cast<ModulatorSynthGroup*>(ownerSynth);
 
-		const float detuneBalanceAmount = normalizedDetuneAmount * 100.0f * balance * detuneValues.spreadModValue;
+		const float detune = group->getAttribute(ModulatorSynthGroup::SpecialParameters::UnisonoDetune);
+		const float spread = group->getAttribute(ModulatorSynthGroup::SpecialParameters::UnisonoSpread);
+		const float detuneModValue = group->calculateDetuneModulationValuesForVoice(voiceIndex, startSample, numSamples)[0];
+		const float spreadModValue = group->calculateSpreadModulationValuesForVoice(voiceIndex, startSample, numSamples)[0];
 
-		detuneValues.balanceLeft = BalanceCalculator::getGainFactorForBalance(detuneBalanceAmount, true);
-		detuneValues.balanceRight = BalanceCalculator::getGainFactorForBalance(detuneBalanceAmount, false);
+		unisonoValues.calculate(numUnisonoVoices, detune, spread, detuneModValue, spreadModValue);
 	}
 	else
 	{
-		// reset them...
-		detuneValues = DetuneValues();
+		unisonoValues.calculate(1, 0.0f, 0.0f, 1.0f, 1.0f);
 	}
-
 }
 
 void ModulatorSynthGroupVoice::calculateFMBlock(ModulatorSynthGroup * group, int startSample, int numSamples)
@@ -321,13 +349,20 @@ void ModulatorSynthGroupVoice::calculateFMBlock(ModulatorSynthGroup * group, int
 
 	const float *modValues = modVoice->getVoiceValues(0, startSample); // Channel is the same;
 
-	FloatVectorOperations::copy(fmModBuffer, modValues, numSamples);
-	FloatVectorOperations::multiply(fmModBuffer, group->modSynthGainValues.getReadPointer(0, startSample), numSamples);
-	FloatVectorOperations::multiply(fmModBuffer, modGain, numSamples);
+	jassert(numSamples <= fmPitchBuffer.getNumSamples());
+
+	float* fmPitchValues = fmPitchBuffer.getWritePointer(0, 0);
+
+	FloatVectorOperations::multiply(fmPitchValues, modValues, group->modSynthGainValues.getReadPointer(0, startSample), numSamples);
+	FloatVectorOperations::multiply(fmPitchValues, modGain, numSamples);
 
-	const float peak = FloatVectorOperations::findMaximum(fmModBuffer, numSamples);
+	const float peak = FloatVectorOperations::findMaximum(fmPitchValues, numSamples);
 
-	FloatVectorOperations::add(fmModBuffer, 1.0f, numSamples);
+	FloatVectorOperations::add(fmPitchValues, 1.0f, numSamples);
+
+	// The group pitch is the same for every unisono voice, so it's applied here once.
+	if (voicePitchValues != nullptr)
+		FloatVectorOperations::multiply(fmPitchValues, voicePitchValues + startSample, numSamples);
 
 	modSynth->setPeakValues(peak, peak);
 
@@ -336,12 +371,12 @@ void ModulatorSynthGroupVoice::calculateFMBlock(ModulatorSynthGroup * group, int
 	for (int i = 0; i < numUnisonoVoices; i++)
 	{
 		const int unisonoVoiceIndex = voiceIndex*numUnisonoVoices + i;
-		calculateFMCarrierInternal(group, unisonoVoiceIndex, startSample, numSamples, voicePitchValues);
+		calculateFMCarrierInternal(group, unisonoVoiceIndex, startSample, numSamples);
 	}
 }
 
 
-void ModulatorSynthGroupVoice::calculateFMCarrierInternal(ModulatorSynthGroup * group, int childVoiceIndex, int startSample, int numSamples, const float * voicePitchValues)
+void ModulatorSynthGroupVoice::calculateFMCarrierInternal(ModulatorSynthGroup * group, int childVoiceIndex, int startSample, int numSamples)
 {
 	if (childVoiceIndex >= NUM_POLYPHONIC_VOICES)
 		return;
@@ -354,11 +389,13 @@ void ModulatorSynthGroupVoice::calculateFMCarrierInternal(ModulatorSynthGroup *
 	ModulatorSynth *modSynth = static_cast<ModulatorSynth*>(group->getChildProcessor(group->modIndex - 1 + indexOffset));
 	jassert(modSynth != nullptr);
 
-	calculateDetuneMultipliers(childVoiceIndex);
+	const int unisonoIndex = childVoiceIndex % numUnisonoVoices;
 
 	const float carrierGain = carrierSynth->getGain();
-	const float g_left = detuneValues.getGainFactor(false) * carrierGain * carrierSynth->getBalance(false);
-	const float g_right = detuneValues.getGainFactor(true) * carrierGain * carrierSynth->getBalance(true);
+	const float g_left = unisonoValues.gainLeft[unisonoIndex] * carrierGain * carrierSynth->getBalance(false);
+	const float g_right = unisonoValues.gainRight[unisonoIndex] * carrierGain * carrierSynth->getBalance(true);
+
+	const float* fmPitchValues = fmPitchBuffer.getReadPointer(0, 0);
 
 	auto& childContainer = getChildContainer(childVoiceIndex);
 
@@ -366,12 +403,12 @@ void ModulatorSynthGroupVoice::calculateFMCarrierInternal(ModulatorSynthGroup *
 	{
 		ModulatorSynthVoice *carrierVoice = childContainer.getVoice(i); // static_cast<ModulatorSynthVoice*>(carrierSynth->getVoice(childVoiceIndex));
 
-		if (carrierVoice->getOwnerSynth() == modSynth)
-			continue; // The modulator will be listed in the child voices but shouldn't be rendered here...
-
 		if (carrierVoice == nullptr)
 			return;
 
+		if (carrierVoice->getOwnerSynth() == modSynth)
+			continue; // The modulator will be listed in the child voices but shouldn't be rendered here...
+
 		if (carrierSynth->isSoftBypassed())
 			return;
 		
@@ -382,10 +419,8 @@ void ModulatorSynthGroupVoice::calculateFMCarrierInternal(ModulatorSynthGroup *
 
 		float *carrierPitchValues = carrierVoice->getVoicePitchValues();
 
-		FloatVectorOperations::multiply(carrierPitchValues + startSample, voicePitchValues + startSample, detuneValues.multiplier, numSamples);
-
-		// This is the magic FM command
-		FloatVectorOperations::multiply(carrierPitchValues + startSample, fmModBuffer, numSamples);
+		// This is the magic FM command (the group pitch is already in the fm pitch values)
+		FloatVectorOperations::multiply(carrierPitchValues + startSample, fmPitchValues, unisonoValues.pitchFactors[unisonoIndex], numSamples);
 
 #if JUCE_WINDOWS
 		FloatVectorOperations::clip(carrierPitchValues + startSample, carrierPitchValues + startSample, 0.00000001f, 1000.0f, numSamples);
@@ -805,7 +840,8 @@ void ModulatorSynthGroup::setAllowStateForAllChildSynths(bool shouldBeEnabled)
 
 void ModulatorSynthGroup::setUnisonoVoiceAmount(int newVoiceAmount)
 {
-	unisonoVoiceAmount = jmax<int>(1, newVoiceAmount);
+	// The child voice containers and unisono values are limited to NUM_MAX_UNISONO_VOICES
+	unisonoVoiceAmount = jlimit<int>(1, NUM_MAX_UNISONO_VOICES, newVoiceAmount);
 
 	unisonoVoiceLimit = NUM_POLYPHONIC_VOICES / unisonoVoiceAmount;
 
@@ -1098,6 +1134,7 @@ void ModulatorSynthGroup::ModulatorSynthGroupHandler::add(Processor *newProcesso
 
 	}
 
+	group->getMainController()->getProcessorRegistry().markDirty();
 
 	group->sendChangeMessage();
 
@@ -1107,6 +1144,8 @@ void ModulatorSynthGroup::ModulatorSynthGroupHandler::add(Processor *newProcesso
 
 void ModulatorSynthGroup::ModulatorSynthGroupHandler::remove(Processor *processorToBeRemoved)
 {
+	ScopedPointer<ModulatorSynth> removedSynth;
+
 	{
 		MainController::ScopedSuspender ss(group->getMainController(), MainController::ScopedSuspender::LockType::Lock);
 
@@ -1117,11 +1156,16 @@ void ModulatorSynthGroup::ModulatorSynthGroupHandler::remove(Processor *processo
 			static_cast<ModulatorSynthGroupVoice*>(group->getVoice(i))->removeChildSynth(m);
 		}
 
-		group->synths.removeObject(m);
+		removedSynth = group->synths.removeAndReturn(group->synths.indexOf(m));
 
 		group->checkFmState();
 	}
 
+	// Delete the synth after the lock is released
+	removedSynth = nullptr;
+
+	group->getMainController()->getProcessorRegistry().markDirty();
+
 	sendChangeMessage();
 }
 
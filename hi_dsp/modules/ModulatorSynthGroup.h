@@ -54,20 +54,16 @@ public:
 /** This class acts as wrapper in a ModulatorSynthGroup for all child synth voices. */
 class ModulatorSynthGroupVoice : public ModulatorSynthVoice
 {
-	struct DetuneValues
+	/** The pitch factors and gain values of all unisono voices. They are calculated once per block. */
+	struct UnisonoValues
 	{
-		float multiplier = 1.0f;
-		float gainFactor = 1.0f;
-		float balanceLeft = 1.0f;
-		float balanceRight = 1.0f;
+		UnisonoValues();
 
-		float detuneModValue = 1.0f;
-		float spreadModValue = 1.0f;
+		void calculate(int numUnisonoVoices, float detune, float spread, float detuneModValue, float spreadModValue);
 
-		float getGainFactor(bool getRightChannel)
-		{
-			return gainFactor * (getRightChannel ? balanceRight : balanceLeft);
-		}
+		float pitchFactors[NUM_MAX_UNISONO_VOICES];
+		float gainLeft[NUM_MAX_UNISONO_VOICES];
+		float gainRight[NUM_MAX_UNISONO_VOICES];
 	};
 
 public:
@@ -120,15 +116,17 @@ public:
 
 	void calculateBlock(int startSample, int numSamples) override;
 
+	void prepareToPlay(double sampleRate, int samplesPerBlock) override;
+
 	void calculateNoFMBlock(int startSample, int numSamples);
 
 	void calculateNoFMVoiceInternal(ModulatorSynth* childSynth, int unisonoIndex, int startSample, int numSamples, const float * voicePitchValues);
 
-	void calculateDetuneMultipliers(int childVoiceIndex);
+	void calculateUnisonoValues(int startSample, int numSamples);
 
 	void calculateFMBlock(ModulatorSynthGroup * group, int startSample, int numSamples);
 
-	void calculateFMCarrierInternal(ModulatorSynthGroup * group, int childVoiceIndex, int startSample, int numSamples, const float * voicePitchValues);
+	void calculateFMCarrierInternal(ModulatorSynthGroup * group, int childVoiceIndex, int startSample, int numSamples);
 
 	int getChildVoiceAmount() const;
 
@@ -185,7 +183,7 @@ private:
 
 	ChildVoiceContainer startedChildVoices[NUM_MAX_UNISONO_VOICES];
 
-	DetuneValues detuneValues;
+	UnisonoValues unisonoValues;
 
 	ModulatorSynth* getFMModulator();
 
@@ -226,7 +224,9 @@ private:
 
 	Array<ChildSynth> childSynths;
 
-	float fmModBuffer[2048];
+	/** The group pitch multiplied with the FM modulator signal, shared by all unisono carrier voices. */
+	AudioSampleBuffer fmPitchBuffer;
+
 	void handleActiveStateForChildSynths();
 };
 
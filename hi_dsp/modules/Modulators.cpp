@@ -61,6 +61,7 @@ void Modulation::applyModulationValue(float calculatedModulationValue, float &de
 void Modulation::setIntensity(float newIntensity) noexcept
 {
 	intensity = newIntensity;
+	getProcessor()->markValueTreeDirty();
 }
 
 void Modulation::setIntensityFromSlider(float sliderValue) noexcept
@@ -88,6 +89,7 @@ void Modulation::setIsBipolar(bool shouldBeBiPolar) noexcept
 	jassert(modulationMode == PitchMode);
 
 	bipolar = shouldBeBiPolar;
+	getProcessor()->markValueTreeDirty();
 }
 
 float Modulation::getIntensity() const noexcept
@@ -319,6 +321,16 @@ EnvelopeModulator::EnvelopeModulator(MainController *mc, const String &id, int v
 
 #pragma warning( pop )
 
+float EnvelopeModulator::getStaticModulationFactor(float staticValue) const noexcept
+{
+	if (getMode() == GainMode)
+		return calcGainIntensityValue(staticValue);
+
+	const float normalisedValue = isBipolar() ? (2.0f * staticValue - 1.0f) : staticValue;
+
+	return Modulation::PitchConverters::normalisedRangeToPitchFactor(getIntensity() * normalisedValue);
+}
+
 Processor *VoiceStartModulatorFactoryType::createProcessor(int typeIndex, const String &id)
 {
 	MainController *m = getOwnerProcessor()->getMainController();
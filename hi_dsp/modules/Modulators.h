@@ -813,6 +813,19 @@ public:
 
 	bool isInMonophonicMode() const { return isMonophonic; }
 
+	/** Overwrite this and return true if the envelope will output a constant value for the given voice during the next block (eg. the sustain phase).
+	*
+	*	The ModulatorChain uses this to skip the calculateBlock() call and multiplies the (intensity-applied) value as a scalar instead.
+	*	Only return true if the value is really constant - a ramping value must be rendered with calculateBlock().
+	*
+	*	@param voiceIndex the voice index (this is never called for monophonic envelopes).
+	*	@param staticValue the value between 0.0 and 1.0 before the intensity is applied.
+	*/
+	virtual bool getStaticVoiceValue(int /*voiceIndex*/, float& /*staticValue*/) { return false; }
+
+	/** Applies the intensity (and the pitch conversion in PitchMode) to a static value returned by getStaticVoiceValue(). */
+	float getStaticModulationFactor(float staticValue) const noexcept;
+
 	void startVoice(int /*voiceIndex*/) override
 	{
 		numPressedKeys++;
@@ -37,6 +37,15 @@ void FrontendProcessor::processBlock (AudioSampleBuffer& buffer, MidiBuffer& mid
 	if (((unlockCounter++ & 1023) == 0) && !unlocker.isUnlocked()) return;
 #endif
 
+	if (!isReadyToPlay())
+	{
+#if !FRONTEND_IS_PLUGIN
+		buffer.clear();
+#endif
+		midiMessages.clear();
+		return;
+	}
+
 	getDelayedRenderer().processWrapped(buffer, midiMessages);
 };
 
@@ -112,10 +121,6 @@ unlockCounter(0)
 
 #endif
     
-	LOG_START("Load images");
-
-	loadImages(imageData_);
-
 	if (externalFiles != nullptr)
 	{
 		setExternalScriptData(externalFiles->getChildWithName("ExternalScripts"));
@@ -123,29 +128,6 @@ unlockCounter(0)
 
 		sampleMaps = externalFiles->getChildWithName("SampleMaps");
 	}
-    
-	if (impulseData != nullptr)
-	{
-		getSampleManager().getAudioSampleBufferPool()->restoreFromValueTree(*impulseData);
-	}
-	else
-	{
-		File audioResourceFile(ProjectHandler::Frontend::getAppDataDirectory().getChildFile("AudioResources.dat"));
-
-		if (audioResourceFile.existsAsFile())
-		{
-			FileInputStream fis(audioResourceFile);
-
-			LOG_START("Load impulses");
-
-			ValueTree impulseDataFile = ValueTree::readFromStream(fis);
-
-			if (impulseDataFile.isValid())
-			{
-				getSampleManager().getAudioSampleBufferPool()->restoreFromValueTree(impulseDataFile);
-			}
-		}
-	}
 
 	numParameters = 0;
 
@@ -153,20 +135,18 @@ unlockCounter(0)
 
 	synthChain->setId(synthData.getProperty("ID", String()));
 
-    MainController::ScopedSuspender ss(this);
-
 	getSampleManager().setShouldSkipPreloading(true);
 
-	
-
-	setSkipCompileAtPresetLoad(true);
-
-	LOG_START("Restoring main container");
+	createUserPresetData();
 
-	synthChain->restoreFromValueTree(synthData);
+	// The audio callback renders silence and the host state is cached until the background loader is finished
+	startStateRestore();
 
-	setSkipCompileAtPresetLoad(false);
+	stateLoader = new StateLoader(*this, synthData, imageData_, impulseData);
+}
 
+void FrontendProcessor::restoreFinished(ValueTree& synthData)
+{
 	LOG_START("Compiling all scripts");
 
 	synthChain->compileAllScripts();
@@ -192,11 +172,62 @@ unlockCounter(0)
         createSampleMapValueTreeFromPreset(synthData);
     }
 #endif
-    
 
+	if (auto editor = dynamic_cast<FrontendProcessorEditor*>(getActiveEditor()))
+	{
+		editor->createInterface();
+	}
 
+	// The parameter list was created after the host queried it the first time
+	updateHostDisplay();
 
-	createUserPresetData();
+	finishStateRestore();
+}
+
+FrontendProcessor::StateLoader::StateLoader(FrontendProcessor& parent_, const ValueTree& synthData_, ValueTree* imageData_, ValueTree* impulseData_) :
+	Thread("Frontend State Loader"),
+	parent(parent_),
+	synthData(synthData_),
+	imageData(imageData_ != nullptr ? *imageData_ : ValueTree()),
+	impulseData(impulseData_ != nullptr ? *impulseData_ : ValueTree()),
+	hasImageData(imageData_ != nullptr),
+	hasImpulseData(impulseData_ != nullptr)
+{
+	startThread(6);
+}
+
+FrontendProcessor::StateLoader::~StateLoader()
+{
+	stopThread(-1);
+	cancelPendingUpdate();
+}
+
+void FrontendProcessor::StateLoader::run()
+{
+	LOG_START("Load images");
+
+	parent.loadImages(hasImageData ? &imageData : nullptr);
+
+	parent.loadImpulses(hasImpulseData ? &impulseData : nullptr);
+
+	if (threadShouldExit())
+		return;
+
+	parent.setSkipCompileAtPresetLoad(true);
+
+	LOG_START("Restoring main container");
+
+	parent.synthChain->restoreFromValueTree(synthData);
+
+	parent.setSkipCompileAtPresetLoad(false);
+
+	if (!threadShouldExit())
+		triggerAsyncUpdate();
+}
+
+void FrontendProcessor::StateLoader::handleAsyncUpdate()
+{
+	parent.restoreFinished(synthData);
 }
 
 const String FrontendProcessor::getName(void) const
@@ -206,6 +237,10 @@ const String FrontendProcessor::getName(void) const
 
 void FrontendProcessor::prepareToPlay(double newSampleRate, int samplesPerBlock)
 {
+	// The chain will be prepared with the current sample rate when the background loader is finished
+	if (isRestoringState())
+		return;
+
     MainController::ScopedSuspender ss(this);
 
 	CHECK_COPY_AND_RETURN_1(synthChain);
@@ -223,6 +258,32 @@ void FrontendProcessor::setCurrentProgram(int /*index*/)
 	return;
 }
 
+void FrontendProcessor::loadImpulses(ValueTree *impulseData)
+{
+	if (impulseData != nullptr)
+	{
+		getSampleManager().getAudioSampleBufferPool()->restoreFromValueTree(*impulseData);
+	}
+	else
+	{
+		File audioResourceFile(ProjectHandler::Frontend::getAppDataDirectory().getChildFile("AudioResources.dat"));
+
+		if (audioResourceFile.existsAsFile())
+		{
+			FileInputStream fis(audioResourceFile);
+
+			LOG_START("Load impulses");
+
+			ValueTree impulseDataFile = ValueTree::readFromStream(fis);
+
+			if (impulseDataFile.isValid())
+			{
+				getSampleManager().getAudioSampleBufferPool()->restoreFromValueTree(impulseDataFile);
+			}
+		}
+	}
+}
+
 void FrontendProcessor::loadImages(ValueTree *imageData)
 {
 #if HISE_IOS
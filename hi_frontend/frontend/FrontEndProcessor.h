@@ -86,6 +86,9 @@ public:
 
 	~FrontendProcessor()
 	{
+		// Stop the background loader before the signal chain is deleted
+		stateLoader = nullptr;
+
 		setEnabledMidiChannels(synthChain->getActiveChannelData()->exportData());
 
 		synthChain = nullptr;
@@ -116,6 +119,18 @@ public:
 	{
 		MemoryOutputStream output(destData, false);
 
+		ValueTree pendingState = getPendingState();
+
+		if (pendingState.isValid())
+		{
+			// The host state hasn't been restored yet, so pass it back unchanged.
+			pendingState.writeToStream(output);
+			return;
+		}
+
+		// The signal chain is still restored in the background, so there's nothing to save yet.
+		if (isRestoringState())
+			return;
 		
 		ValueTree v("ControlData");
 		
@@ -123,6 +138,7 @@ public:
 		
 		v.addChild(getMacroManager().getMidiControlAutomationHandler()->exportAsValueTree(), -1, nullptr);
 
+		// The interface values are exported on every save. They are only a few properties per control, so they are not cached.
 		synthChain->saveInterfaceValues(v);
 		
 		v.setProperty("MidiChannelFilterData", getMainSynthChain()->getActiveChannelData()->exportData(), nullptr);
@@ -138,6 +154,18 @@ public:
 	{
 		ValueTree v = ValueTree::readFromData(data, sizeInBytes);
 
+		if (!v.isValid())
+			return;
+
+		// Restoring the interface values would trigger the callbacks while the samples are still loading...
+		if (setPendingStateIfLoading(v))
+			return;
+
+		restoreDeferredState(v);
+	}
+
+	void restoreDeferredState(const ValueTree& v) override
+	{
 		currentlyLoadedProgram = v.getProperty("Program");
 
 		getMacroManager().getMidiControlAutomationHandler()->restoreFromValueTree(v.getChildWithName("MidiAutomation"));
@@ -248,7 +276,41 @@ public:
 
 private:
 
+	/** Restores the embedded resources and the signal chain on a background thread.
+	*
+	*	The scripts are compiled on the message thread when the thread is finished (just like the PresetLoadingThread in HISE does it).
+	*/
+	class StateLoader : public Thread,
+						public AsyncUpdater
+	{
+	public:
+
+		StateLoader(FrontendProcessor& parent_, const ValueTree& synthData_, ValueTree* imageData_, ValueTree* impulseData_);
+
+		~StateLoader();
+
+		void run() override;
+
+		void handleAsyncUpdate() override;
+
+	private:
+
+		FrontendProcessor& parent;
+
+		ValueTree synthData;
+		ValueTree imageData;
+		ValueTree impulseData;
+
+		bool hasImageData;
+		bool hasImpulseData;
+	};
+
+	/** Called on the message thread after the signal chain was restored. */
+	void restoreFinished(ValueTree& synthData);
+
 	void loadImages(ValueTree *imageData);
+
+	void loadImpulses(ValueTree *impulseData);
 	
 	friend class FrontendProcessorEditor;
 	friend class DefaultFrontendBar;
@@ -271,6 +333,8 @@ private:
 
 	ScopedPointer<AudioSampleBufferPool> audioSampleBufferPool;
 
+	ScopedPointer<StateLoader> stateLoader;
+
 	int currentlyLoadedProgram;
 	
 	int unlockCounter;
@@ -41,10 +41,6 @@ AudioProcessorEditor(fp)
 
 	container->addAndMakeVisible(rootTile = new FloatingTile(fp, nullptr));
 
-	LOG_START("Creating Root Panel");
-
-	rootTile->setNewContent("InterfacePanel");
-    
 	fp->addOverlayListener(this);
 	
 	container->addAndMakeVisible(deactiveOverlay = new DeactiveOverlay());
@@ -82,6 +78,21 @@ AudioProcessorEditor(fp)
 
 	debugLoggerComponent->setVisible(fp->getDebugLogger().isLogging());
 
+	startTimer(4125);
+
+	// The scripts are not compiled yet, so the interface will be created by the FrontendProcessor when it's ready
+	if (!fp->isRestoringState())
+		createInterface();
+}
+
+void FrontendProcessorEditor::createInterface()
+{
+	LOG_START("Creating Root Panel");
+
+	auto fp = dynamic_cast<FrontendProcessor*>(getAudioProcessor());
+
+	rootTile->setNewContent("InterfacePanel");
+
 	auto jsp = JavascriptMidiProcessor::getFirstInterfaceScriptProcessor(fp);
     
     if(jsp != nullptr)
@@ -89,9 +100,6 @@ AudioProcessorEditor(fp)
         setSize(jsp->getScriptingContent()->getContentWidth(), jsp->getScriptingContent()->getContentHeight());
 
     }
-    
-	
-	startTimer(4125);
 
 	originalSizeX = getWidth();
 	originalSizeY = getHeight();
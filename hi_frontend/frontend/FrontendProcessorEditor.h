@@ -101,6 +101,9 @@ public:
 
 	void resized() override;
 
+	/** Creates the interface panel. If the editor is opened while the signal chain is restored, this is called when the loading is finished. */
+	void createInterface();
+
 	void resetInterface()
 	{
 		//interfaceComponent->checkInterfaces();
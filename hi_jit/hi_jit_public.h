@@ -85,6 +85,9 @@ public:
 
 	int isBufferOverflow(int globalIndex) const;
 
+	/** Returns the size of the machine code of all compiled functions in bytes. */
+	int getCodeSize() const;
+
 
 	/** Use this to set a global variable from the outside world. 
 	*
@@ -140,6 +143,8 @@ private:
 *	- strictly typed, parser throws an error for type mismatches (enforces casts)
 *	- define functions which can be called from C++ or from other JITted functions
 *	- use common inbuilt functions like powf, sin, cos, etc.
+*	- use `#define MATH_ACCURACY 1` (accurate) or `2` (fast) to inline approximations of sinf, cosf, expf, tanhf and powf
+*	- constant expressions are simplified and repeated float subexpressions reused (`#define OPTIMIZE 0` disables this)
 *	- use local variables without runtime penalties
 *	- call functions with max two parameters
 *	- simple branching using the a ? b : c logic
@@ -271,6 +276,109 @@ private:
 };
 
 
+/** This class wraps a JIT compiler to render polyphonic modulation signals or voices.
+*
+*	In order to use it, define these functions:
+*
+*		void init(); // setup your global variables
+*		void prepareToPlay(double sampleRate, int blockSize); // initialise the processing
+*		void startVoice(int voiceIndex, int noteNumber); // reset the state of the given voice
+*		void stopVoice(int voiceIndex); // start the release of the given voice
+*		float process(int voiceIndex); // calculate the next sample of the given voice
+*
+*	Optionally, you can define
+*
+*		int isActive(int voiceIndex); // return 0 as soon as the voice is silent (eg. after the release phase)
+*
+*	If you don't define this function, a voice is considered active until stopVoice() is called.
+*
+*	Every non-const Buffer that is declared without a size (eg. `Buffer phase;`) will be treated as per-voice state array:
+*	the host allocates it with one slot per voice when calling prepareVoices(), so you can use `phase[voiceIndex]` to
+*	store the state of each voice. All other globals are shared between the voices.
+*
+*	From C++, you can then call renderVoice() (for oscillators and envelopes) or applyToVoice() (for modulators that
+*	scale an existing signal) and it will iterate over the float array and call the processing function for each sample.
+*/
+class HiseJITVoiceModule : public juce::DynamicObject
+{
+public:
+
+	/** Creates a new module using the code of the given compiler. */
+	HiseJITVoiceModule(const HiseJITCompiler* compiler);
+
+	/** Calls the defined init() function if compiled correctly. */
+	void init();
+
+	/** Calls the defined prepareToPlay function if compiled correctly. */
+	void prepareToPlay(double sampleRate, int samplesPerBlock);
+
+	/** Allocates the per-voice state arrays for the given amount of voices. 
+	*
+	*	Call this from the message thread before processing. The state of all voices will be cleared.
+	*/
+	void prepareVoices(int numVoicesToAllocate);
+
+	/** Returns the number of voices that were allocated with prepareVoices(). */
+	int getNumVoices() const noexcept { return numVoices; }
+
+	/** Calls the defined startVoice function and marks the voice as active. */
+	void startVoice(int voiceIndex, int noteNumber);
+
+	/** Calls the defined stopVoice function. */
+	void stopVoice(int voiceIndex);
+
+	/** Checks if the voice is still active. This uses the isActive function if it is defined. */
+	bool isVoiceActive(int voiceIndex) const;
+
+	/** Calls the process function for the given voice and writes the result into the buffer. */
+	void renderVoice(int voiceIndex, float* data, int numSamples);
+
+	/** Calls the process function for the given voice and multiplies the buffer with the result. */
+	void applyToVoice(int voiceIndex, float* data, int numSamples);
+
+	/** Returns the HiseJITScope of this module. You can use it to hook it up to another scripting language. */
+	HiseJITScope* getScope();
+
+	/** Returns the HiseJITScope of this module. You can use it to hook it up to another scripting language. */
+	const HiseJITScope* getScope() const;
+
+	void enableOverflowCheck(bool shouldCheckForOverflow);
+
+	bool allOK() const;
+
+private:
+
+	void updateActiveState(int voiceIndex);
+
+	typedef float(*voiceFunction)(int);
+	typedef void(*startFunction)(int, int);
+	typedef void(*stopFunction)(int);
+	typedef int(*activeFunction)(int);
+	typedef void(*initFunction)();
+	typedef void(*prepareFunction)(double, int);
+
+	HiseJITScope::Ptr scope;
+
+	voiceFunction pf = nullptr;
+	startFunction startf = nullptr;
+	stopFunction stopf = nullptr;
+	activeFunction activef = nullptr;
+	prepareFunction pp = nullptr;
+	initFunction initf = nullptr;
+
+	juce::Array<int> voiceStateIndexes;
+	juce::HeapBlock<bool> activeVoices;
+	int numVoices = 0;
+
+	bool compiledOk = false;
+	bool allFunctionsDefined = false;
+
+	bool overFlowCheckEnabled = false;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HiseJITVoiceModule)
+};
+
+
 struct JITTest
 {
 	static float test();
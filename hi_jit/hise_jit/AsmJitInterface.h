@@ -1396,6 +1396,267 @@ struct AsmJitHelpers
 		return new TypedNode<ReturnType>(r);
 	}
 
+	/** Emits inlined versions of the inbuilt float math functions.
+	*
+	*	This avoids the register spilling of the external function call. The argument is reduced to a small range and then
+	*	evaluated with a minimax polynomial whose degree depends on the MathAccuracy. sqrtf and fabsf are always inlined
+	*	because they map to a single exact instruction.
+	*
+	*	The inlined powf is only defined for positive bases.
+	*/
+	struct InlineMath
+	{
+		/** Returns the result node or nullptr if the function should be called instead. */
+		static TypedNode<float>* emit(X86Compiler& cc, const Identifier& id, BaseNode* p1, MathAccuracy accuracy)
+		{
+			static const Identifier sqrtf_("sqrtf");
+			static const Identifier fabsf_("fabsf");
+			static const Identifier sinf_("sinf");
+			static const Identifier cosf_("cosf");
+			static const Identifier expf_("expf");
+			static const Identifier tanhf_("tanhf");
+
+			if (id == sqrtf_)	return emitSqrt(cc, p1);
+			if (id == fabsf_)	return emitAbs(cc, p1);
+
+			if (accuracy == MathAccuracy::Precise)
+				return nullptr;
+
+			if (id == sinf_)	return emitSin(cc, p1, accuracy, false);
+			if (id == cosf_)	return emitSin(cc, p1, accuracy, true);
+			if (id == expf_)	return emitExp(cc, p1, accuracy);
+			if (id == tanhf_)	return emitTanh(cc, p1, accuracy);
+
+			return nullptr;
+		}
+
+		/** Returns the result node or nullptr if the function should be called instead. */
+		static TypedNode<float>* emit(X86Compiler& cc, const Identifier& id, BaseNode* p1, BaseNode* p2, MathAccuracy accuracy)
+		{
+			static const Identifier powf_("powf");
+
+			if (accuracy == MathAccuracy::Precise)
+				return nullptr;
+
+			if (id == powf_)	return emitPow(cc, p1, p2, accuracy);
+
+			return nullptr;
+		}
+
+	private:
+
+		static X86Xmm load(X86Compiler& cc, BaseNode* node)
+		{
+			X86Xmm x = cc.newXmmSs();
+			BinaryOpInstructions::Float::store(cc, x, node);
+			return x;
+		}
+
+		static X86Mem constant(X86Compiler& cc, float value)
+		{
+			return cc.newFloatConst(kConstScopeLocal, value);
+		}
+
+		/** Evaluates the polynomial with the Horner scheme. The coefficients start with the lowest order. */
+		static X86Xmm polynomial(X86Compiler& cc, X86Xmm x, const float* coefficients, int numCoefficients)
+		{
+			X86Xmm result = cc.newXmmSs();
+
+			cc.movss(result, constant(cc, coefficients[numCoefficients - 1]));
+
+			for (int i = numCoefficients - 2; i >= 0; i--)
+			{
+				cc.mulss(result, x);
+				cc.addss(result, constant(cc, coefficients[i]));
+			}
+
+			return result;
+		}
+
+		/** Calculates 2^t. The input register will be modified. */
+		static X86Xmm emitExp2(X86Compiler& cc, X86Xmm t, MathAccuracy accuracy)
+		{
+			static const float fastCoefficients[] = { 9.999280736e-01f, 6.932609862e-01f, 2.426111219e-01f, 5.517166493e-02f };
+			static const float accurateCoefficients[] = { 1.000000072e+00f, 6.931469671e-01f, 2.402211972e-01f, 5.550713275e-02f, 9.675541331e-03f, 1.327647152e-03f };
+
+			cc.maxss(t, constant(cc, -126.0f));
+			cc.minss(t, constant(cc, 127.0f));
+
+			// split into the integer part k and the fraction in [-0.5, 0.5]
+			X86Gp k = cc.newInt32();
+			X86Xmm kf = cc.newXmmSs();
+
+			cc.cvtss2si(k, t);
+			cc.cvtsi2ss(kf, k);
+			cc.subss(t, kf);
+
+			X86Xmm result = accuracy == MathAccuracy::Fast ? polynomial(cc, t, fastCoefficients, numElementsInArray(fastCoefficients)) :
+															 polynomial(cc, t, accurateCoefficients, numElementsInArray(accurateCoefficients));
+
+			// 2^k is created directly from the exponent bits
+			X86Xmm scale = cc.newXmmSs();
+
+			cc.add(k, 127);
+			cc.shl(k, 23);
+			cc.movd(scale, k);
+			cc.mulss(result, scale);
+
+			return result;
+		}
+
+		/** Calculates log2(x) for positive x. */
+		static X86Xmm emitLog2(X86Compiler& cc, X86Xmm x, MathAccuracy accuracy)
+		{
+			static const float fastCoefficients[] = { 1.442613208e+00f, -7.169873988e-01f, 4.418987508e-01f, -2.271193222e-01f, 5.965148405e-02f };
+			static const float accurateCoefficients[] = { 1.442694761e+00f, -7.213100880e-01f, 4.800636936e-01f, -3.533948102e-01f, 2.560096697e-01f, -1.553518025e-01f, 6.360784182e-02f, -1.231945922e-02f };
+
+			// split into the exponent and the mantissa in [1, 2)
+			X86Gp bits = cc.newInt32();
+			X86Gp exponent = cc.newInt32();
+
+			cc.movd(bits, x);
+			cc.mov(exponent, bits);
+			cc.shr(exponent, 23);
+			cc.sub(exponent, 127);
+			cc.and_(bits, 0x007fffff);
+			cc.or_(bits, 0x3f800000);
+
+			X86Xmm f = cc.newXmmSs();
+
+			cc.movd(f, bits);
+			cc.subss(f, constant(cc, 1.0f));
+
+			X86Xmm result = accuracy == MathAccuracy::Fast ? polynomial(cc, f, fastCoefficients, numElementsInArray(fastCoefficients)) :
+															 polynomial(cc, f, accurateCoefficients, numElementsInArray(accurateCoefficients));
+
+			X86Xmm exponentFloat = cc.newXmmSs();
+
+			cc.mulss(result, f);
+			cc.cvtsi2ss(exponentFloat, exponent);
+			cc.addss(result, exponentFloat);
+
+			return result;
+		}
+
+		static TypedNode<float>* emitSin(X86Compiler& cc, BaseNode* p1, MathAccuracy accuracy, bool isCosine)
+		{
+			static const float fastCoefficients[] = { 9.998919335e-01f, -1.659602841e-01f, 7.602955427e-03f };
+			static const float accurateCoefficients[] = { 9.999999947e-01f, -1.666665669e-01f, 8.333025182e-03f, -1.980742098e-04f, 2.601907024e-06f };
+
+			// pi split into an exact high part and the remainder to keep the range reduction accurate
+			static const float piHi = 3.140625f;
+			static const float piLo = 9.67653589793e-4f;
+
+			X86Xmm x = load(cc, p1);
+			X86Xmm t = cc.newXmmSs();
+			X86Xmm t2 = cc.newXmmSs();
+			X86Gp k = cc.newInt32();
+
+			// x = r + k * pi with r in [-pi/2, pi/2], so sin(x) = (-1)^k * sin(r).
+			// The cosine uses x = r + (k - 0.5) * pi, which yields the same sign rule.
+			cc.movss(t, x);
+			cc.mulss(t, constant(cc, 1.0f / float_Pi));
+
+			if (isCosine)
+				cc.addss(t, constant(cc, 0.5f));
+
+			cc.cvtss2si(k, t);
+			cc.cvtsi2ss(t, k);
+
+			if (isCosine)
+				cc.subss(t, constant(cc, 0.5f));
+
+			cc.movss(t2, t);
+			cc.mulss(t2, constant(cc, piHi));
+			cc.subss(x, t2);
+			cc.mulss(t, constant(cc, piLo));
+			cc.subss(x, t);
+
+			X86Xmm r2 = cc.newXmmSs();
+
+			cc.movss(r2, x);
+			cc.mulss(r2, x);
+
+			X86Xmm result = accuracy == MathAccuracy::Fast ? polynomial(cc, r2, fastCoefficients, numElementsInArray(fastCoefficients)) :
+															 polynomial(cc, r2, accurateCoefficients, numElementsInArray(accurateCoefficients));
+
+			cc.mulss(result, x);
+
+			// flip the sign bit if k is odd
+			X86Xmm sign = cc.newXmmSs();
+
+			cc.shl(k, 31);
+			cc.movd(sign, k);
+			cc.xorps(result, sign);
+
+			return new TypedNode<float>(result);
+		}
+
+		static TypedNode<float>* emitExp(X86Compiler& cc, BaseNode* p1, MathAccuracy accuracy)
+		{
+			X86Xmm x = load(cc, p1);
+
+			cc.mulss(x, constant(cc, 1.442695041f)); // log2(e)
+
+			return new TypedNode<float>(emitExp2(cc, x, accuracy));
+		}
+
+		static TypedNode<float>* emitTanh(X86Compiler& cc, BaseNode* p1, MathAccuracy accuracy)
+		{
+			// tanh(x) = 1 - 2 / (e^2x + 1)
+			X86Xmm x = load(cc, p1);
+
+			cc.mulss(x, constant(cc, 2.0f * 1.442695041f));
+
+			X86Xmm e = emitExp2(cc, x, accuracy);
+			X86Xmm q = cc.newXmmSs();
+			X86Xmm result = cc.newXmmSs();
+
+			cc.addss(e, constant(cc, 1.0f));
+			cc.movss(q, constant(cc, 2.0f));
+			cc.divss(q, e);
+			cc.movss(result, constant(cc, 1.0f));
+			cc.subss(result, q);
+
+			return new TypedNode<float>(result);
+		}
+
+		static TypedNode<float>* emitPow(X86Compiler& cc, BaseNode* base, BaseNode* exponent, MathAccuracy accuracy)
+		{
+			// x^y = 2^(y * log2(x))
+			X86Xmm l = emitLog2(cc, load(cc, base), accuracy);
+
+			BinaryOpInstructions::Float::mul(cc, l, exponent);
+
+			return new TypedNode<float>(emitExp2(cc, l, accuracy));
+		}
+
+		static TypedNode<float>* emitSqrt(X86Compiler& cc, BaseNode* p1)
+		{
+			X86Xmm result = cc.newXmmSs();
+
+			if (p1->isMemoryLocation())
+				cc.sqrtss(result, p1->getAsMemoryLocation());
+			else
+				cc.sqrtss(result, p1->getAsFloatingPointRegister());
+
+			return new TypedNode<float>(result);
+		}
+
+		static TypedNode<float>* emitAbs(X86Compiler& cc, BaseNode* p1)
+		{
+			X86Xmm x = load(cc, p1);
+			X86Xmm mask = cc.newXmmSs();
+			X86Gp maskBits = cc.newInt32();
+
+			cc.mov(maskBits, 0x7fffffff);
+			cc.movd(mask, maskBits);
+			cc.andps(x, mask);
+
+			return new TypedNode<float>(x);
+		}
+	};
+
 	template <typename SourceType, typename TargetType> static TypedNode<TargetType>* EmitCast(X86Compiler& cc, TypedNode<SourceType>* source)
 	{
 		if (typeid(SourceType) == typeid(TargetType))
@@ -1501,6 +1762,22 @@ struct AsmJitHelpers
 		cc.dec(op->getAsGenericRegister());
 	};
 
+	/** Multiplies the integer with 2^amount using a shift into a new register. */
+	static TypedNode<int>* ShiftLeft(X86Compiler& cc, TypedNode<int>* op, int amount)
+	{
+		asmjit::Error error;
+
+		X86Gp dest = cc.newInt32();
+
+		error = BinaryOpInstructions::Int::store(cc, dest, op);
+		ASSERT_ASM_OK;
+
+		error = cc.shl(dest.as<BinaryOpInstructions::Int::IntRegisterType>(), amount);
+		ASSERT_ASM_OK;
+
+		return new TypedNode<int>(dest);
+	}
+
 
 	template <typename T> static void Return(X86Compiler&cc, TypedNode<T>* returnNode)
 	{
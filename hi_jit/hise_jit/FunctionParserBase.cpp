@@ -117,6 +117,7 @@ FunctionParserBase::FunctionParserBase(HiseJITScope::Pimpl* scope_, const Functi
 void FunctionParserBase::parseFunctionBody()
 {
 	lines.clear();
+	invalidateSubexpressions();
 
 	while (currentType != HiseJitTokens::eof && currentType != HiseJitTokens::closeBrace)
 	{
@@ -232,6 +233,8 @@ TYPED_VOID FunctionParserBase::parseLineAssignment(AsmJitHelpers::BaseNode* l)
 
 	Identifier id = parseIdentifier();
 
+	invalidateSubexpressions();
+
 	bool isPostDec = matchIf(HiseJitTokens::minusminus);
 	bool isPostInc = matchIf(HiseJitTokens::plusplus);
 
@@ -363,6 +366,9 @@ BaseNodePtr FunctionParserBase::parseTernaryOperator()
 
 	if (matchIf(HiseJitTokens::question))
 	{
+		// the branches are conditional code, so their results can't be reused outside
+		invalidateSubexpressions();
+
 		auto conditionTyped = getTypedNode<BooleanType>(condition);
 
 		if (conditionTyped != nullptr)
@@ -382,6 +388,8 @@ BaseNodePtr FunctionParserBase::parseTernaryOperator()
 					ScopedBaseNodePointer falseBranch = parseExpression();
 					asmCompiler->bind(skipFalse);
 
+					invalidateSubexpressions();
+
 					return trueBranch.release();
 				}
 				else
@@ -393,6 +401,8 @@ BaseNodePtr FunctionParserBase::parseTernaryOperator()
 					asmCompiler->bind(skipTrue);
 					match(HiseJitTokens::colon);
 
+					invalidateSubexpressions();
+
 					ScopedBaseNodePointer falseBranch = parseExpression();
 					
 					return falseBranch.release();
@@ -423,6 +433,8 @@ BaseNodePtr FunctionParserBase::parseTernaryOperator()
 			ASSERT_ASM_OK;
 
 			ScopedBaseNodePointer left = parseExpression();
+
+			invalidateSubexpressions();
 			
 			if (HiseJITTypeHelpers::matchesType<int>(left->getType()))				AsmJitHelpers::BinaryOpInstructions::Int::store(*asmCompiler, intResult, left);
 			else if (HiseJITTypeHelpers::matchesType<float>(left->getType()))		AsmJitHelpers::BinaryOpInstructions::Float::store(*asmCompiler, floatResult, left);
@@ -440,6 +452,8 @@ BaseNodePtr FunctionParserBase::parseTernaryOperator()
 			ASSERT_ASM_OK;
 
 			ScopedBaseNodePointer right = parseExpression();
+
+			invalidateSubexpressions();
 			
 			if (HiseJITTypeHelpers::matchesType<int>(right->getType()))				AsmJitHelpers::BinaryOpInstructions::Int::store(*asmCompiler, intResult, right);
 			else if (HiseJITTypeHelpers::matchesType<float>(right->getType()))		AsmJitHelpers::BinaryOpInstructions::Float::store(*asmCompiler, floatResult, right);
@@ -659,6 +673,8 @@ BaseNodePtr FunctionParserBase::parseSymbol()
 	else if (auto b = scope->getExposedFunction(symbolId))	return parseFunctionCall(b);
 	else if (auto cf = scope->getCompiledBaseFunction(symbolId))
 	{
+		invalidateSubexpressions();
+
 #define MATCH_TYPE_AND_RETURN(type) if(HiseJITTypeHelpers::matchesType<type>(cf->getReturnType())) return parseFunctionCall(cf);
 
 		MATCH_TYPE_AND_RETURN(int);
@@ -735,6 +751,31 @@ BaseNodePtr FunctionParserBase::createBinaryNode(BaseNodePtr a, BaseNodePtr b, T
 
 template <typename T> BaseNodePtr FunctionParserBase::createTypedBinaryNode(TypedNodePtr left, TypedNodePtr right, TokenType op)
 {
+	if (info.optimize && !(left->isImmediateValue() && right->isImmediateValue()))
+	{
+		if (auto simplified = simplifyBinaryNode<T>(left, right, op))
+			return simplified;
+
+		const String key = getSubexpressionKey<T>(left, right, op);
+
+		if (key.isNotEmpty())
+		{
+			if (auto cached = getCachedSubexpression(key))
+				return cached;
+
+			BaseNodePtr result = nullptr;
+
+			if (op == HiseJitTokens::plus)			result = AsmJitHelpers::EmitBinaryOp<AsmJitHelpers::Add>(*asmCompiler, left, right);
+			else if (op == HiseJitTokens::minus)	result = AsmJitHelpers::EmitBinaryOp<AsmJitHelpers::Sub>(*asmCompiler, left, right);
+			else if (op == HiseJitTokens::times)	result = AsmJitHelpers::EmitBinaryOp<AsmJitHelpers::Mul>(*asmCompiler, left, right);
+			else									result = AsmJitHelpers::EmitBinaryOp<AsmJitHelpers::Div>(*asmCompiler, left, right);
+
+			cacheSubexpression(key, result);
+
+			return result;
+		}
+	}
+
 	if (left->isImmediateValue() && right->isImmediateValue())
 	{
 		if (op == HiseJitTokens::plus)
@@ -868,6 +909,118 @@ template <typename T> BaseNodePtr FunctionParserBase::createTypedBinaryNode(Type
 	return nullptr;
 }
 
+template <typename T> BaseNodePtr FunctionParserBase::simplifyBinaryNode(TypedNodePtr left, TypedNodePtr right, TokenType op)
+{
+	const bool isInteger = AsmJitHelpers::isInt<T>();
+	const bool isFloatingPoint = AsmJitHelpers::isFloat<T>() || AsmJitHelpers::isDouble<T>();
+
+	if (!isInteger && !isFloatingPoint)
+		return nullptr;
+
+	auto isConstant = [](TypedNodePtr n, double value) { return n->isImmediateValue() && (double)n->template getImmediateValue<T>() == value; };
+
+	auto getPowerOfTwoExponent = [](TypedNodePtr n)
+	{
+		if (!n->isImmediateValue())
+			return 0;
+
+		int exponent = 0;
+		const double mantissa = std::frexp((double)n->template getImmediateValue<T>(), &exponent);
+
+		return mantissa == 0.5 ? exponent - 1 : 0;
+	};
+
+	// x * 1, x - 0, x / 1 (and x + 0 for integers, because -0.0f + 0.0f is not -0.0f)
+	if (op == HiseJitTokens::times && isConstant(right, 1.0))	return left->clone();
+	if (op == HiseJitTokens::times && isConstant(left, 1.0))	return right->clone();
+	if (op == HiseJitTokens::minus && isConstant(right, 0.0))	return left->clone();
+	if (op == HiseJitTokens::divide && isConstant(right, 1.0))	return left->clone();
+
+	if (isInteger)
+	{
+		if (op == HiseJitTokens::plus && isConstant(right, 0.0))	return left->clone();
+		if (op == HiseJitTokens::plus && isConstant(left, 0.0))		return right->clone();
+
+		if (op == HiseJitTokens::times)
+		{
+			if (isConstant(left, 0.0) || isConstant(right, 0.0))
+				return AsmJitHelpers::Immediate<T>(*asmCompiler, (T)0);
+
+			// strength reduction: x * 2^n -> x << n
+			if (const int exponent = getPowerOfTwoExponent(right))
+				if (exponent > 0) return AsmJitHelpers::ShiftLeft(*asmCompiler, getTypedNode<int>(left), exponent);
+
+			if (const int exponent = getPowerOfTwoExponent(left))
+				if (exponent > 0) return AsmJitHelpers::ShiftLeft(*asmCompiler, getTypedNode<int>(right), exponent);
+		}
+	}
+	else if (op == HiseJitTokens::divide && getPowerOfTwoExponent(right) != 0)
+	{
+		// strength reduction: x / 2^n -> x * 2^-n (exact because the reciprocal is a power of two too)
+		ScopedPointer<AsmJitHelpers::TypedNode<T>> reciprocal = AsmJitHelpers::Immediate<T>(*asmCompiler, (T)1 / right->template getImmediateValue<T>());
+
+		return AsmJitHelpers::EmitBinaryOp<AsmJitHelpers::Mul>(*asmCompiler, left, reciprocal.get());
+	}
+
+	return nullptr;
+}
+
+template <typename T> String FunctionParserBase::getSubexpressionKey(TypedNodePtr left, TypedNodePtr right, TokenType op) const
+{
+	if (!AsmJitHelpers::isFloat<T>() && !AsmJitHelpers::isDouble<T>())
+		return String();
+
+	if (op != HiseJitTokens::plus && op != HiseJitTokens::minus && op != HiseJitTokens::times && op != HiseJitTokens::divide)
+		return String();
+
+	// only named values (parameters, locals and globals) and constants can be identified
+	auto getOperandKey = [](TypedNodePtr n)
+	{
+		if (n->isImmediateValue())
+		{
+			const double value = (double)n->template getImmediateValue<T>();
+			return "#" + String::toHexString(*reinterpret_cast<const int64*>(&value));
+		}
+
+		return n->getId().isNull() ? String() : n->getId().toString();
+	};
+
+	String a = getOperandKey(left);
+	String b = getOperandKey(right);
+
+	if (a.isEmpty() || b.isEmpty())
+		return String();
+
+	const bool isCommutative = op == HiseJitTokens::plus || op == HiseJitTokens::times;
+
+	if (isCommutative && b < a)
+		std::swap(a, b);
+
+	return a + String(op) + b;
+}
+
+BaseNodePtr FunctionParserBase::getCachedSubexpression(const String& key)
+{
+	const int index = subexpressionKeys.indexOf(key);
+
+	return index != -1 ? subexpressionNodes[index]->clone() : nullptr;
+}
+
+void FunctionParserBase::cacheSubexpression(const String& key, BaseNodePtr node)
+{
+	// naming the result prevents the register from being reused as destination of another operation
+	node->setId(Identifier("_cse" + String(subexpressionNodes.size())));
+
+	subexpressionKeys.add(key);
+	subexpressionNodes.add(node->clone());
+}
+
+void FunctionParserBase::invalidateSubexpressions()
+{
+	subexpressionKeys.clear();
+	subexpressionNodes.clear();
+}
+
 TYPED_NODE FunctionParserBase::getTypedNode(BaseNodePtr node)
 {
 	auto r = dynamic_cast<TypedNodePtr>(node);
@@ -1532,6 +1685,12 @@ template <typename R, typename ParamType> BaseNodePtr FunctionParserBase::parseF
 
 		if (p1 != nullptr)
 		{
+			if (AsmJitHelpers::isFloat<R>() && AsmJitHelpers::isFloat<ParamType>() && scope->getExposedFunction(b->functionName) == b)
+			{
+				if (auto inlined = AsmJitHelpers::InlineMath::emit(*asmCompiler, b->functionName, p1, info.mathAccuracy))
+					return inlined;
+			}
+
 			return AsmJitHelpers::Call1<R, ParamType>(*asmCompiler, (void*)function, p1);
 		}
 		else
@@ -1576,6 +1735,12 @@ template <typename R, typename ParamType1, typename ParamType2> BaseNodePtr Func
 			location.throwError("Parameter 2: Type mismatch. Expected: " + HiseJITTypeHelpers::getTypeName<ParamType2>());
 		}
 
+		if (AsmJitHelpers::isFloat<R>() && AsmJitHelpers::isFloat<ParamType1>() && AsmJitHelpers::isFloat<ParamType2>() && scope->getExposedFunction(b->functionName) == b)
+		{
+			if (auto inlined = AsmJitHelpers::InlineMath::emit(*asmCompiler, b->functionName, p1, p2, info.mathAccuracy))
+				return inlined;
+		}
+
 		return AsmJitHelpers::Call2<R, ParamType1, ParamType2>(*asmCompiler, (void*)function, p1, p2);
 	}
 	else
@@ -1611,6 +1776,8 @@ void FunctionParserBase::parseGlobalAssignment(GlobalBase* g)
 
 	parseIdentifier();
 
+	invalidateSubexpressions();
+
 	bool isPostDec = matchIf(HiseJitTokens::minusminus);
 	bool isPostInc = matchIf(HiseJitTokens::plusplus);
 
@@ -127,6 +127,13 @@ private:
 
 	template <typename T> BaseNodePtr createTypedBinaryNode(TypedNodePtr a, TypedNodePtr b, TokenType op);
 
+	template <typename T> BaseNodePtr simplifyBinaryNode(TypedNodePtr a, TypedNodePtr b, TokenType op);
+
+	template <typename T> String getSubexpressionKey(TypedNodePtr a, TypedNodePtr b, TokenType op) const;
+	BaseNodePtr getCachedSubexpression(const String& key);
+	void cacheSubexpression(const String& key, BaseNodePtr node);
+	void invalidateSubexpressions();
+
 	
 
 	TYPED_NODE getCastedNode(BaseNodePtr node);
@@ -194,6 +201,10 @@ private:
 	//ScopedPointer<MissingOperatorFunctions> missingOperatorFunctions;
 	OwnedArray<AsmJitHelpers::BaseNode> lines;
 
+	/** The results of floating point operations that can be reused until one of their operands changes. */
+	StringArray subexpressionKeys;
+	OwnedArray<AsmJitHelpers::BaseNode> subexpressionNodes;
+
 	//Array<BaseNodePtr> anonymousLines;
 
 	JitCompiler*  asmCompiler;
@@ -59,6 +59,16 @@ public:
 						useSafeBufferFunctions = false;
 					}
 
+					if (name == "MATH_ACCURACY")
+					{
+						mathAccuracy = (MathAccuracy)jlimit<int>(0, (int)MathAccuracy::numMathAccuracyLevels - 1, value.getIntValue());
+					}
+
+					if (name == "OPTIMIZE")
+					{
+						optimize = value.getIntValue() != 0;
+					}
+
 					for (int j = i; j < lines.size(); j++)
 					{
 						lines.set(j, lines[j].replace(name, value));
@@ -145,9 +155,21 @@ public:
 		return useSafeBufferFunctions;
 	}
 
+	MathAccuracy getMathAccuracy() const
+	{
+		return mathAccuracy;
+	}
+
+	bool shouldOptimize() const
+	{
+		return optimize;
+	}
+
 private:
 
 	bool useSafeBufferFunctions = true;
+	MathAccuracy mathAccuracy = MathAccuracy::Precise;
+	bool optimize = true;
 
 	const String& code;
 
@@ -167,11 +189,13 @@ public:
 		numPrivacyModes
 	};
 
-	GlobalParser(const String& code, HiseJITScope* scope_, bool useSafeBufferFunctions_, bool useCppMode_=true) :
+	GlobalParser(const String& code, HiseJITScope* scope_, bool useSafeBufferFunctions_, bool useCppMode_=true, MathAccuracy mathAccuracy_=MathAccuracy::Precise, bool optimize_=true) :
 		ParserHelpers::TokenIterator(code.getCharPointer()),
 		scope(scope_->pimpl),
 		useSafeBufferFunctions(useSafeBufferFunctions_),
-		useCppMode(useCppMode_)
+		useCppMode(useCppMode_),
+		mathAccuracy(mathAccuracy_),
+		optimize(optimize_)
 	{
 
 	}
@@ -405,6 +429,8 @@ public:
 		info->id = id;
 		info->program = location.program;
 		info->useSafeBufferFunctions = useSafeBufferFunctions;
+		info->mathAccuracy = mathAccuracy;
+		info->optimize = optimize;
 		info->addVoidReturnStatement = addVoidReturnStatement;
 		info->lineType = typeid(LineType);
 
@@ -515,6 +541,7 @@ public:
 		compiler = nullptr;
 
 		ReturnType(*fn)();
+		scope->codeSize += code->getCodeSize();
 		scope->runtime->add(&fn, code);
 
 		//DBG(l->getString());
@@ -554,6 +581,7 @@ public:
 			compiler = nullptr;
 
 			ReturnType(*fn)(Param1Type);
+			scope->codeSize += code->getCodeSize();
 			scope->runtime->add(&fn, code);
 
 			code = nullptr;
@@ -601,6 +629,7 @@ public:
 			compiler = nullptr;
 
 			ReturnType(*fn)(Param1Type, Param2Type);
+			scope->codeSize += code->getCodeSize();
 			scope->runtime->add(&fn, code);
 
 			code = nullptr;
@@ -629,6 +658,8 @@ private:
 
 	bool useSafeBufferFunctions;
 	bool useCppMode;
+	MathAccuracy mathAccuracy;
+	bool optimize;
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GlobalParser)
 };
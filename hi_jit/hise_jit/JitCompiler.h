@@ -24,7 +24,9 @@ public:
 		code(preprocessor.process()),
 		compiledOK(false),
 		useSafeFunctions(preprocessor.shouldUseSafeBufferFunctions()),
-		useCppMode(useCppMode_)
+		useCppMode(useCppMode_),
+		mathAccuracy(preprocessor.getMathAccuracy()),
+		optimize(preprocessor.shouldOptimize())
 	{
 
 	};
@@ -36,7 +38,7 @@ public:
 
 		ScopedPointer<HiseJITScope> scope = new HiseJITScope();
 
-		GlobalParser globalParser(code, scope, useSafeFunctions, useCppMode);
+		GlobalParser globalParser(code, scope, useSafeFunctions, useCppMode, mathAccuracy, optimize);
 
 		try
 		{
@@ -96,6 +98,8 @@ private:
 
 	bool useSafeFunctions;
 	bool useCppMode;
+	MathAccuracy mathAccuracy;
+	bool optimize;
 };
 
 
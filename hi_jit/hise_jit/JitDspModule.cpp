@@ -1,6 +1,19 @@
 
 
 
+static void throwIfBufferOverflow(const HiseJITScope* scope)
+{
+	for (int i = 0; i < scope->getNumGlobalVariables(); i++)
+	{
+		const int overflowIndex = scope->isBufferOverflow(i);
+
+		if (overflowIndex != -1)
+		{
+			throw String("Buffer overflow for " + scope->getGlobalVariableName(i) + " at index " + String(overflowIndex));
+		}
+	}
+}
+
 HiseJITDspModule::HiseJITDspModule(const HiseJITCompiler* compiler)
 {
 	scope = compiler->compileAndReturnScope();
@@ -60,15 +73,7 @@ void HiseJITDspModule::processBlock(float* data, int numSamples)
 		if (overFlowCheckEnabled)
 		{
 			overflowIndex = -1;
-
-			for (int i = 0; i < scope->getNumGlobalVariables(); i++)
-			{
-				overflowIndex = jmax<int>(overflowIndex, scope->isBufferOverflow(i));
-				if (overflowIndex != -1)
-				{
-					throw String("Buffer overflow for " + scope->getGlobalVariableName(i) + " at index " + String(overflowIndex));
-				}
-			}
+			throwIfBufferOverflow(scope);
 		}
 	}
 
@@ -84,4 +89,164 @@ void HiseJITDspModule::enableOverflowCheck(bool shouldCheckForOverflow)
 {
 	overFlowCheckEnabled = shouldCheckForOverflow;
 	overflowIndex = -1;
-}
\ No newline at end of file
+}
+
+
+HiseJITVoiceModule::HiseJITVoiceModule(const HiseJITCompiler* compiler)
+{
+	scope = compiler->compileAndReturnScope();
+
+	static const Identifier proc("process");
+	static const Identifier prep("prepareToPlay");
+	static const Identifier init_("init");
+	static const Identifier start("startVoice");
+	static const Identifier stop("stopVoice");
+	static const Identifier active("isActive");
+
+	compiledOk = compiler->wasCompiledOK();
+
+	if (compiledOk)
+	{
+		pf = scope->getCompiledFunction<float, int>(proc);
+		initf = scope->getCompiledFunction<void>(init_);
+		pp = scope->getCompiledFunction<void, double, int>(prep);
+		startf = scope->getCompiledFunction<void, int, int>(start);
+		stopf = scope->getCompiledFunction<void, int>(stop);
+
+		// optional, so it doesn't count for allFunctionsDefined
+		activef = scope->getCompiledFunction<int, int>(active);
+
+		allFunctionsDefined = pf != nullptr && pp != nullptr && initf != nullptr && startf != nullptr && stopf != nullptr;
+
+		for (int i = 0; i < scope->getNumGlobalVariables(); i++)
+		{
+			if (HiseJITTypeHelpers::matchesType<Buffer*>(scope->getGlobalVariableType(i)))
+			{
+				auto b = scope->getGlobalVariableValue(i).getBuffer();
+
+				if (b == nullptr || b->size == 0)
+					voiceStateIndexes.add(i);
+			}
+		}
+	}
+}
+
+void HiseJITVoiceModule::init()
+{
+	if (allOK())
+	{
+		initf();
+	}
+}
+
+void HiseJITVoiceModule::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+	if (allOK())
+	{
+		pp(sampleRate, samplesPerBlock);
+	}
+}
+
+void HiseJITVoiceModule::prepareVoices(int numVoicesToAllocate)
+{
+	jassert(numVoicesToAllocate > 0);
+
+	numVoices = numVoicesToAllocate;
+	activeVoices.allocate(numVoices, true);
+
+	if (compiledOk)
+	{
+		for (auto index : voiceStateIndexes)
+		{
+			scope->setGlobalVariable(index, var(new VariantBuffer(numVoices)));
+		}
+	}
+}
+
+void HiseJITVoiceModule::startVoice(int voiceIndex, int noteNumber)
+{
+	jassert(isPositiveAndBelow(voiceIndex, numVoices));
+
+	if (allOK() && isPositiveAndBelow(voiceIndex, numVoices))
+	{
+		startf(voiceIndex, noteNumber);
+		activeVoices[voiceIndex] = true;
+	}
+}
+
+void HiseJITVoiceModule::stopVoice(int voiceIndex)
+{
+	jassert(isPositiveAndBelow(voiceIndex, numVoices));
+
+	if (allOK() && isPositiveAndBelow(voiceIndex, numVoices))
+	{
+		stopf(voiceIndex);
+
+		if (activef == nullptr)
+			activeVoices[voiceIndex] = false;
+	}
+}
+
+bool HiseJITVoiceModule::isVoiceActive(int voiceIndex) const
+{
+	return isPositiveAndBelow(voiceIndex, numVoices) && activeVoices[voiceIndex];
+}
+
+void HiseJITVoiceModule::renderVoice(int voiceIndex, float* data, int numSamples)
+{
+	jassert(isPositiveAndBelow(voiceIndex, numVoices));
+
+	if (allOK() && isPositiveAndBelow(voiceIndex, numVoices))
+	{
+		for (int i = 0; i < numSamples; i++)
+		{
+			data[i] = pf(voiceIndex);
+		}
+
+		updateActiveState(voiceIndex);
+	}
+}
+
+void HiseJITVoiceModule::applyToVoice(int voiceIndex, float* data, int numSamples)
+{
+	jassert(isPositiveAndBelow(voiceIndex, numVoices));
+
+	if (allOK() && isPositiveAndBelow(voiceIndex, numVoices))
+	{
+		for (int i = 0; i < numSamples; i++)
+		{
+			data[i] *= pf(voiceIndex);
+		}
+
+		updateActiveState(voiceIndex);
+	}
+}
+
+void HiseJITVoiceModule::updateActiveState(int voiceIndex)
+{
+	if (activef != nullptr)
+		activeVoices[voiceIndex] = activef(voiceIndex) != 0;
+
+	if (overFlowCheckEnabled)
+		throwIfBufferOverflow(scope);
+}
+
+HiseJITScope* HiseJITVoiceModule::getScope()
+{
+	return scope;
+}
+
+const HiseJITScope* HiseJITVoiceModule::getScope() const
+{
+	return scope;
+}
+
+void HiseJITVoiceModule::enableOverflowCheck(bool shouldCheckForOverflow)
+{
+	overFlowCheckEnabled = shouldCheckForOverflow;
+}
+
+bool HiseJITVoiceModule::allOK() const
+{
+	return compiledOk && allFunctionsDefined;
+}
@@ -125,6 +125,11 @@ template <typename ReturnType, typename...ParameterTypes> ReturnType(*HiseJITSco
 }
 
 
+int HiseJITScope::getCodeSize() const
+{
+	return pimpl != nullptr ? (int)pimpl->codeSize : 0;
+}
+
 int HiseJITScope::isBufferOverflow(int globalIndex) const
 {
 	return pimpl->globals[globalIndex]->hasOverflowError();
@@ -231,6 +231,8 @@ public:
 
 	ScopedPointer<asmjit::JitRuntime> runtime;
 
+	size_t codeSize = 0;
+
 	typedef ReferenceCountedObjectPtr<HiseJITScope> Ptr;
 };
 
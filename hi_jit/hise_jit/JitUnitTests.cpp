@@ -204,6 +204,12 @@ public:
 
 		testDspModules();
 
+		testVoiceModules();
+
+		testInlineMath();
+
+		testOptimisations();
+
 		//testDynamicObjectProperties();
 		//testDynamicObjectFunctionCalls();
 	}
@@ -655,6 +661,220 @@ private:
 		expectBufferWithSameValues(b1, b2);
 	}
 
+	void testVoiceModules()
+	{
+		beginTest("Test polyphonic voice modules");
+
+		String code;
+
+		ADD_CODE_LINE("Buffer gain;");
+		ADD_CODE_LINE("Buffer note;");
+		ADD_CODE_LINE("float decay = 0.5f;");
+		ADD_CODE_LINE("void init() {};");
+		ADD_CODE_LINE("void prepareToPlay(double sampleRate, int blockSize) {};");
+		ADD_CODE_LINE("void startVoice(int voiceIndex, int noteNumber) { gain[voiceIndex] = 1.0f; note[voiceIndex] = (float)noteNumber; };");
+		ADD_CODE_LINE("void stopVoice(int voiceIndex) { gain[voiceIndex] = 0.0f; };");
+		ADD_CODE_LINE("int isActive(int voiceIndex) { return gain[voiceIndex] > 0.001f ? 1 : 0; };");
+		ADD_CODE_LINE("float process(int voiceIndex)");
+		ADD_CODE_LINE("{");
+		ADD_CODE_LINE("    const float v = gain[voiceIndex];");
+		ADD_CODE_LINE("    gain[voiceIndex] = v * decay;");
+		ADD_CODE_LINE("    return v * note[voiceIndex];");
+		ADD_CODE_LINE("};");
+
+		ScopedPointer<HiseJITCompiler> compiler = new HiseJITCompiler(code, false);
+		ScopedPointer<HiseJITVoiceModule> m = new HiseJITVoiceModule(compiler);
+
+		expectCompileOK(compiler);
+		expect(m->allOK(), "All voice functions defined");
+
+		m->prepareVoices(128);
+		m->init();
+		m->prepareToPlay(44100.0, 4);
+
+		expectEquals<int>(m->getNumVoices(), 128, "Voice state allocation");
+
+		m->startVoice(0, 2);
+		m->startVoice(127, 4);
+
+		VariantBuffer b1(4);
+		VariantBuffer b2(4);
+
+		m->renderVoice(0, b1.buffer.getWritePointer(0), b1.size);
+		m->renderVoice(127, b2.buffer.getWritePointer(0), b2.size);
+
+		expectEquals<float>(b1[1], 1.0f, "First voice state");
+		expectEquals<float>(b2[1], 2.0f, "Last voice state");
+		expect(m->isVoiceActive(0), "Voice is active");
+		expect(!m->isVoiceActive(1), "Voice is not started");
+
+		VariantBuffer b3(4);
+		1.0f >> b3;
+
+		m->stopVoice(127);
+		m->applyToVoice(127, b3.buffer.getWritePointer(0), b3.size);
+
+		expectEquals<float>(b3[0], 0.0f, "Stopped voice modulation");
+		expect(!m->isVoiceActive(127), "Voice is stopped");
+	}
+
+	void testOptimisations()
+	{
+		beginTest("Testing optimisation passes");
+
+		ScopedPointer<HiseJITTestCase<float>> test;
+
+		CREATE_TEST("float test(float input){ return input / 4.0f; };");
+		EXPECT("Division by power of two", 2.0f, 0.5f);
+
+		CREATE_TEST("float test(float input){ return input * 1.0f - 0.0f; };");
+		EXPECT("Identity operations", 3.0f, 3.0f);
+
+		CREATE_TEST("float test(float input){ const float a = input * input; const float b = input * input; return a + b; };");
+		EXPECT("Common subexpression", 3.0f, 18.0f);
+
+		CREATE_TEST("float x = 2.0f; float test(float input){ const float a = input * x; x = 3.0f; return a + input * x; };");
+		EXPECT("Subexpression after assignment", 1.0f, 5.0f);
+
+		CREATE_TEST("float test(float input){ const float a = input > 1.0f ? input * 2.0f : 0.0f; return a + input * 2.0f; };");
+		EXPECT("Subexpression after branch", 0.5f, 1.0f);
+
+		ScopedPointer<HiseJITTestCase<int>> intTest = new HiseJITTestCase<int>("int test(int input){ return input * 8 + 0; };");
+		expectEquals<int>(intTest->getResult(3), 24, "Multiplication as shift");
+
+		logOptimisationReport("Gain", "float x = 0.5f;", "return input * x;");
+		logOptimisationReport("Saturator", "float k = 8.0f;", "return (1.0f + k) * input / (1.0f + k * fabsf(input));");
+		logOptimisationReport("Redundant terms", "", "const float a = input * input * 0.5f;\n    const float b = input * input * 0.5f;\n    return a + b / 2.0f;");
+
+		String additiveBody;
+		additiveBody << "    const float uptimeFloat = (float)uptime;\n";
+		additiveBody << "    const float v1 = 1.0f * sinf(uptimeFloat);\n";
+		additiveBody << "    const float v2 = 0.8f * sinf(2.0f * uptimeFloat);\n";
+		additiveBody << "    uptime += uptimeDelta;\n";
+		additiveBody << "    return v1 + v2;";
+
+		logOptimisationReport("Additive", "double uptime = 0.0;\ndouble uptimeDelta = 0.1;", additiveBody);
+	}
+
+	/** Compiles the body with and without optimisations, checks that the results match and logs the code size and speed. */
+	void logOptimisationReport(const String& name, const String& globals, const String& processBody)
+	{
+		VariantBuffer input(VAR_BUFFER_TEST_SIZE);
+		fillBufferWithNoise(input);
+
+		OwnedArray<VariantBuffer> results;
+		int codeSize[2];
+		double time[2];
+
+		for (int i = 0; i < 2; i++)
+		{
+			ScopedPointer<HiseJITTestModule> m = new HiseJITTestModule();
+
+			m->setGlobals("#define OPTIMIZE " + String(i) + "\n" + globals);
+			m->setProcessBody(processBody);
+			m->merge();
+
+			VariantBuffer* b = results.add(new VariantBuffer(VAR_BUFFER_TEST_SIZE));
+
+			input >> *b;
+			m->process(*b);
+
+			expectCompileOK(m->compiler);
+			expectAllFunctionsDefined(m);
+
+			codeSize[i] = m->module->getScope()->getCodeSize();
+			time[i] = getNanosecondsPerSample(m->executionTime);
+		}
+
+		expectBufferWithSameValues(*results[1], *results[0]);
+
+		logMessage(name + ": " + String(codeSize[0]) + " -> " + String(codeSize[1]) + " bytes, " + 
+				   String(time[0], 2) + " -> " + String(time[1], 2) + " ns/sample");
+	}
+
+	void testInlineMath()
+	{
+		beginTest("Testing inlined math functions");
+
+		testInlineMathFunction("sinf(input)", [](float x) { return sinf(x); }, -10.0f, 10.0f, false);
+		testInlineMathFunction("cosf(input)", [](float x) { return cosf(x); }, -10.0f, 10.0f, false);
+		testInlineMathFunction("expf(input)", [](float x) { return expf(x); }, -10.0f, 10.0f, true);
+		testInlineMathFunction("tanhf(input)", [](float x) { return tanhf(x); }, -5.0f, 5.0f, false);
+		testInlineMathFunction("powf(input, 2.5f)", [](float x) { return powf(x, 2.5f); }, 0.01f, 10.0f, true);
+		testInlineMathFunction("sqrtf(input)", [](float x) { return sqrtf(x); }, 0.0f, 100.0f, false);
+		testInlineMathFunction("fabsf(input)", [](float x) { return fabsf(x); }, -10.0f, 10.0f, false);
+	}
+
+	/** Checks the function against libm for every accuracy level and logs the ns/sample for each level. */
+	void testInlineMathFunction(const String& expression, float(*reference)(float), float minInput, float maxInput, bool useRelativeError)
+	{
+		static const float tolerances[] = { 0.0f, 1e-5f, 1e-3f };
+		static const char* levelNames[] = { "precise", "accurate", "fast" };
+
+		VariantBuffer input(VAR_BUFFER_TEST_SIZE);
+		VariantBuffer expected(VAR_BUFFER_TEST_SIZE);
+
+		for (int i = 0; i < input.size; i++)
+		{
+			input[i] = minInput + (maxInput - minInput) * (float)i / (float)input.size;
+		}
+
+		const double start = Time::getMillisecondCounterHiRes();
+
+		for (int i = 0; i < input.size; i++)
+		{
+			expected[i] = reference(input[i]);
+		}
+
+		const double nativeTime = Time::getMillisecondCounterHiRes() - start;
+
+		String table;
+
+		table << expression << " (ns/sample):";
+
+		for (int level = 0; level < (int)MathAccuracy::numMathAccuracyLevels; level++)
+		{
+			ScopedPointer<HiseJITTestModule> m = new HiseJITTestModule();
+
+			m->setGlobals("#define MATH_ACCURACY " + String(level));
+			m->setProcessBody("return " + expression + ";");
+			m->merge();
+
+			VariantBuffer b(VAR_BUFFER_TEST_SIZE);
+
+			input >> b;
+			m->process(b);
+
+			expectCompileOK(m->compiler);
+			expectAllFunctionsDefined(m);
+
+			float maxError = 0.0f;
+
+			for (int i = 0; i < b.size; i++)
+			{
+				float error = fabsf(b[i] - expected[i]);
+
+				if (useRelativeError)
+					error /= jmax<float>(fabsf(expected[i]), FLT_MIN);
+
+				maxError = jmax<float>(maxError, error);
+			}
+
+			expect(maxError <= tolerances[level], expression + " with " + levelNames[level] + " accuracy. Max error: " + String(maxError));
+
+			table << " " << levelNames[level] << ": " << String(getNanosecondsPerSample(m->executionTime), 2);
+		}
+
+		table << ", libm: " << String(getNanosecondsPerSample(nativeTime), 2);
+
+		logMessage(table);
+	}
+
+	static double getNanosecondsPerSample(double milliseconds)
+	{
+		return milliseconds * 1000000.0 / (double)VAR_BUFFER_TEST_SIZE;
+	}
+
 	void logPerformanceMessage(double jitTime, double nativeTime)
 	{
 		double percentage = (nativeTime / jitTime) * 100.0;
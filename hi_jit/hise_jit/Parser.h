@@ -225,6 +225,18 @@ struct GlobalBase
 
 
 
+/** The accuracy level for the inbuilt math functions.
+*
+*	Use `#define MATH_ACCURACY 1` (or 2) in the JIT code to replace the calls to the C runtime with inlined approximations.
+*/
+enum class MathAccuracy
+{
+	Precise = 0, ///< calls the C runtime functions (default)
+	Accurate, ///< inlined polynomial approximations with an error of about 1e-6
+	Fast, ///< inlined polynomial approximations with an error of about 1e-4
+	numMathAccuracyLevels
+};
+
 struct FunctionInfo
 {
 	FunctionInfo():
@@ -250,6 +262,8 @@ struct FunctionInfo
 	int parameterAmount = 0;
 
 	bool useSafeBufferFunctions = true;
+	MathAccuracy mathAccuracy = MathAccuracy::Precise;
+	bool optimize = true;
 	bool addVoidReturnStatement;
 
 	TypeInfo lineType;
@@ -225,12 +225,12 @@ void CurveEqEditor::buttonClicked (Button* buttonThatWasClicked)
 
 		if(on)
 		{
-			dragOverlay->startTimer(30);
+			dragOverlay->setFFTEnabled(true);
 			fftRangeSlider->setEnabled(true);
 		}
 		else
 		{
-			dragOverlay->stopTimer();
+			dragOverlay->setFFTEnabled(false);
 			fftRangeSlider->setEnabled(false);
 			dragOverlay->clearFFTDisplay();
 		}
@@ -436,16 +436,22 @@ void FilterDragOverlay::selectDragger(int index)
 
 }
 
-void FilterDragOverlay::timerCallback()
+void FilterDragOverlay::setFFTEnabled(bool shouldBeEnabled)
 {
-	const double *d = eq->getExternalData();
+	if (shouldBeEnabled)
+		eq->getAnalysisTap().addListener(this);
+	else
+		eq->getAnalysisTap().removeListener(this);
+}
 
-	const double max = FloatVectorOperations::findMaximum(d, FFT_SIZE_FOR_EQ);
+void FilterDragOverlay::analysisResultsChanged(AnalysisTap* tap)
+{
+	tap->getSpectrum(gainValues);
 
-	if(max == 0)
-	{
-		FloatVectorOperations::clear(gainValues, FFT_SIZE_FOR_EQ);
+	const float max = FloatVectorOperations::findMaximum(gainValues, FFT_SIZE_FOR_EQ / 2);
 
+	if(max == 0.0f)
+	{
 		p.clear();
 
 		if(repaintUpdater.shouldUpdate())
@@ -458,51 +464,12 @@ void FilterDragOverlay::timerCallback()
 		return;
 	}
 
-#if JUCE_IOS
-    
-#else
-    
-	const int size = FFT_SIZE_FOR_EQ;
-	const int half = size / 2;
-
-	for(int i = 0; i < half; i++)
-	{
-		fftData[i] = std::complex<double>(d[i] * (double)i / (double)(half), 0.0);
-	}
-
-	for(int i = half; i < size; i++)
-	{
-		fftData[i] = std::complex<double>(d[i] * (1.0 - (double)(i - half) / (double)half), 0.0);
-	}
-
-	DustFFT_fwdD(reinterpret_cast<double*>(fftData), size);
-
-	for(int i = 0; i < size; i++)
-	{
-		fftAmpData[i] = sqrt(fftData[i].imag() * fftData[i].imag() + fftData[i].real() * fftData[i].real()) / (double)FFT_SIZE_FOR_EQ;
-	}
-
-	for(int i = 0; i < size; i++)
-	{
-		//gainValues[i] = 0.4f * fftAmpData[i] +  0.8f * gainValues[i];
-
-
-        gainValues[i] = ((float)fftAmpData[i] > gainValues[i]) ? (float)fftAmpData[i] : 0.9f * gainValues[i];
-
-	}
-
 	if(repaintUpdater.shouldUpdate())
 	{
-
-
 		Path tempPath;
 
 		tempPath.clear();
 
-		const double maxGain = FloatVectorOperations::findMaximum(fftAmpData, FFT_SIZE_FOR_EQ);
-
-		if(maxGain == 0.0) return;
-
 		float w = (float)getWidth();
 		float h = (float)getHeight();
 
@@ -558,8 +525,6 @@ void FilterDragOverlay::timerCallback()
 
 		repaint();
 	}
-    
-#endif
 }
 
 void FilterDragOverlay::paint(Graphics &g)
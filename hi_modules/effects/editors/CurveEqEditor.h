@@ -250,7 +250,7 @@ private:
 };
 
 class FilterDragOverlay: public Component,
-						 public Timer,
+						 public AnalysisTap::Listener,
 						 public SettableTooltipClient
 {
 public:
@@ -262,17 +262,7 @@ public:
 
 		repaintUpdater.setManualCountLimit(4);
 
-
-        FloatVectorOperations::clear(fftAmpData, FFT_SIZE_FOR_EQ);
-
-        FloatVectorOperations::clear(gainValues, FFT_SIZE_FOR_EQ);
-
-        FloatVectorOperations::clear(currentGainValues, FFT_SIZE_FOR_EQ);
-	}
-
-	~FilterDragOverlay()
-	{
-		stopTimer();
+        FloatVectorOperations::clear(gainValues, FFT_SIZE_FOR_EQ / 2);
 	}
 
 	void clearFFTDisplay()
@@ -281,7 +271,10 @@ public:
 		repaint();
 	}
 
-	void timerCallback() override;
+	/** Subscribes to the analysis tap of the EQ. */
+	void setFFTEnabled(bool shouldBeEnabled);
+
+	void analysisResultsChanged(AnalysisTap* tap) override;
 
 	void paint(Graphics &g);
 
@@ -451,13 +444,7 @@ private:
 
 	double fftRange;
 
-	std::complex<double> fftData[FFT_SIZE_FOR_EQ];
-
-	double fftAmpData[FFT_SIZE_FOR_EQ];
-
-	float gainValues[FFT_SIZE_FOR_EQ];
-
-	float currentGainValues[FFT_SIZE_FOR_EQ];
+	float gainValues[FFT_SIZE_FOR_EQ / 2];
 
 	int selectedIndex;
 
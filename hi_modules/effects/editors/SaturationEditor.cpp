@@ -57,6 +57,26 @@ SaturationEditor::SaturationEditor (ProcessorEditor *p)
     postGainSlider->setTextBoxStyle (Slider::TextBoxRight, false, 80, 20);
     postGainSlider->addListener (this);
 
+    addAndMakeVisible (oversamplingSelector = new HiComboBox ("Oversampling"));
+    oversamplingSelector->setEditableText (false);
+    oversamplingSelector->setJustificationType (Justification::centredLeft);
+    oversamplingSelector->setTextWhenNothingSelected (TRANS("Oversampling"));
+    oversamplingSelector->setTextWhenNoChoicesAvailable (TRANS("(no choices)"));
+    oversamplingSelector->addItem (TRANS("No Oversampling"), 1);
+    oversamplingSelector->addItem (TRANS("2x Oversampling"), 2);
+    oversamplingSelector->addItem (TRANS("4x Oversampling"), 3);
+    oversamplingSelector->addItem (TRANS("8x Oversampling"), 4);
+    oversamplingSelector->addListener (this);
+
+    addAndMakeVisible (filterSelector = new HiComboBox ("Filter"));
+    filterSelector->setEditableText (false);
+    filterSelector->setJustificationType (Justification::centredLeft);
+    filterSelector->setTextWhenNothingSelected (TRANS("Filter"));
+    filterSelector->setTextWhenNoChoicesAvailable (TRANS("(no choices)"));
+    filterSelector->addItem (TRANS("Linear Phase"), 1);
+    filterSelector->addItem (TRANS("Minimum Phase"), 2);
+    filterSelector->addListener (this);
+
 
     //[UserPreSize]
 
@@ -70,9 +90,12 @@ SaturationEditor::SaturationEditor (ProcessorEditor *p)
 	pregainSlider->setMode(HiSlider::Decibel, 0, 24.0, 12.0);
 	postGainSlider->setup(getProcessor(), SaturatorEffect::PostGain, "Post Gain");
 	postGainSlider->setMode(HiSlider::Decibel, -24.0, 0.0, -12.0);
+
+	oversamplingSelector->setup(getProcessor(), SaturatorEffect::Oversampling, "Oversampling");
+	filterSelector->setup(getProcessor(), SaturatorEffect::OversamplingFilter, "Oversampling Filter");
     //[/UserPreSize]
 
-    setSize (800, 80);
+    setSize (800, 112);
 
 
     //[Constructor] You can add your own custom stuff here..
@@ -89,6 +112,8 @@ SaturationEditor::~SaturationEditor()
     wetSlider = nullptr;
     pregainSlider = nullptr;
     postGainSlider = nullptr;
+    oversamplingSelector = nullptr;
+    filterSelector = nullptr;
 
 
     //[Destructor]. You can add your own custom destruction code here..
@@ -126,6 +151,8 @@ void SaturationEditor::resized()
     wetSlider->setBounds ((getWidth() / 2) + -48, 18, 128, 48);
     pregainSlider->setBounds ((getWidth() / 2) + -212 - 128, 18, 128, 48);
     postGainSlider->setBounds ((getWidth() / 2) + 106, 18, 128, 48);
+    oversamplingSelector->setBounds ((getWidth() / 2) + -212 - 128, 74, 128, 24);
+    filterSelector->setBounds ((getWidth() / 2) + -68 - 128, 74, 128, 24);
     //[UserResized] Add your own custom resize handling here..
     //[/UserResized]
 }
@@ -160,6 +187,26 @@ void SaturationEditor::sliderValueChanged (Slider* sliderThatWasMoved)
     //[/UsersliderValueChanged_Post]
 }
 
+void SaturationEditor::comboBoxChanged (ComboBox* comboBoxThatHasChanged)
+{
+    //[UsercomboBoxChanged_Pre]
+    //[/UsercomboBoxChanged_Pre]
+
+    if (comboBoxThatHasChanged == oversamplingSelector)
+    {
+        //[UserComboBoxCode_oversamplingSelector] -- add your combo box handling code here..
+        //[/UserComboBoxCode_oversamplingSelector]
+    }
+    else if (comboBoxThatHasChanged == filterSelector)
+    {
+        //[UserComboBoxCode_filterSelector] -- add your combo box handling code here..
+        //[/UserComboBoxCode_filterSelector]
+    }
+
+    //[UsercomboBoxChanged_Post]
+    //[/UsercomboBoxChanged_Post]
+}
+
 
 
 //[MiscUserCode] You can add your own definitions of your custom methods or any other code here...
@@ -179,7 +226,7 @@ BEGIN_JUCER_METADATA
                  parentClasses="public ProcessorEditorBody, public Timer" constructorParams="ProcessorEditor *p"
                  variableInitialisers="ProcessorEditorBody(p)" snapPixels="8"
                  snapActive="1" snapShown="1" overlayOpacity="0.330" fixedSize="1"
-                 initialWidth="800" initialHeight="80">
+                 initialWidth="800" initialHeight="112">
   <BACKGROUND backgroundColour="ffffff">
     <ROUNDRECT pos="-0.5Cc 6 84M 12M" cornerSize="6" fill="solid: 30000000"
                hasStroke="1" stroke="2, mitered, butt" strokeColour="solid: 25ffffff"/>
@@ -206,6 +253,14 @@ BEGIN_JUCER_METADATA
           posRelativeX="f930000f86c6c8b6" min="-24" max="24" int="0.10000000000000000555"
           style="RotaryHorizontalVerticalDrag" textBoxPos="TextBoxRight"
           textBoxEditable="1" textBoxWidth="80" textBoxHeight="20" skewFactor="1"/>
+  <COMBOBOX name="Oversampling" id="5f1e0c9a3b7d2e41" memberName="oversamplingSelector"
+            virtualName="HiComboBox" explicitFocusOrder="0" pos="-212Cr 74 128 24"
+            posRelativeX="f930000f86c6c8b6" editable="0" layout="33" items="No Oversampling&#10;2x Oversampling&#10;4x Oversampling&#10;8x Oversampling"
+            textWhenNonSelected="Oversampling" textWhenNoItems="(no choices)"/>
+  <COMBOBOX name="Filter" id="a83c6d1f07e2b954" memberName="filterSelector"
+            virtualName="HiComboBox" explicitFocusOrder="0" pos="-68Cr 74 128 24"
+            posRelativeX="f930000f86c6c8b6" editable="0" layout="33" items="Linear Phase&#10;Minimum Phase"
+            textWhenNonSelected="Filter" textWhenNoItems="(no choices)"/>
 </JUCER_COMPONENT>
 
 END_JUCER_METADATA
@@ -78,6 +78,9 @@ public:
 	void restoreFromValueTree(const ValueTree &v) override;;
 	ValueTree exportAsValueTree() const override;
 
+	/** The state of the wrapped processor can change at any time. */
+	bool canCacheValueTree() const override { return false; }
+
 	bool hasTail() const override { return false; };
 
 	Processor *getChildProcessor(int /*processorIndex*/) override { return wetAmountChain; };
@@ -34,7 +34,8 @@
 #define CURVEEQ_H_INCLUDED
 
 
-#define FFT_SIZE_FOR_EQ 4096
+#define FFT_ORDER_FOR_EQ 12
+#define FFT_SIZE_FOR_EQ (1 << FFT_ORDER_FOR_EQ)
 
 /** A parametriq equalizer with unlimited bands and FFT display. 
 *	@ingroup effectTypes
@@ -205,7 +206,7 @@ public:
 
 	CurveEq(MainController *mc, const String &id):
 		MasterEffectProcessor(mc, id),
-		fftBufferIndex(0)
+		analysisTap(mc->getAnalysisService(), FFT_ORDER_FOR_EQ)
 	{
 		parameterNames.add("Gain");
 		parameterNames.add("Freq");
@@ -213,8 +214,6 @@ public:
 		parameterNames.add("Enabled");
 		parameterNames.add("Type");
 		parameterNames.add("BandOffset");
-
-		FloatVectorOperations::fill(fftData, 0.0f, 256);
 	};
 
 	int getParameterIndex(int filterIndex, int parameterType) const
@@ -233,16 +232,7 @@ public:
 			filterBands[i]->process(buffer, startSample, numSamples);
 		}
 
-		if(fftBufferIndex < FFT_SIZE_FOR_EQ)
-		{
-			const int numSamplesToCopy = jmin<int>(numSamples, FFT_SIZE_FOR_EQ - fftBufferIndex);
-
-			FloatVectorOperations::copyWithMultiply(fftData + fftBufferIndex, buffer.getReadPointer(0, startSample), 0.5f, numSamplesToCopy);
-			FloatVectorOperations::addWithMultiply(fftData + fftBufferIndex, buffer.getReadPointer(1, startSample), 0.5f, numSamplesToCopy);
-
-			fftBufferIndex += numSamplesToCopy;
-
-		}
+		analysisTap.pushSamples(buffer.getReadPointer(0, startSample), buffer.getReadPointer(1, startSample), numSamples);
 	};
 
 	IIRCoefficients getCoefficients(int filterIndex)
@@ -276,6 +266,7 @@ public:
 
 		filterBands.add(f);
 
+		markValueTreeDirty();
 		sendChangeMessage();
 	}
 
@@ -285,6 +276,7 @@ public:
 
 		filterBands.remove(filterIndex);
 
+		markValueTreeDirty();
 		sendChangeMessage();
 	}
 
@@ -356,25 +348,8 @@ public:
 
 	}
 
-	struct AlignedDouble
-	{
-		double data;
-		double padding;
-	};
-
-	const double *getExternalData()
-	{
-		ScopedLock sl(getLock());
-
-		for(int i = 0; i < FFT_SIZE_FOR_EQ; i++)
-		{
-			externalFftData[i] = (float)fftData[i];
-		}
-
-		fftBufferIndex = 0;
-
-		return externalFftData;
-	};
+	/** The tap that feeds the FFT display of the editor. */
+	AnalysisTap& getAnalysisTap() { return analysisTap; }
 
 	bool hasTail() const override {return false;};
 
@@ -390,11 +365,7 @@ private:
 
 	const CriticalSection& getLock() const { return getMainController()->getLock(); }
 
-	float fftData[FFT_SIZE_FOR_EQ];
-
-	double externalFftData[FFT_SIZE_FOR_EQ];
-
-	int fftBufferIndex;
+	AnalysisTap analysisTap;
 
 	OwnedArray<StereoFilter> filterBands;
 
@@ -75,6 +75,9 @@ public:
 		leftDelayFrames = AudioSampleBuffer(1, 0);
 		rightDelayFrames = AudioSampleBuffer(1, 0);
 
+		leftDelay.setMaxDelayTimeSeconds(3.0);
+		rightDelay.setMaxDelayTimeSeconds(3.0);
+
 		parameterNames.add("DelayTimeLeft");
 		parameterNames.add("DelayTimeRight");
 		parameterNames.add("FeedbackLeft");
@@ -199,8 +202,8 @@ public:
 	{
 		EffectProcessor::prepareToPlay(sampleRate, samplesPerBlock);
         
-        leftDelay.prepareToPlay(sampleRate);
-        rightDelay.prepareToPlay(sampleRate);
+        leftDelay.prepareToPlay(sampleRate, samplesPerBlock);
+        rightDelay.prepareToPlay(sampleRate, samplesPerBlock);
         
 		calcDelayTimes();
 
@@ -231,16 +234,21 @@ public:
 		const int sampleIndex = startSample;
 		const int samplesToCopy = numSamples;
 
-		float *inputL = buffer.getWritePointer(0, 0);
-		float *inputR = buffer.getWritePointer(1, 0);
-        
-        while(--numSamples >= 0)
-        {
-            leftDelayFrames.setSample(0, startSample, (float)leftDelay.getDelayedValue(inputL[startSample] + feedbackLeft * leftDelayFrames.getSample(0, startSample)));
-            rightDelayFrames.setSample(0, startSample, (float)rightDelay.getDelayedValue(inputR[startSample] + feedbackRight * rightDelayFrames.getSample(0, startSample)));
-            
-            ++startSample;
-        }
+		const float *inputL = buffer.getReadPointer(0, startSample);
+		const float *inputR = buffer.getReadPointer(1, startSample);
+
+		float *framesL = leftDelayFrames.getWritePointer(0, startSample);
+		float *framesR = rightDelayFrames.getWritePointer(0, startSample);
+
+		// The feedback comes from the last block's output at the same position
+		FloatVectorOperations::multiply(framesL, feedbackLeft, numSamples);
+		FloatVectorOperations::multiply(framesR, feedbackRight, numSamples);
+
+		FloatVectorOperations::add(framesL, inputL, numSamples);
+		FloatVectorOperations::add(framesR, inputR, numSamples);
+
+		leftDelay.processBlock(framesL, numSamples);
+		rightDelay.processBlock(framesR, numSamples);
 
         const float dryMix = (mix < 0.5f) ? 1.0f : (2.0f - 2.0f * mix);
         const float wetMix = (mix > 0.5f) ? 1.0f : (2.0f * mix);
@@ -12,6 +12,9 @@
 
 DynamicsEffect::DynamicsEffect(MainController *mc, const String &uid) :
 	MasterEffectProcessor(mc, uid),
+	gate(BlockDynamics::Gate),
+	compressor(BlockDynamics::Compressor),
+	limiter(BlockDynamics::Limiter),
 	gateEnabled(false),
 	compressorEnabled(false),
 	limiterEnabled(false)
@@ -32,6 +35,7 @@ DynamicsEffect::DynamicsEffect(MainController *mc, const String &uid) :
 	parameterNames.add("LimiterAttack");
 	parameterNames.add("LimiterRelease");
 	parameterNames.add("LimiterReduction");
+	parameterNames.add("LimiterLookahead");
 }
 
 void DynamicsEffect::setInternalAttribute(int parameterIndex, float newValue)
@@ -43,16 +47,17 @@ void DynamicsEffect::setInternalAttribute(int parameterIndex, float newValue)
 	case GateEnabled:			gateEnabled = newValue > 0.5f; break;
 	case CompressorEnabled:		compressorEnabled = newValue > 0.5f; break;
 	case LimiterEnabled:		limiterEnabled = newValue > 0.5f; break;
-	case GateThreshold:			gate.setThresh((SimpleDataType)newValue); break;
-	case CompressorThreshold:	compressor.setThresh((SimpleDataType)newValue); break;
-	case LimiterThreshold:		limiter.setThresh((SimpleDataType)newValue); break;
-	case GateAttack:			gate.setAttack((SimpleDataType)newValue); break;
-	case CompressorAttack:		compressor.setAttack((SimpleDataType)newValue); break;
-	case LimiterAttack:			limiter.setAttack((SimpleDataType)newValue); break;
-	case GateRelease:			gate.setRelease((SimpleDataType)newValue); break;
-	case CompressorRelease:		compressor.setRelease((SimpleDataType)newValue); break;
-	case LimiterRelease:		limiter.setRelease((SimpleDataType)newValue); break;
-	case CompressorRatio:		compressor.setRatio((SimpleDataType)(1.0f / newValue)); break;
+	case GateThreshold:			gate.setThreshold(newValue); break;
+	case CompressorThreshold:	compressor.setThreshold(newValue); break;
+	case LimiterThreshold:		limiter.setThreshold(newValue); break;
+	case GateAttack:			gate.setAttack(newValue); break;
+	case CompressorAttack:		compressor.setAttack(newValue); break;
+	case LimiterAttack:			limiter.setAttack(newValue); break;
+	case GateRelease:			gate.setRelease(newValue); break;
+	case CompressorRelease:		compressor.setRelease(newValue); break;
+	case LimiterRelease:		limiter.setRelease(newValue); break;
+	case CompressorRatio:		compressor.setRatio(1.0f / newValue); break;
+	case LimiterLookahead:		limiter.setLookahead(newValue > 0.5f); break;
 	case GateReduction:
 	case CompressorReduction:
 	case LimiterReduction:		break;
@@ -72,19 +77,20 @@ float DynamicsEffect::getAttribute(int parameterIndex) const
 	case GateEnabled:			return gateEnabled ? 1.0f : 0.0f;
 	case CompressorEnabled:		return compressorEnabled ? 1.0f : 0.0f;
 	case LimiterEnabled:		return limiterEnabled ? 1.0f : 0.0f;
-	case GateThreshold:			return (float)gate.getThresh();
-	case CompressorThreshold:	return (float)compressor.getThresh(); 
-	case LimiterThreshold:		return (float)limiter.getThresh();
-	case GateAttack:			return (float)gate.getAttack();
-	case CompressorAttack:		return (float)compressor.getAttack();
-	case LimiterAttack:			return (float)limiter.getAttack();
-	case GateRelease:			return (float)gate.getRelease();
-	case CompressorRelease:		return (float)compressor.getRelease();
-	case LimiterRelease:		return (float)limiter.getRelease();
-	case CompressorRatio:		return 1.0f / (float)compressor.getRatio();
+	case GateThreshold:			return gate.getThreshold();
+	case CompressorThreshold:	return compressor.getThreshold(); 
+	case LimiterThreshold:		return limiter.getThreshold();
+	case GateAttack:			return gate.getAttack();
+	case CompressorAttack:		return compressor.getAttack();
+	case LimiterAttack:			return limiter.getAttack();
+	case GateRelease:			return gate.getRelease();
+	case CompressorRelease:		return compressor.getRelease();
+	case LimiterRelease:		return limiter.getRelease();
+	case CompressorRatio:		return 1.0f / compressor.getRatio();
 	case GateReduction:			return gateReduction;
 	case CompressorReduction:	return compressorReduction;
 	case LimiterReduction:		return limiterReduction;
+	case LimiterLookahead:		return limiter.isUsingLookahead() ? 1.0f : 0.0f;
 	default:
 		break;
 	}
@@ -114,6 +120,7 @@ float DynamicsEffect::getDefaultValue(int parameterIndex) const
 	case GateReduction:			return 0.f;
 	case CompressorReduction:	return 0.f;
 	case LimiterReduction:		return 0.f;
+	case LimiterLookahead:		return true;
 	case numParameters:			jassertfalse;
 		
 	default:
@@ -140,6 +147,7 @@ void DynamicsEffect::restoreFromValueTree(const ValueTree &v)
 	loadAttribute(LimiterThreshold, "LimiterThreshold");
 	loadAttribute(LimiterAttack, "LimiterAttack");
 	loadAttribute(LimiterRelease, "LimiterRelease");
+	loadAttributeWithDefault(LimiterLookahead);
 }
 
 ValueTree DynamicsEffect::exportAsValueTree() const
@@ -159,6 +167,7 @@ ValueTree DynamicsEffect::exportAsValueTree() const
 	saveAttribute(LimiterThreshold, "LimiterThreshold");
 	saveAttribute(LimiterAttack, "LimiterAttack");
 	saveAttribute(LimiterRelease, "LimiterRelease");
+	saveAttribute(LimiterLookahead, "LimiterLookahead");
 
 	return v;
 }
@@ -180,93 +189,184 @@ ProcessorEditorBody * DynamicsEffect::createEditor(ProcessorEditor *parentEditor
 
 void DynamicsEffect::applyEffect(AudioSampleBuffer &buffer, int startSample, int numSamples)
 {
-	const int numToProcess = numSamples - startSample;
+	float* l = buffer.getWritePointer(0, startSample);
+	float* r = buffer.getWritePointer(1, startSample);
 
 	if (gateEnabled)
 	{
-		
+		gate.process(l, r, numSamples);
+		updateReduction(gateReduction, gate, numSamples);
+	}
 
-		float* l = buffer.getWritePointer(0, startSample);
-		float* r = buffer.getWritePointer(1, startSample);
+	if (compressorEnabled)
+	{
+		compressor.process(l, r, numSamples);
+		updateReduction(compressorReduction, compressor, numSamples);
+	}
 
-		for (int i = 0; i < numToProcess; i++)
-		{
-			SimpleDataType l_ = (SimpleDataType)*l;
-			SimpleDataType r_ = (SimpleDataType)*r;
+	if (limiterEnabled)
+	{
+		limiter.process(l, r, numSamples);
+		updateReduction(limiterReduction, limiter, numSamples);
+	}
+}
 
-			gate.process(l_, r_);
+void DynamicsEffect::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+	MasterEffectProcessor::prepareToPlay(sampleRate, samplesPerBlock);
 
-			const float gR = (float)gate.getGainReduction();
+	gate.prepareToPlay(sampleRate, samplesPerBlock);
+	compressor.prepareToPlay(sampleRate, samplesPerBlock);
+	limiter.prepareToPlay(sampleRate, samplesPerBlock);
+}
 
-			if (gR > gateReduction)
-				gateReduction = gR;
-			else
-				gateReduction = gateReduction * 0.9999f;
+void DynamicsEffect::updateReduction(std::atomic<float>& reduction, const BlockDynamics& d, int numSamples)
+{
+	// Same as holding the peak per sample and decaying it by 0.9999 for every sample
+	const float gR = d.getMaxGainFactor();
+	const float decayed = reduction * powf(0.9999f, (float)numSamples);
+
+	reduction = jmax<float>(gR, decayed);
+}
+
+
+#if HI_RUN_UNIT_TESTS
+
+/** Compares the block based dynamics with the chunkware classes they replace and measures the speedup. */
+class BlockDynamicsTest : public UnitTest
+{
+public:
+
+	BlockDynamicsTest() :
+		UnitTest("Testing block dynamics")
+	{
 
-			*l++ = (float)l_;
-			*r++ = (float)r_;
-		}
 	}
 
-	if (compressorEnabled)
+	void runTest() override
 	{
-		float* l = buffer.getWritePointer(0, startSample);
-		float* r = buffer.getWritePointer(1, startSample);
+		createTestSignal();
 
-		for (int i = 0; i < numToProcess; i++)
+		beginTest("Gate");
 		{
-			SimpleDataType l_ = (SimpleDataType)*l;
-			SimpleDataType r_ = (SimpleDataType)*r;
+			chunkware_simple::SimpleGate reference;
+			BlockDynamics d(BlockDynamics::Gate);
 
-			compressor.process(l_, r_);
+			reference.setThresh(-20.0); d.setThreshold(-20.0f);
+			reference.setAttack(5.0); d.setAttack(5.0f);
+			reference.setRelease(80.0); d.setRelease(80.0f);
 
-			const float gR = (float)compressor.getGainReduction();
+			compare(reference, d, "Gate");
+		}
+
+		beginTest("Compressor");
+		{
+			chunkware_simple::SimpleComp reference;
+			BlockDynamics d(BlockDynamics::Compressor);
 
-			if (gR > compressorReduction)
-				compressorReduction = gR;
-			else
-				compressorReduction = compressorReduction * 0.9999f;
+			reference.setThresh(-18.0); d.setThreshold(-18.0f);
+			reference.setRatio(0.25); d.setRatio(0.25f);
+			reference.setAttack(10.0); d.setAttack(10.0f);
+			reference.setRelease(100.0); d.setRelease(100.0f);
 
-			*l++ = (float)l_;
-			*r++ = (float)r_;
+			compare(reference, d, "Compressor");
+		}
+
+		beginTest("Limiter");
+		{
+			chunkware_simple::SimpleLimit reference;
+			BlockDynamics d(BlockDynamics::Limiter);
+
+			reference.setSampleRate(sampleRate);
+
+			reference.setThresh(-6.0); d.setThreshold(-6.0f);
+			reference.setAttack(2.0); d.setAttack(2.0f);
+			reference.setRelease(50.0); d.setRelease(50.0f);
+
+			compare(reference, d, "Limiter");
 		}
 	}
 
-	if (limiterEnabled)
+private:
+
+	/** A sine wave with amplitude steps between -60dB and +6dB. */
+	void createTestSignal()
+	{
+		input.setSize(2, (int)sampleRate * 4);
+
+		for (int i = 0; i < input.getNumSamples(); i++)
+		{
+			const int step = i / 8192;
+			const float gain = Decibels::decibelsToGain(-60.0f + (float)((step * 37) % 67));
+
+			input.setSample(0, i, gain * (float)sin(2.0 * double_Pi * 440.0 / sampleRate * (double)i));
+			input.setSample(1, i, gain * (float)sin(2.0 * double_Pi * 660.0 / sampleRate * (double)i));
+		}
+	}
+
+	template <class ReferenceType> void compare(ReferenceType& reference, BlockDynamics& d, const String& name)
 	{
-		float* l = buffer.getWritePointer(0, startSample);
-		float* r = buffer.getWritePointer(1, startSample);
+		AudioSampleBuffer expected(input);
+		AudioSampleBuffer actual(input);
+
+		reference.setSampleRate(sampleRate);
+		reference.initRuntime();
+
+		d.prepareToPlay(sampleRate, blockSize);
+
+		double start = Time::getMillisecondCounterHiRes();
+
+		for (int i = 0; i < expected.getNumSamples(); i++)
+		{
+			double l = (double)expected.getSample(0, i);
+			double r = (double)expected.getSample(1, i);
+
+			reference.process(l, r);
 
-		for (int i = 0; i < numToProcess; i++)
+			expected.setSample(0, i, (float)l);
+			expected.setSample(1, i, (float)r);
+		}
+
+		const double referenceTime = Time::getMillisecondCounterHiRes() - start;
+
+		start = Time::getMillisecondCounterHiRes();
+
+		// The last block is shorter so that the lookahead ring buffer wraps at an unaligned position
+		for (int i = 0; i < actual.getNumSamples(); i += blockSize)
 		{
-			SimpleDataType l_ = (SimpleDataType)*l;
-			SimpleDataType r_ = (SimpleDataType)*r;
+			const int numThisTime = jmin<int>(blockSize, actual.getNumSamples() - i);
 
-			limiter.process(l_, r_);
+			d.process(actual.getWritePointer(0, i), actual.getWritePointer(1, i), numThisTime);
+		}
 
-			const float gR = (float)limiter.getGainReduction();
+		const double blockTime = Time::getMillisecondCounterHiRes() - start;
 
-			if (gR > limiterReduction)
-				limiterReduction = gR;
-			else
-				limiterReduction = limiterReduction * 0.9999f;
+		float maxDifference = 0.0f;
 
-			*l++ = (float)l_;
-			*r++ = (float)r_;
+		for (int c = 0; c < 2; c++)
+		{
+			for (int i = 0; i < actual.getNumSamples(); i++)
+			{
+				const float e = fabsf(expected.getSample(c, i));
+				const float a = fabsf(actual.getSample(c, i));
+
+				if (e > 0.001f)
+					maxDifference = jmax<float>(maxDifference, fabsf(Decibels::gainToDecibels(a / e)));
+			}
 		}
+
+		logMessage(name + ": max difference " + String(maxDifference, 4) + "dB, " + String(referenceTime / blockTime, 1) + "x faster");
+
+		expect(maxDifference < 0.01f, name + " deviation: " + String(maxDifference) + "dB");
 	}
-	
-}
 
-void DynamicsEffect::prepareToPlay(double sampleRate, int samplesPerBlock)
-{
-	MasterEffectProcessor::prepareToPlay(sampleRate, samplesPerBlock);
+	static const int blockSize = 500;
 
-	gate.initRuntime();
-	compressor.initRuntime();
-	limiter.initRuntime();
+	const double sampleRate = 44100.0;
 
-	gate.setSampleRate(sampleRate);
-	compressor.setSampleRate(sampleRate);
-	limiter.setSampleRate(sampleRate);
-}
+	AudioSampleBuffer input;
+};
+
+static BlockDynamicsTest blockDynamicsTest;
+
+#endif
@@ -58,6 +58,7 @@ public:
 		LimiterAttack,
 		LimiterRelease,
 		LimiterReduction,
+		LimiterLookahead,
 		numParameters
 	};
 
@@ -86,9 +87,11 @@ public:
 
 private:
 
-	chunkware_simple::SimpleGate gate;
-	chunkware_simple::SimpleComp compressor;
-	chunkware_simple::SimpleLimit limiter;
+	void updateReduction(std::atomic<float>& reduction, const BlockDynamics& d, int numSamples);
+
+	BlockDynamics gate;
+	BlockDynamics compressor;
+	BlockDynamics limiter;
 
 	std::atomic<bool> gateEnabled;
 	std::atomic<bool> compressorEnabled;
@@ -47,6 +47,10 @@ balance(0.0f)
 
 	smoother.setSmoothingTime(0.2f);
 
+	// The delay slider goes up to 500ms
+	leftDelay.setMaxDelayTimeSeconds(0.5);
+	rightDelay.setMaxDelayTimeSeconds(0.5);
+
 	parameterNames.add("Gain");
     parameterNames.add("Delay");
     parameterNames.add("Width");
@@ -145,34 +149,17 @@ void GainEffect::applyEffect(AudioSampleBuffer &buffer, int startSample, int num
 	{
 		const float smoothedGain = smoother.smooth(gain);
 
-		if (delay != 0)
-		{
-			l[0] = leftDelay.getDelayedValue(smoothedGain * l[0]);
-			r[0] = rightDelay.getDelayedValue(smoothedGain * r[0]);
-
-			l[1] = leftDelay.getDelayedValue(smoothedGain * l[1]);
-			r[1] = rightDelay.getDelayedValue(smoothedGain * r[1]);
+		l[0] = smoothedGain * l[0];
+		r[0] = smoothedGain * r[0];
 
-			l[2] = leftDelay.getDelayedValue(smoothedGain * l[2]);
-			r[2] = rightDelay.getDelayedValue(smoothedGain * r[2]);
-
-			l[3] = leftDelay.getDelayedValue(smoothedGain * l[3]);
-			r[3] = rightDelay.getDelayedValue(smoothedGain * r[3]);
-		}
-		else
-		{
-			l[0] = smoothedGain * l[0];
-			r[0] = smoothedGain * r[0];
+		l[1] = smoothedGain * l[1];
+		r[1] = smoothedGain * r[1];
 
-			l[1] = smoothedGain * l[1];
-			r[1] = smoothedGain * r[1];
+		l[2] = smoothedGain * l[2];
+		r[2] = smoothedGain * r[2];
 
-			l[2] = smoothedGain * l[2];
-			r[2] = smoothedGain * r[2];
-
-			l[3] = smoothedGain * l[3];
-			r[3] = smoothedGain * r[3];
-		}
+		l[3] = smoothedGain * l[3];
+		r[3] = smoothedGain * r[3];
 
 		l += 4;
 		r += 4;
@@ -180,6 +167,12 @@ void GainEffect::applyEffect(AudioSampleBuffer &buffer, int startSample, int num
 		numSamples -= 4;
 	}
 
+	if (delay != 0)
+	{
+		leftDelay.processBlock(buffer.getWritePointer(0, startIndex), samplesToCopy);
+		rightDelay.processBlock(buffer.getWritePointer(1, startIndex), samplesToCopy);
+	}
+
 
 	if (msDecoder.getWidth() != 1.0f)
 	{
@@ -251,8 +244,8 @@ void GainEffect::prepareToPlay(double sampleRate, int samplesPerBlock)
 		ProcessorHelpers::increaseBufferIfNeeded(widthBuffer, samplesPerBlock);
 		ProcessorHelpers::increaseBufferIfNeeded(balanceBuffer, samplesPerBlock);
 
-        leftDelay.prepareToPlay(sampleRate);
-        rightDelay.prepareToPlay(sampleRate);
+        leftDelay.prepareToPlay(sampleRate, samplesPerBlock);
+        rightDelay.prepareToPlay(sampleRate, samplesPerBlock);
         
         leftDelay.setFadeTimeSamples(samplesPerBlock);
         rightDelay.setFadeTimeSamples(samplesPerBlock);
@@ -37,7 +37,11 @@ SaturatorEffect::SaturatorEffect(MainController *mc, const String &uid) :
 	wet(1.0f),
 	dry(0.0f),
 	preGain(1.0f),
-    postGain(1.0f)
+    postGain(1.0f),
+	oversamplingFactor(Oversampler::NoOversampling),
+	oversamplingFilter(Oversampler::LinearPhase),
+	oversamplingState(new OversamplingState()),
+	updater(this)
 {
 	saturationBuffer = AudioSampleBuffer(1, 0);
 
@@ -45,6 +49,8 @@ SaturatorEffect::SaturatorEffect(MainController *mc, const String &uid) :
 	parameterNames.add("WetAmount");
 	parameterNames.add("PreGain");
 	parameterNames.add("PostGain");
+	parameterNames.add("Oversampling");
+	parameterNames.add("OversamplingFilter");
 
 	editorStateIdentifiers.add("SaturationChainShown");
 
@@ -71,6 +77,14 @@ void SaturatorEffect::setInternalAttribute(int parameterIndex, float newValue)
 	case PostGain:
 		postGain = Decibels::decibelsToGain(newValue);
 		break;
+	case Oversampling:
+		oversamplingFactor = (Oversampler::Factor)jlimit<int>(0, Oversampler::numFactors - 1, (int)newValue - 1);
+		updater.triggerAsyncUpdate();
+		break;
+	case OversamplingFilter:
+		oversamplingFilter = (Oversampler::FilterType)jlimit<int>(0, Oversampler::numFilterTypes - 1, (int)newValue - 1);
+		updater.triggerAsyncUpdate();
+		break;
 	default:
 		break;
 	}
@@ -91,6 +105,10 @@ float SaturatorEffect::getAttribute(int parameterIndex) const
 		return Decibels::gainToDecibels(preGain);
 	case PostGain:
 		return Decibels::gainToDecibels(postGain);
+	case Oversampling:
+		return (float)((int)oversamplingFactor + 1);
+	case OversamplingFilter:
+		return (float)((int)oversamplingFilter + 1);
 	default:
 		break;
 	}
@@ -113,6 +131,10 @@ float SaturatorEffect::getDefaultValue(int parameterIndex) const
 		return 0.0;
 	case PostGain:
 		return 0.0;
+	case Oversampling:
+		return 1.0;
+	case OversamplingFilter:
+		return 1.0;
 	default:
 		break;
 	}
@@ -129,6 +151,8 @@ void SaturatorEffect::restoreFromValueTree(const ValueTree &v)
 	loadAttribute(WetAmount, "WetAmount");
 	loadAttribute(PreGain, "PreGain");
 	loadAttribute(PostGain, "PostGain");
+	loadAttributeWithDefault(Oversampling);
+	loadAttributeWithDefault(OversamplingFilter);
 }
 
 ValueTree SaturatorEffect::exportAsValueTree() const
@@ -139,6 +163,8 @@ ValueTree SaturatorEffect::exportAsValueTree() const
 	saveAttribute(WetAmount, "WetAmount");
 	saveAttribute(PreGain, "PreGain");
 	saveAttribute(PostGain, "PostGain");
+	saveAttribute(Oversampling, "Oversampling");
+	saveAttribute(OversamplingFilter, "OversamplingFilter");
 
 	return v;
 }
@@ -171,6 +197,54 @@ void SaturatorEffect::applyEffect(AudioSampleBuffer &buffer, int startSample, in
 		modValues = saturationBuffer.getReadPointer(0, startSample);
 	}
 
+	Oversampler& oversampler = oversamplingState->oversampler;
+
+	if (oversampler.getFactor() != Oversampler::NoOversampling)
+	{
+		AudioSampleBuffer& dryBuffer = oversamplingState->dryBuffer;
+		const int dryDelay = oversamplingState->dryDelay;
+
+		// Store the dry signal behind the last block so it stays aligned with the delayed wet signal
+		float *dryL = dryBuffer.getWritePointer(0);
+		float *dryR = dryBuffer.getWritePointer(1);
+
+		FloatVectorOperations::copy(dryL + dryDelay, l, numSamples);
+		FloatVectorOperations::copy(dryR + dryDelay, r, numSamples);
+
+		AudioSampleBuffer &oversampledBuffer = oversampler.upsample(buffer, startSample, numSamples);
+
+		const int factor = oversampler.getOversamplingFactor();
+		const int numOversampled = numSamples * factor;
+
+		float *osL = oversampledBuffer.getWritePointer(0);
+		float *osR = oversampledBuffer.getWritePointer(1);
+
+		for (int i = 0; i < numOversampled; i++)
+		{
+			const int originalIndex = i / factor;
+
+			if (modValues != nullptr && (i % factor == 0) && (originalIndex & 7))
+			{
+				saturator.setSaturationAmount(modValues[originalIndex] * saturation);
+			}
+
+			osL[i] = postGain * saturator.getSaturatedSample(preGain*osL[i]);
+			osR[i] = postGain * saturator.getSaturatedSample(preGain*osR[i]);
+		}
+
+		oversampler.downsample(buffer, startSample, numSamples);
+
+		FloatVectorOperations::multiply(l, wet, numSamples);
+		FloatVectorOperations::multiply(r, wet, numSamples);
+		FloatVectorOperations::addWithMultiply(l, dryL, dry, numSamples);
+		FloatVectorOperations::addWithMultiply(r, dryR, dry, numSamples);
+
+		memmove(dryL, dryL + numSamples, sizeof(float) * dryDelay);
+		memmove(dryR, dryR + numSamples, sizeof(float) * dryDelay);
+
+		return;
+	}
+
 	for (int i = 0; i < numSamples; i++)
 	{
 		if (modValues != nullptr && (i & 7))
@@ -190,5 +264,53 @@ void SaturatorEffect::prepareToPlay(double sampleRate, int samplesPerBlock)
 	if (sampleRate > 0)
 	{
 		ProcessorHelpers::increaseBufferIfNeeded(saturationBuffer, samplesPerBlock);
+
+		oversamplingState->prepare(samplesPerBlock);
 	}
 }
+
+void SaturatorEffect::updateOversampling()
+{
+	bool swapped = false;
+
+	while (!swapped)
+	{
+		const int blockSize = getBlockSize();
+
+		ScopedPointer<OversamplingState> newState = new OversamplingState();
+
+		newState->oversampler.setOversampling(oversamplingFactor, oversamplingFilter);
+		newState->dryDelay = roundToInt(newState->oversampler.getLatencyInSamples());
+
+		if (blockSize > 0)
+			newState->prepare(blockSize);
+
+		SaturatorEffect* fx = this;
+
+		// Swap the prepared state on the audio thread. If the block size changed in the meantime, build it again.
+		getMainController()->getGraphEditQueue().performEdit([fx, blockSize, &newState, &swapped]()
+		{
+			if (fx->getBlockSize() == blockSize)
+			{
+				fx->oversamplingState.swapWith(newState);
+				swapped = true;
+			}
+		});
+
+		// Deletes the old state on this thread
+		newState = nullptr;
+	}
+}
+
+void SaturatorEffect::OversamplingState::prepare(int samplesPerBlock)
+{
+	oversampler.prepareToPlay(2, samplesPerBlock);
+
+	dryBuffer.setSize(2, dryDelay + samplesPerBlock);
+	dryBuffer.clear();
+}
+
+void SaturatorEffect::Updater::handleAsyncUpdate()
+{
+	fx->updateOversampling();
+}
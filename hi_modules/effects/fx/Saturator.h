@@ -58,6 +58,8 @@ public:
 		WetAmount,
 		PreGain,
 		PostGain,
+		Oversampling,
+		OversamplingFilter,
 		numParameters
 	};
 
@@ -90,8 +92,46 @@ public:
 	void applyEffect(AudioSampleBuffer &buffer, int startSample, int numSamples) override;
 	void prepareToPlay(double sampleRate, int samplesPerBlock) override;
 
+	/** Returns the latency of the oversampling filters in samples. The dry signal is delayed by this amount.
+	*
+	*	This is not reported to the host, so the wet signal is late compared to other tracks by this amount.
+	*/
+	int getLatencySamples() const { return oversamplingState->dryDelay; }
+
 private:
 
+	/** The oversampler and the dry signal delay. They are built together on the message thread and swapped in. */
+	struct OversamplingState
+	{
+		OversamplingState() :
+			dryDelay(0)
+		{}
+
+		void prepare(int samplesPerBlock);
+
+		Oversampler oversampler;
+
+		AudioSampleBuffer dryBuffer;
+		int dryDelay;
+	};
+
+	class Updater : public AsyncUpdater
+	{
+	public:
+
+		Updater(SaturatorEffect* fx_) :
+			fx(fx_)
+		{}
+
+		void handleAsyncUpdate() override;
+
+	private:
+
+		SaturatorEffect* fx;
+	};
+
+	void updateOversampling();
+
 	float dry;
 	float wet;
 	float saturation;
@@ -100,6 +140,13 @@ private:
 
 	Saturator saturator;
 
+	Oversampler::Factor oversamplingFactor;
+	Oversampler::FilterType oversamplingFilter;
+
+	ScopedPointer<OversamplingState> oversamplingState;
+
+	Updater updater;
+
 	ScopedPointer<ModulatorChain> saturationChain;
 
 	AudioSampleBuffer saturationBuffer;
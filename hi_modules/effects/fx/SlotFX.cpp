@@ -85,14 +85,20 @@ bool SlotFX::setEffect(const String& typeName)
 
 			p->setId(newId);
 
-            ScopedLock callbackLock(getMainController()->getLock());
-            
             p->setIsOnAir(true);
-            
-			wrappedEffect = p;
-            
-        
-            hasScriptFX = thisIsScriptFX;
+
+			SlotFX* slot = this;
+			ScopedPointer<MasterEffectProcessor> oldEffect;
+
+			// Swap the effect on the audio thread and delete the old one here.
+			getMainController()->getGraphEditQueue().performEdit([slot, p, thisIsScriptFX, &oldEffect]()
+			{
+				oldEffect = slot->wrappedEffect.release();
+				slot->wrappedEffect = p;
+				slot->hasScriptFX = thisIsScriptFX;
+			});
+
+			oldEffect = nullptr;
 		}
 
         
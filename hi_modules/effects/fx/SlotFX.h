@@ -93,20 +93,22 @@ public:
 
 	void swap(SlotFX* otherSlot)
 	{
-		auto te = wrappedEffect.release();
-		auto oe = otherSlot->wrappedEffect.release();
-
 		int tempIndex = currentIndex;
 
 		currentIndex = otherSlot->currentIndex;
 		otherSlot->currentIndex = tempIndex;
 
+		SlotFX* thisSlot = this;
+
+		// The edit runs with the main lock held, which also keeps prepareToPlay() out
+		getMainController()->getGraphEditQueue().performEdit([thisSlot, otherSlot]()
 		{
-			ScopedLock sl(swapLock);
+			auto te = thisSlot->wrappedEffect.release();
+			auto oe = otherSlot->wrappedEffect.release();
 
-			wrappedEffect = oe;
+			thisSlot->wrappedEffect = oe;
 			otherSlot->wrappedEffect = te;
-		}
+		});
 		
 		wrappedEffect.get()->sendRebuildMessage(true);
 		otherSlot->wrappedEffect.get()->sendRebuildMessage(true);
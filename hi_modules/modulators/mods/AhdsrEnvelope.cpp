@@ -315,6 +315,29 @@ void AhdsrEnvelope::calculateBlock(int startSample, int numSamples)
 #endif
 }
 
+bool AhdsrEnvelope::getStaticVoiceValue(int voiceIndex, float& staticValue)
+{
+	AhdsrEnvelopeState* voiceState = static_cast<AhdsrEnvelopeState*>(states[voiceIndex]);
+
+	if (voiceState->current_state != AhdsrEnvelopeState::SUSTAIN)
+		return false;
+
+	const float thisSustainValue = sustain * voiceState->modValues[SustainLevelChain];
+
+	if (std::abs(thisSustainValue - voiceState->lastSustainValue) > 0.001f)
+		return false;
+
+	voiceState->lastSustainValue = thisSustainValue;
+	voiceState->current_value = thisSustainValue;
+
+#if ENABLE_ALL_PEAK_METERS
+	if (voiceIndex == polyManager.getLastStartedVoice()) setOutputValue(thisSustainValue);
+#endif
+
+	staticValue = thisSustainValue;
+	return true;
+}
+
 void AhdsrEnvelope::reset(int voiceIndex)
 {
 	if (isMonophonic)
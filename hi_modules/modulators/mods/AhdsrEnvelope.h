@@ -113,6 +113,9 @@ public:
 
 	void calculateBlock(int startSample, int numSamples);;
 
+	/** Returns the sustain level if the voice is in the sustain phase and the level doesn't need to be ramped. */
+	bool getStaticVoiceValue(int voiceIndex, float& staticValue) override;
+
 	void handleHiseEvent(const HiseEvent &e) override;
 	
 
@@ -321,6 +321,17 @@ void SimpleEnvelope::calculateBlock(int startSample, int numSamples)
 	
 }
 
+bool SimpleEnvelope::getStaticVoiceValue(int voiceIndex, float& staticValue)
+{
+	if (static_cast<SimpleEnvelopeState*>(states[voiceIndex])->current_state != SimpleEnvelopeState::SUSTAIN)
+		return false;
+
+	if (isMonophonic || voiceIndex == polyManager.getLastStartedVoice()) setOutputValue(1.0f);
+
+	staticValue = 1.0f;
+	return true;
+}
+
 void SimpleEnvelope::handleHiseEvent(const HiseEvent &m)
 {
 	EnvelopeModulator::handleHiseEvent(m);
@@ -105,6 +105,9 @@ public:
 
 	void prepareToPlay(double sampleRate, int samplesPerBlock) override;
 	void calculateBlock(int startSample, int numSamples) override;
+
+	/** Returns 1.0f if the voice is in the sustain phase. */
+	bool getStaticVoiceValue(int voiceIndex, float& staticValue) override;
 	void handleHiseEvent(const HiseEvent& m) override;
 	
 	ProcessorEditorBody *createEditor(ProcessorEditor *parentEditor)  override;
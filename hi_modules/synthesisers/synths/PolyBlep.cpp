@@ -72,6 +72,28 @@ inline int64_t bitwiseOrZero(const T &t) {
     return static_cast<int64_t>(t) | 0;
 }
 
+// Branch free versions of blep() and blamp() for the block rendering. They assume that
+// t < dt and t > 1 - dt are never true at the same time, which is guaranteed because
+// frequencies above a quarter of the sample rate are rendered as sine.
+inline double blepBranchFree(double t, double dt) {
+    const double a = t / dt - 1;
+    const double b = (t - 1) / dt + 1;
+
+    return (t < dt ? -a * a : 0.0) + (t > 1 - dt ? b * b : 0.0);
+}
+
+inline double blampBranchFree(double t, double dt) {
+    const double a = t / dt - 1;
+    const double b = (t - 1) / dt + 1;
+
+    return (t < dt ? -1 / 3.0 * a * a * a : 0.0) + (t > 1 - dt ? 1 / 3.0 * b * b * b : 0.0);
+}
+
+// Wraps a phase in the range [0...2) without the int conversion of bitwiseOrZero() which can't be vectorised.
+inline double wrapOnce(double t) {
+    return t >= 1.0 ? t - 1.0 : t;
+}
+
 PolyBLEP::PolyBLEP(double sampleRate, Waveform waveform, double initialFrequency)
         : waveform(waveform), sampleRate(sampleRate), amplitude(1.0f), t(0.0) {
     setSampleRate(sampleRate);
@@ -180,6 +202,126 @@ float PolyBLEP::getAndInc() {
     return sample;
 }
 
+void PolyBLEP::render(float* data, const float* freqModValues, int numSamples) {
+    const bool useSine = waveform == SINE || getFreqInHz() >= sampleRate / 4;
+
+    const bool hasBlockVersion = useSine || waveform == SAWTOOTH || waveform == RAMP || waveform == SQUARE ||
+                                 waveform == RECTANGLE || waveform == TRIANGLE;
+
+    if (!hasBlockVersion) {
+        for (int i = 0; i < numSamples; i++) {
+            if (freqModValues != nullptr)
+                setFreqModulationValue(freqModValues[i]);
+
+            data[i] = getAndInc();
+        }
+
+        return;
+    }
+
+    double phases[BlockChunkSize];
+    double deltas[BlockChunkSize];
+
+    while (numSamples > 0) {
+        const int numThisTime = numSamples < (int)BlockChunkSize ? numSamples : (int)BlockChunkSize;
+
+        // Accumulate the phase without wrapping (this is the only serial part)...
+        if (freqModValues != nullptr) {
+            double phase = t;
+
+            for (int i = 0; i < numThisTime; i++) {
+                deltas[i] = (double)freqModValues[i] * freqInSecondsPerSample;
+                phases[i] = phase;
+                phase += deltas[i];
+            }
+
+            internalFreqValue = deltas[numThisTime - 1];
+            freqModValues += numThisTime;
+            t = phase;
+        } else {
+            for (int i = 0; i < numThisTime; i++) {
+                deltas[i] = internalFreqValue;
+                phases[i] = t + (double)i * internalFreqValue;
+            }
+
+            t += (double)numThisTime * internalFreqValue;
+        }
+
+        // ... and wrap it in a vectorised loop
+        for (int i = 0; i < numThisTime; i++)
+            phases[i] -= std::floor(phases[i]);
+
+        t -= std::floor(t);
+
+        if (useSine) {
+            const float* table = tables->getSineTable();
+            const double tableSize = (double)hise::SharedOscillatorTables::SineTableSize;
+
+            for (int i = 0; i < numThisTime; i++) {
+                const double x = phases[i] * tableSize;
+                const int index = (int)x;
+                const float alpha = (float)(x - (double)index);
+                const int tableIndex = index & hise::SharedOscillatorTables::SineTableMask;
+
+                data[i] = amplitude * (table[tableIndex] + alpha * (table[tableIndex + 1] - table[tableIndex]));
+            }
+        } else switch (waveform) {
+            case SAWTOOTH:
+                for (int i = 0; i < numThisTime; i++) {
+                    const double _t = wrapOnce(phases[i] + 0.5);
+                    const double y = 2 * _t - 1 - blepBranchFree(_t, deltas[i]);
+
+                    data[i] = amplitude * (float)y;
+                }
+                break;
+            case RAMP:
+                for (int i = 0; i < numThisTime; i++) {
+                    const double _t = phases[i];
+                    const double y = 1 - 2 * _t + blepBranchFree(_t, deltas[i]);
+
+                    data[i] = amplitude * (float)y;
+                }
+                break;
+            case SQUARE:
+                for (int i = 0; i < numThisTime; i++) {
+                    const double t1 = phases[i];
+                    const double t2 = wrapOnce(t1 + 0.5);
+                    const double y = (t1 < 0.5 ? 1.0 : -1.0) + blepBranchFree(t1, deltas[i]) - blepBranchFree(t2, deltas[i]);
+
+                    data[i] = amplitude * (float)y;
+                }
+                break;
+            case RECTANGLE:
+                for (int i = 0; i < numThisTime; i++) {
+                    const double t1 = phases[i];
+                    const double t2 = wrapOnce(t1 + 1 - pulseWidth);
+                    const double y = -2 * pulseWidth + (t1 < pulseWidth ? 2.0 : 0.0) + blepBranchFree(t1, deltas[i]) - blepBranchFree(t2, deltas[i]);
+
+                    data[i] = amplitude * (float)y;
+                }
+                break;
+            case TRIANGLE:
+                for (int i = 0; i < numThisTime; i++) {
+                    const double t1 = wrapOnce(phases[i] + 0.25);
+                    const double t2 = wrapOnce(phases[i] + 0.75);
+                    const double x = phases[i] * 4;
+
+                    double y = x >= 3 ? x - 4 : (x > 1 ? 2 - x : x);
+                    y += 4 * deltas[i] * (blampBranchFree(t1, deltas[i]) - blampBranchFree(t2, deltas[i]));
+
+                    data[i] = amplitude * (float)y;
+                }
+                break;
+            default:
+                jassertfalse;
+                break;
+        }
+
+        data += numThisTime;
+        numSamples -= numThisTime;
+    }
+}
+
 float PolyBLEP::sin() const {
     return amplitude * (float)std::sin(TWO_PI * t);
 }
@@ -27,6 +27,7 @@ Permission has been granted to release this port under the WDL/IPlug license:
 
 	- change processing type to float
 	- put in namespace mf
+	- add block rendering with branch free versions of the most common waveforms
 */
 
 namespace mf {
@@ -75,6 +76,14 @@ public:
 
     float getAndInc();
 
+	/** Renders a block of samples.
+	*
+	*	If freqModValues is not nullptr, the frequency is multiplied with these values for each sample (like setFreqModulationValue()). 
+	*	The phase accumulation is done in a first pass so that the sine, saw, ramp, square, rectangle and triangle 
+	*	waveforms can be computed with vectorised loops. The other waveforms are rendered sample by sample.
+	*/
+	void render(float* data, const float* freqModValues, int numSamples);
+
     double getFreqInHz() const;
 
     void sync(double phase);
@@ -94,6 +103,13 @@ protected:
 
 	mutable Random noiseGenerator;
 
+	juce::SharedResourcePointer<hise::SharedOscillatorTables> tables;
+
+	enum
+	{
+		BlockChunkSize = 64
+	};
+
     void setdt(double time);
 
     float sin() const;
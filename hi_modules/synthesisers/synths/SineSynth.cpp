@@ -75,70 +75,11 @@ void SineSynthVoice::calculateBlock(int startSample, int numSamples)
 	
 	if (isPitchModulationActive())
 	{
-		voicePitchValues += startSample;
-
-		while (--numSamples >= 0)
-		{
-			int index = (int)voiceUptime;
-
-			float v1 = sinTable[index & 2047];
-			float v2 = sinTable[(index + 1) & 2047];
-
-			const float alpha = float(voiceUptime) - (float)index;
-			const float invAlpha = 1.0f - alpha;
-
-			const float currentSample = invAlpha * v1 + alpha * v2;
-
-			*leftValues++ = currentSample;
-
-			const double thisPitchValue = *voicePitchValues++;
-
-			voiceUptime += (uptimeDelta * thisPitchValue);
-
-		}
+		voiceUptime = tables->renderSine(leftValues, numSamples, voiceUptime, uptimeDelta, voicePitchValues + startSample);
 	}
 	else
 	{
-		while (numSamples > 4)
-		{
-			for (int i = 0; i < 4; i++)
-			{
-				int index = (int)voiceUptime;
-
-				float v1 = sinTable[index & 2047];
-				float v2 = sinTable[(index + 1) & 2047];
-
-				const float alpha = float(voiceUptime) - (float)index;
-				const float invAlpha = 1.0f - alpha;
-
-				const float currentSample = invAlpha * v1 + alpha * v2;
-
-				*leftValues++ = currentSample;
-
-				voiceUptime += uptimeDelta;
-			}
-
-			numSamples -= 4;
-		}
-
-		while (numSamples > 0)
-		{
-			int index = (int)voiceUptime;
-
-			float v1 = sinTable[index & 2047];
-			float v2 = sinTable[(index + 1) & 2047];
-
-			const float alpha = float(voiceUptime) - (float)index;
-			const float invAlpha = 1.0f - alpha;
-
-			const float currentSample = invAlpha * v1 + alpha * v2;
-
-			*leftValues++ = currentSample;
-
-			voiceUptime += uptimeDelta;
-
-			numSamples--;
-		}
+		voiceUptime = tables->renderSine(leftValues, numSamples, voiceUptime, uptimeDelta);
 	}
 
 	if (saturation != 0.0f)
@@ -167,6 +108,5 @@ void SineSynthVoice::calculateBlock(int startSample, int numSamples)
 
 	getOwnerSynth()->effectChain->renderVoice(voiceIndex, voiceBuffer, startIndex, samplesToCopy);
 
-	FloatVectorOperations::multiply(voiceBuffer.getWritePointer(0, startIndex), modValues + startIndex, samplesToCopy);
-	FloatVectorOperations::multiply(voiceBuffer.getWritePointer(1, startIndex), modValues + startIndex, samplesToCopy);
+	applyVoiceGainValues(modValues, startIndex, samplesToCopy);
 }
@@ -54,10 +54,6 @@ public:
 		ModulatorSynthVoice(ownerSynth),
 		octaveTransposeFactor(1.0)
 	{
-		for(int i = 0; i < 2048; i++)
-		{
-			sinTable[i] = sinf(i * float_Pi / 1024.0f);
-		}
 	};
 
 	bool canPlaySound(SynthesiserSound *) override
@@ -76,7 +72,7 @@ public:
         const double cyclesPerSecond = MidiMessage::getMidiNoteInHertz (midiNoteNumber);
 		const double cyclesPerSample = cyclesPerSecond / getSampleRate();
 
-		uptimeDelta = cyclesPerSample * 2048.0 * octaveTransposeFactor;
+		uptimeDelta = cyclesPerSample * (double)SharedOscillatorTables::SineTableSize * octaveTransposeFactor;
         
         uptimeDelta *= getOwnerSynth()->getMainController()->getGlobalPitchFactor();
     }
@@ -90,7 +86,7 @@ public:
 
 private:
 
-	float sinTable[2048];
+	SharedResourcePointer<SharedOscillatorTables> tables;
 
 	double octaveTransposeFactor;
 
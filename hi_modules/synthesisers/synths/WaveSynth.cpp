@@ -417,57 +417,16 @@ void WaveSynthVoice::calculateBlock(int startSample, int numSamples)
 
 #if USE_MARTIN_FINKE_POLY_BLEP_ALGORITHM
 
-	if (voicePitchValues == nullptr)
-	{
-		if (enableSecondOsc)
-		{
-			while (--numSamples >= 0)
-			{
-				*outL++ = leftGenerator.getAndInc();
-				*outR++ = rightGenerator.getAndInc();
-			}
-		}
-		else
-		{
-			while (--numSamples >= 0)
-			{
-				*outL = leftGenerator.getAndInc();
-				*outR++ = *outL++;
-			}
-		}
-	}
-	else
-	{
+	if (voicePitchValues != nullptr)
 		voicePitchValues += startSample;
 
-		if (enableSecondOsc)
-		{
-			while (--numSamples >= 0)
-			{
-				leftGenerator.setFreqModulationValue(*voicePitchValues);
-				*outL++ = leftGenerator.getAndInc();
-
-				rightGenerator.setFreqModulationValue(*voicePitchValues);
-				*outR++ = rightGenerator.getAndInc();
-				
-				voicePitchValues++;
-			}
-		}
-		else
-		{
-			while (--numSamples >= 0)
-			{
-				leftGenerator.setFreqModulationValue(*voicePitchValues++);
-				
-				*outL = leftGenerator.getAndInc();
-				*outR++ = *outL++;
-			}
-		}
-	}
+	leftGenerator.render(outL, voicePitchValues, numSamples);
 
-	
+	if (enableSecondOsc)
+		rightGenerator.render(outR, voicePitchValues, numSamples);
+	else
+		FloatVectorOperations::copy(outR, outL, numSamples);
 
-	
 
 #else
 
@@ -506,8 +465,7 @@ void WaveSynthVoice::calculateBlock(int startSample, int numSamples)
 
 	getOwnerSynth()->effectChain->renderVoice(voiceIndex, voiceBuffer, startIndex, samplesToCopy);
 
-	FloatVectorOperations::multiply(voiceBuffer.getWritePointer(0, startIndex), modValues + startIndex, samplesToCopy);
-	FloatVectorOperations::multiply(voiceBuffer.getWritePointer(1, startIndex), modValues + startIndex, samplesToCopy);
+	applyVoiceGainValues(modValues, startIndex, samplesToCopy);
 }
 
 void WaveSynthVoice::setOctaveTransposeFactor(double newFactor, bool leftFactor)
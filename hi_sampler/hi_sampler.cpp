@@ -44,6 +44,7 @@ namespace hise
 
 
 #include "sampler/dywapitchtrack/dywapitchtrack.c"
+#include "sampler/ParallelSampleAnalyser.cpp"
 
 #include "sampler/ModulatorSamplerData.cpp"
 #include "sampler/ModulatorSamplerSound.cpp"
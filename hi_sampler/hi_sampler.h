@@ -65,6 +65,7 @@ namespace hise
 
 #include "sampler/dywapitchtrack/dywapitchtrack.h"
 #include "sampler/PitchDetection.h"
+#include "sampler/ParallelSampleAnalyser.h"
 
 #include "sampler/ModulatorSamplerData.h"
 #include "sampler/ModulatorSamplerSound.h"
@@ -943,14 +943,14 @@ void ModulatorSampler::loadSampleMapFromId(const String& sampleMapId)
 #if USE_BACKEND || DONT_EMBED_FILES_IN_FRONTEND
 
 #if USE_BACKEND
-	File f = GET_PROJECT_HANDLER(this).getSubDirectory(ProjectHandler::SubDirectories::SampleMaps).getChildFile(sampleMapId + ".xml");
+	File f = SampleMap::getSampleMapFile(GET_PROJECT_HANDLER(this).getSubDirectory(ProjectHandler::SubDirectories::SampleMaps), sampleMapId);
 #else
     
 #if HISE_IOS
-    File f = ProjectHandler::Frontend::getResourcesFolder().getChildFile("SampleMaps/").getChildFile(sampleMapId + ".xml");
+    File f = SampleMap::getSampleMapFile(ProjectHandler::Frontend::getResourcesFolder().getChildFile("SampleMaps/"), sampleMapId);
 #else
     
-	File f = ProjectHandler::Frontend::getAppDataDirectory().getChildFile("SampleMaps/").getChildFile(sampleMapId + ".xml");
+	File f = SampleMap::getSampleMapFile(ProjectHandler::Frontend::getAppDataDirectory().getChildFile("SampleMaps/"), sampleMapId);
 #endif
 
 	jassert(f.existsAsFile());
@@ -962,14 +962,10 @@ void ModulatorSampler::loadSampleMapFromId(const String& sampleMapId)
 		return;
 	}
 
-	XmlDocument doc(f);
+	ValueTree v = SampleMap::loadValueTreeFromFile(f);
 
-	ScopedPointer<XmlElement> xml = doc.getDocumentElement();
-
-	if (xml != nullptr)
+	if (v.isValid())
 	{
-		ValueTree v = ValueTree::fromXml(*xml);
-
 		static const Identifier unused = Identifier("unused");
 
 		const Identifier oldId = getSampleMap()->getId();
@@ -985,7 +981,7 @@ void ModulatorSampler::loadSampleMapFromId(const String& sampleMapId)
 	}
 	else
 	{
-		Logger::writeToLog("!Error when loading sample map: " + doc.getLastParseError());
+		Logger::writeToLog("!Error when loading sample map: " + f.getFullPathName());
 		return;
 	}
 
@@ -120,6 +120,9 @@ public:
 
 	void restoreFromValueTree(const ValueTree &v) override;
 	ValueTree exportAsValueTree() const override;
+
+	/** The sounds can be edited without notifying the sampler synchronously, so the sample map is always exported. */
+	bool canCacheValueTree() const override { return false; }
 	
 	float getAttribute(int parameterIndex) const override;;
 	void setInternalAttribute(int parameterIndex, float newValue) override;;
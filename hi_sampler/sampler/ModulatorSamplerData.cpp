@@ -218,22 +218,15 @@ void ThumbnailHandler::run()
 
 	AudioThumbnailCache *cacheToUse = nullptr;
 
+	StringArray filesToAnalyse;
+
 	if(addThumbNailsToExistingCache)
 	{
 		cacheToUse = &sampler->getCache();
 
-		const int numSamplesToCache = fileNamesToLoad.size();
-
-		jassert(numSamplesToCache > 0);
+		jassert(fileNamesToLoad.size() > 0);
 
-		for(int i = 0; i < numSamplesToCache; i++)
-		{
-			if(threadShouldExit()) return;
-			
-			setProgress((double)i / (double)numSamplesToCache);
-
-			saveThumbnail(cacheToUse, afm, File(fileNamesToLoad[i]));
-		}
+		filesToAnalyse = fileNamesToLoad;
 	}
 	else
 	{
@@ -246,15 +239,15 @@ void ThumbnailHandler::run()
 
 		while(iterator.next())
 		{
-			if(threadShouldExit()) return;
-
-			setProgress(iterator.getEstimatedProgress());
-
-			saveThumbnail(writeCache, afm, iterator.getFile());
-
+			filesToAnalyse.add(iterator.getFile().getFullPathName());
 		}		
 	}
 
+	ParallelSampleAnalyser analyser(afm, ParallelSampleAnalyser::CreateThumbnail, cacheToUse);
+
+	if (!analyser.analyse(filesToAnalyse, this, getProgressValue()))
+		return;
+
 	File outputFile = getThumbnailFile(sampler);
     
     FileOutputStream outputStream(outputFile);
@@ -491,13 +484,13 @@ void SampleMap::save()
 		fileToUse = rootDirectory;
 	}
 
-	FileChooser fc("Save SampleMap", fileToUse, "*.xml", true);
+	FileChooser fc("Save SampleMap", fileToUse, "*.xml;*" + getBinaryFileExtension(), true);
 
 	if (fc.browseForFileToSave(true))
 	{
 		File f = fc.getResult();
 
-		auto name = f.getRelativePathFrom(rootDirectory).upToFirstOccurrenceOf(".xml", false, true);
+		auto name = f.getRelativePathFrom(rootDirectory).upToLastOccurrenceOf(f.getFileExtension(), false, true);
 
 		name = name.replace(File::separatorString, "/");
 
@@ -505,11 +498,7 @@ void SampleMap::save()
 
 		mode = SaveMode::MultipleFiles;
 
-		f.deleteFile();
-
-		ValueTree v = exportAsValueTree();
-		ScopedPointer<XmlElement> xml = v.createXml();
-		xml->writeToFile(f, "");
+		writeSampleMapFile(exportAsValueTree(), f);
 
 		changed = false;
 	}
@@ -533,33 +522,16 @@ void SampleMap::loadSamplesFromDirectory(const ValueTree &v)
 
 	String fileName = v.getProperty("FileName", String());
 
-	const ValueTree *treeToUse;
-
-	ValueTree globalTree;
-	ValueTree absoluteTree;
-
-	if ((bool)v.getProperty("UseGlobalFolder", false) == true)
-	{
-		globalTree = v.createCopy();
-
-		for (int i = 0; i < globalTree.getNumChildren(); i++)
-		{
-			const String sampleFileName = v.getChild(i).getProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::FileName), String());
-
-			jassert(sampler->isReference(sampleFileName));
+	const ValueTree *treeToUse = &v;
 
-			globalTree.getChild(i).setProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::FileName), sampler->getFile(sampleFileName, PresetPlayerHandler::StreamedSampleFolder).getFullPathName(), nullptr);
-		}
+	// The file references are resolved for each sample before it is added instead of copying the whole tree.
+	const bool useGlobalFolder = (bool)v.getProperty("UseGlobalFolder", false);
 
-		treeToUse = &globalTree;
-	}
-	else
+	if (!useGlobalFolder)
 	{
 		if (fileName.isNotEmpty()) fileOnDisk = File(fileName);
 
 		mode = (SaveMode)(int)v.getProperty("SaveMode", (int)Undefined);
-
-		treeToUse = &v;
 	}
 
 	sampler->deleteAllSounds();
@@ -585,11 +557,28 @@ void SampleMap::loadSamplesFromDirectory(const ValueTree &v)
     ModulatorSamplerSoundPool *pool = sampler->getMainController()->getSampleManager().getModulatorSamplerSoundPool();
     pool->setUpdatePool(false);
     
+	static const Identifier fileNameId = ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::FileName);
+
 	for(int i = 0; i < treeToUse->getNumChildren(); i++)
 	{
 		try
 		{
-			sampler->addSamplerSound(treeToUse->getChild(i), i);
+			if (useGlobalFolder)
+			{
+				ValueTree child = treeToUse->getChild(i).createCopy();
+
+				const String sampleFileName = child.getProperty(fileNameId, String());
+
+				jassert(sampler->isReference(sampleFileName));
+
+				child.setProperty(fileNameId, sampler->getFile(sampleFileName, PresetPlayerHandler::StreamedSampleFolder).getFullPathName(), nullptr);
+
+				sampler->addSamplerSound(child, i);
+			}
+			else
+			{
+				sampler->addSamplerSound(treeToUse->getChild(i), i);
+			}
 		}
 		catch(StreamingSamplerSound::LoadingError l)
 		{
@@ -817,20 +806,20 @@ void SampleMap::load(const File &f)
 	}
 #endif
 
-	ScopedPointer<XmlElement> xml = XmlDocument::parse(f);
+	ValueTree v = loadValueTreeFromFile(f);
 
 	File fileToUse = f;
 
-	if(xml == nullptr)
+	if(!v.isValid())
 	{
 		if(NativeMessageBox::showOkCancelBox(AlertWindow::WarningIcon, "Missing Samplemap", "The samplemap " + f.getFullPathName() + " wasn't found. Click OK to search or Cancel to skip loading"))
 		{
-			FileChooser fc("Resolve SampleMap reference", f, "*.xml");
+			FileChooser fc("Resolve SampleMap reference", f, "*.xml;*" + getBinaryFileExtension());
 
 			if(fc.browseForFileToOpen())
 			{
 				fileToUse = fc.getResult();
-				xml = XmlDocument::parse(fileToUse);
+				v = loadValueTreeFromFile(fileToUse);
 			}
 			else
 			{
@@ -847,16 +836,18 @@ void SampleMap::load(const File &f)
 
 	}
 
-	jassert(xml != nullptr);
+	if (!v.isValid())
+	{
+		debugError(sampler, "Error loading " + fileToUse.getFullPathName());
+		return;
+	}
 
 	static const Identifier sm("samplemap");
 
-	ValueTree v = ValueTree::fromXml(*xml);
-
 #if USE_BACKEND
 	if (v.getType() != sm)
 	{
-		PresetHandler::showMessageWindow("Invalid Samplemap", "The XML you tried to load is not a valid samplemap. Detected Type: " + v.getType().toString(), PresetHandler::IconType::Error);
+		PresetHandler::showMessageWindow("Invalid Samplemap", "The file you tried to load is not a valid samplemap. Detected Type: " + v.getType().toString(), PresetHandler::IconType::Error);
 		return;
 	}
 #endif
@@ -1171,3 +1162,143 @@ void MonolithExporter::updateSampleMap()
 		}
 	}
 }
+
+File SampleMap::getSampleMapFile(const File& sampleMapDirectory, const String& sampleMapId)
+{
+	File binaryFile = sampleMapDirectory.getChildFile(sampleMapId + getBinaryFileExtension());
+	File xmlFile = sampleMapDirectory.getChildFile(sampleMapId + ".xml");
+
+	if (!binaryFile.existsAsFile())
+		return xmlFile;
+
+	if (!xmlFile.existsAsFile())
+		return binaryFile;
+
+	return xmlFile.getLastModificationTime() > binaryFile.getLastModificationTime() ? xmlFile : binaryFile;
+}
+
+bool SampleMap::writeSampleMapFile(const ValueTree& v, const File& f)
+{
+	const bool isBinary = f.hasFileExtension(getBinaryFileExtension());
+
+	bool ok;
+
+	if (isBinary)
+	{
+		ok = writeValueTreeToBinaryFile(v, f);
+	}
+	else
+	{
+		f.deleteFile();
+
+		ScopedPointer<XmlElement> xml = v.createXml();
+		ok = xml != nullptr && xml->writeToFile(f, "");
+	}
+
+	if (ok)
+		f.withFileExtension(isBinary ? ".xml" : getBinaryFileExtension()).deleteFile();
+
+	return ok;
+}
+
+ValueTree SampleMap::loadValueTreeFromFile(const File& f)
+{
+	if (f.hasFileExtension(getBinaryFileExtension()))
+	{
+		MemoryMappedFile mmf(f, MemoryMappedFile::readOnly);
+
+		if (mmf.getData() != nullptr && mmf.getSize() != 0)
+			return ValueTree::readFromData(mmf.getData(), mmf.getSize());
+
+		return ValueTree();
+	}
+
+	ScopedPointer<XmlElement> xml = XmlDocument::parse(f);
+
+	if (xml != nullptr)
+		return ValueTree::fromXml(*xml);
+
+	return ValueTree();
+}
+
+bool SampleMap::writeValueTreeToBinaryFile(const ValueTree& v, const File& f)
+{
+	f.deleteFile();
+
+	FileOutputStream fos(f);
+
+	if (fos.failedToOpen())
+		return false;
+
+	v.writeToStream(fos);
+	fos.flush();
+
+	return fos.getStatus().wasOk();
+}
+
+#if HI_RUN_UNIT_TESTS
+
+/** Checks that saving a sample map in one format never leaves a stale file in the other format behind. */
+class SampleMapFileTest : public UnitTest
+{
+public:
+
+	SampleMapFileTest() :
+		UnitTest("Testing sample map files")
+	{
+
+	}
+
+	void runTest() override
+	{
+		File dir = File::getSpecialLocation(File::tempDirectory).getNonexistentChildFile("SampleMapFileTest", "", false);
+		dir.createDirectory();
+
+		ValueTree v1("samplemap");
+		v1.setProperty("ID", "Test", nullptr);
+		v1.setProperty("Version", 1, nullptr);
+
+		ValueTree v2 = v1.createCopy();
+		v2.setProperty("Version", 2, nullptr);
+
+		File xmlFile = dir.getChildFile("Test.xml");
+		File binaryFile = dir.getChildFile("Test" + SampleMap::getBinaryFileExtension());
+
+		beginTest("Saving removes the other format");
+
+		expect(SampleMap::writeSampleMapFile(v1, binaryFile));
+		expect(binaryFile.existsAsFile());
+
+		expect(SampleMap::writeSampleMapFile(v2, xmlFile));
+		expect(xmlFile.existsAsFile());
+		expect(!binaryFile.existsAsFile(), "The binary file is stale");
+
+		File loadedFile = SampleMap::getSampleMapFile(dir, "Test");
+		expect(loadedFile == xmlFile);
+		expectEquals<int>(SampleMap::loadValueTreeFromFile(loadedFile).getProperty("Version"), 2);
+
+		expect(SampleMap::writeSampleMapFile(v1, binaryFile));
+		expect(!xmlFile.existsAsFile(), "The XML file is stale");
+		expectEquals<int>(SampleMap::loadValueTreeFromFile(SampleMap::getSampleMapFile(dir, "Test")).getProperty("Version"), 1);
+
+		beginTest("The newer file is used if both formats exist");
+
+		ScopedPointer<XmlElement> xml = v2.createXml();
+		xml->writeToFile(xmlFile, "");
+
+		const Time now = Time::getCurrentTime();
+
+		binaryFile.setLastModificationTime(now - RelativeTime::hours(1));
+		xmlFile.setLastModificationTime(now);
+		expect(SampleMap::getSampleMapFile(dir, "Test") == xmlFile);
+
+		binaryFile.setLastModificationTime(now + RelativeTime::hours(1));
+		expect(SampleMap::getSampleMapFile(dir, "Test") == binaryFile);
+
+		dir.deleteRecursively();
+	}
+};
+
+static SampleMapFileTest sampleMapFileTest;
+
+#endif
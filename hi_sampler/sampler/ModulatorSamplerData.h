@@ -111,27 +111,6 @@ private:
 		new ThumbnailHandler(directoryToLoad, sampler);
 	}
 
-	void saveThumbnail(AudioThumbnailCache *cache, AudioFormatManager &afm, const File &file)
-	{
-		AudioThumbnail thumb(256, afm, *cache);
-		ScopedPointer<AudioFormatReader> afr = afm.createReaderFor(new FileInputStream(file));
-		
-        if(afr != nullptr)
-        {
-            AudioSampleBuffer buffer(afr->numChannels, (int)afr->lengthInSamples);
-            
-            thumb.reset(afr->numChannels, afr->sampleRate, afr->lengthInSamples);
-            afr->read(&buffer, 0, (int)afr->lengthInSamples, 0, true, true);
-            thumb.addBlock(0, buffer, 0, buffer.getNumSamples());
-            cache->storeThumb(thumb, file.hashCode64());
-        }
-        else
-        {
-            jassertfalse;
-        }
-        
-	}
-
 	void run() override;
 
 	const bool addThumbNailsToExistingCache;
@@ -288,6 +267,30 @@ public:
     
 	static String checkReferences(ValueTree& v, const File& sampleRootFolder, Array<File>& sampleList);
 
+	/** The file extension for sample maps that are stored as binary ValueTree. */
+	static String getBinaryFileExtension() { return ".hsm"; }
+
+	/** Returns the file for the given sample map ID.
+	*
+	*	If both an XML and a binary version exist, the file that was modified last is used.
+	*/
+	static File getSampleMapFile(const File& sampleMapDirectory, const String& sampleMapId);
+
+	/** Writes the sample map to the file using the format of its extension and removes the file with the other format.
+	*
+	*	This makes sure that a stale version of the sample map is never picked up by getSampleMapFile().
+	*/
+	static bool writeSampleMapFile(const ValueTree& v, const File& f);
+
+	/** Parses the XML or binary sample map file and returns the ValueTree (or an invalid tree if the file can't be parsed).
+	*
+	*	Binary sample maps are memory mapped and read directly without going through the XML parser.
+	*/
+	static ValueTree loadValueTreeFromFile(const File& f);
+
+	/** Writes the sample map as binary ValueTree. The data is the same as the XML file, so you can convert it back and forth. */
+	static bool writeValueTreeToBinaryFile(const ValueTree& v, const File& f);
+
 private:
 
 	void resolveMissingFiles(ValueTree &treeToUse);
@@ -134,15 +134,22 @@ void ModulatorSamplerVoice::calculateBlock(int startSample, int numSamples)
 
 	getOwnerSynth()->effectChain->renderVoice(voiceIndex, voiceBuffer, startIndex, samplesInBlock);
 
-	FloatVectorOperations::multiply(voiceBuffer.getWritePointer(0, startIndex), modValues + startIndex, samplesInBlock);
-	FloatVectorOperations::multiply(voiceBuffer.getWritePointer(1, startIndex), modValues + startIndex, samplesInBlock);
+	// A constant gain modulation (eg. sustain phase) is applied together with the other gain factors
+	float constantGain = 1.0f;
+
+	if (!isVoiceGainConstant(startIndex, constantGain))
+	{
+		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(0, startIndex), modValues + startIndex, samplesInBlock);
+		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(1, startIndex), modValues + startIndex, samplesInBlock);
+		constantGain = 1.0f;
+	}
 
 	const float propertyGain = currentlyPlayingSamplerSound->getPropertyVolume();
 	const float normalizationGain = currentlyPlayingSamplerSound->getNormalizedPeak();
 	const float lGain = currentlyPlayingSamplerSound->getBalance(false);
 	const float rGain = currentlyPlayingSamplerSound->getBalance(true);
-	const float totalL = propertyGain * normalizationGain * lGain * velocityXFadeValue;
-	const float totalR = propertyGain * normalizationGain * rGain * velocityXFadeValue;
+	const float totalL = constantGain * propertyGain * normalizationGain * lGain * velocityXFadeValue;
+	const float totalR = constantGain * propertyGain * normalizationGain * rGain * velocityXFadeValue;
 
 	if (totalL != 1.0f) FloatVectorOperations::multiply(voiceBuffer.getWritePointer(0, startIndex), totalL, samplesInBlock);
 	if (totalR != 1.0f) FloatVectorOperations::multiply(voiceBuffer.getWritePointer(1, startIndex), totalR, samplesInBlock);
@@ -296,6 +303,9 @@ ModulatorSamplerVoice(ownerSynth)
 		wrappedVoices.getLast()->setTemporaryVoiceBuffer(static_cast<ModulatorSampler*>(ownerSynth)->getTemporaryVoiceBuffer());
 		wrappedVoices.getLast()->setDebugLogger(&ownerSynth->getMainController()->getDebugLogger());
 	}
+
+	if (getOwnerSynth()->getBlockSize() > 0)
+		sharedIndexes.setSize(getOwnerSynth()->getBlockSize());
 }
 
 void MultiMicModulatorSamplerVoice::startNote(int midiNoteNumber, float velocity, SynthesiserSound* s, int /*currentPitchWheelPosition*/)
@@ -355,6 +365,10 @@ void MultiMicModulatorSamplerVoice::calculateBlock(int startSample, int numSampl
 
 	voiceBuffer.clear();
 
+	// The mic positions are all playing at the same position with the same pitch, so the
+	// interpolation positions are calculated once and used for every mic position.
+	bool indexesCalculated = false;
+
 	for (int i = 0; i < wrappedVoices.size(); i++)
 	{
 		const StreamingSamplerSound *sound = wrappedVoices[i]->getLoadedSound();
@@ -371,7 +385,22 @@ void MultiMicModulatorSamplerVoice::calculateBlock(int startSample, int numSampl
 
 		AudioSampleBuffer channelBuffer(channels, 2, voiceBuffer.getNumSamples());
 
-		wrappedVoices[i]->renderNextBlock(channelBuffer, startSample, numSamples);
+		if (numSamples > sharedIndexes.size)
+		{
+			// prepareToPlay() wasn't called with the correct block size...
+			jassertfalse;
+			wrappedVoices[i]->renderNextBlock(channelBuffer, startSample, numSamples);
+		}
+		else
+		{
+			if (!indexesCalculated)
+			{
+				sharedIndexes.calculate(voicePitchValues, startSample, fmod(wrappedVoices[i]->voiceUptime, 1.0), wrappedVoices[i]->uptimeDelta, numSamples);
+				indexesCalculated = true;
+			}
+
+			wrappedVoices[i]->renderNextBlockWithSharedIndexes(channelBuffer, startSample, numSamples, sharedIndexes);
+		}
 
 		voiceUptime = wrappedVoices[i]->voiceUptime;
 
@@ -389,8 +418,14 @@ void MultiMicModulatorSamplerVoice::calculateBlock(int startSample, int numSampl
 	const float lGain = currentlyPlayingSamplerSound->getBalance(false);
 	const float rGain = currentlyPlayingSamplerSound->getBalance(true);
 
-	const float lSum = propertyGain * normalizationGain * lGain * velocityXFadeValue;
-	const float rSum = propertyGain * normalizationGain * rGain * velocityXFadeValue;
+	float constantGain = 1.0f;
+	const bool gainIsConstant = isVoiceGainConstant(startIndex, constantGain);
+
+	if (!gainIsConstant)
+		constantGain = 1.0f;
+
+	const float lSum = constantGain * propertyGain * normalizationGain * lGain * velocityXFadeValue;
+	const float rSum = constantGain * propertyGain * normalizationGain * rGain * velocityXFadeValue;
 
 	
 
@@ -399,8 +434,11 @@ void MultiMicModulatorSamplerVoice::calculateBlock(int startSample, int numSampl
 		if (wrappedVoices[i]->getLoadedSound() == nullptr) continue;
 
 		// Apply Modulation
-		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(2*i, startIndex), modValues + startIndex, samplesInBlock);
-		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(2*i + 1, startIndex), modValues + startIndex, samplesInBlock);
+		if (!gainIsConstant)
+		{
+			FloatVectorOperations::multiply(voiceBuffer.getWritePointer(2*i, startIndex), modValues + startIndex, samplesInBlock);
+			FloatVectorOperations::multiply(voiceBuffer.getWritePointer(2*i + 1, startIndex), modValues + startIndex, samplesInBlock);
+		}
 
 		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(2*i, startIndex), lSum, samplesInBlock);
 		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(2*i + 1, startIndex), rSum, samplesInBlock);
@@ -434,6 +472,8 @@ void MultiMicModulatorSamplerVoice::prepareToPlay(double sampleRate, int samples
 
 	voiceBuffer.setSize(wrappedVoices.size() * 2, samplesPerBlock);
 
+	sharedIndexes.setSize(samplesPerBlock);
+
 	for (int i = 0; i < wrappedVoices.size(); i++)
 	{
 		wrappedVoices[i]->prepareToPlay(sampleRate, samplesPerBlock);
@@ -147,6 +147,9 @@ private:
 
 	OwnedArray<StreamingSamplerVoice> wrappedVoices;
 
+	// All mic positions play at the same position, so the interpolation is only calculated once per block.
+	StreamingSamplerVoice::InterpolationIndexes sharedIndexes;
+
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MultiMicModulatorSamplerVoice)
 };
 
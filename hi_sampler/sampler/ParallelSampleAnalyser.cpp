@@ -0,0 +1,233 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for cloused source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+bool ParallelSampleAnalyser::Cache::getResult(int64 hash, int flagsNeeded, Result& r) const
+{
+	ScopedLock sl(lock);
+
+	if (results.contains(hash))
+	{
+		const Result cachedResult = results[hash];
+
+		if ((cachedResult.analysedFlags & flagsNeeded) == flagsNeeded)
+		{
+			r = cachedResult;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ParallelSampleAnalyser::Cache::addResult(const Result& r)
+{
+	ScopedLock sl(lock);
+
+	if (results.contains(r.hash))
+	{
+		// Merge the flags if the file was analysed before with other options
+		Result merged = results[r.hash];
+
+		if (r.analysedFlags & DetectPitch)
+		{
+			merged.pitch = r.pitch;
+			merged.rootNote = r.rootNote;
+		}
+
+		if (r.analysedFlags & CalculatePeak)
+			merged.peak = r.peak;
+
+		merged.analysedFlags |= r.analysedFlags;
+
+		results.set(r.hash, merged);
+	}
+	else
+	{
+		results.set(r.hash, r);
+	}
+}
+
+void ParallelSampleAnalyser::Cache::clear()
+{
+	ScopedLock sl(lock);
+	results.clear();
+}
+
+class ParallelSampleAnalyser::AnalysisJob : public ThreadPoolJob
+{
+public:
+
+	AnalysisJob(ParallelSampleAnalyser& parent_, int index_) :
+		ThreadPoolJob("Sample Analysis"),
+		parent(parent_),
+		index(index_)
+	{}
+
+	JobStatus runJob() override
+	{
+		if (!shouldExit())
+			parent.analyseFile(index, File(parent.filesToAnalyse[index]));
+
+		return jobHasFinished;
+	}
+
+private:
+
+	ParallelSampleAnalyser& parent;
+	const int index;
+};
+
+ParallelSampleAnalyser::ParallelSampleAnalyser(AudioFormatManager& afm_, int flags_, AudioThumbnailCache* thumbnailCache_) :
+	afm(afm_),
+	flags(flags_),
+	thumbnailCache(thumbnailCache_),
+	pool(jmax<int>(1, SystemStats::getNumCpus()))
+{
+	jassert(thumbnailCache != nullptr || (flags & CreateThumbnail) == 0);
+}
+
+ParallelSampleAnalyser::~ParallelSampleAnalyser()
+{
+	pool.removeAllJobs(true, 5000);
+}
+
+bool ParallelSampleAnalyser::analyse(const StringArray& fileNames, Thread* callingThread, double* progress)
+{
+	filesToAnalyse = fileNames;
+
+	results.clearQuick();
+	results.insertMultiple(0, Result(), fileNames.size());
+
+	for (int i = 0; i < fileNames.size(); i++)
+		pool.addJob(new AnalysisJob(*this, i), true);
+
+	const int numFiles = fileNames.size();
+
+	while (pool.getNumJobs() > 0)
+	{
+		if (callingThread != nullptr && callingThread->threadShouldExit())
+		{
+			pool.removeAllJobs(true, 5000);
+			return false;
+		}
+
+		if (progress != nullptr && numFiles > 0)
+			*progress = (double)(numFiles - pool.getNumJobs()) / (double)numFiles;
+
+		Thread::sleep(20);
+	}
+
+	if (progress != nullptr)
+		*progress = 1.0;
+
+	return true;
+}
+
+int64 ParallelSampleAnalyser::getFileHash(const File& f)
+{
+	return f.getFullPathName().hashCode64() ^ (f.getSize() * 31) ^ f.getLastModificationTime().toMilliseconds();
+}
+
+int ParallelSampleAnalyser::getRootNoteForPitch(double pitch)
+{
+	if (pitch <= 0.0)
+		return -1;
+
+	const int rootNote = roundToInt(69.0 + 12.0 * std::log(pitch / 440.0) / std::log(2.0));
+
+	return isPositiveAndBelow(rootNote, 128) ? rootNote : -1;
+}
+
+void ParallelSampleAnalyser::analyseFile(int index, const File& f)
+{
+	Result& r = results.getReference(index);
+
+	r.hash = getFileHash(f);
+
+	const int flagsWithoutThumbnail = flags & ~CreateThumbnail;
+	bool needsThumbnail = false;
+
+	if (flags & CreateThumbnail)
+	{
+		AudioThumbnail existingThumbnail(256, afm, *thumbnailCache);
+		needsThumbnail = !thumbnailCache->loadThumb(existingThumbnail, f.hashCode64());
+	}
+
+	if (!needsThumbnail && cache->getResult(r.hash, flagsWithoutThumbnail, r))
+		return;
+
+	ScopedPointer<AudioFormatReader> afr = afm.createReaderFor(new FileInputStream(f));
+
+	if (afr == nullptr)
+	{
+		jassertfalse;
+		return;
+	}
+
+	// Read the file only once and use the data for every analysis
+	AudioSampleBuffer buffer(afr->numChannels, (int)afr->lengthInSamples);
+	afr->read(&buffer, 0, (int)afr->lengthInSamples, 0, true, true);
+
+	if (needsThumbnail)
+	{
+		AudioThumbnail thumb(256, afm, *thumbnailCache);
+
+		thumb.reset(afr->numChannels, afr->sampleRate, afr->lengthInSamples);
+		thumb.addBlock(0, buffer, 0, buffer.getNumSamples());
+		thumbnailCache->storeThumb(thumb, f.hashCode64());
+	}
+
+	if (flags & CalculatePeak)
+	{
+		r.peak = buffer.getMagnitude(0, buffer.getNumSamples());
+	}
+
+	if (flags & DetectPitch)
+	{
+		const int numSamplesPerDetection = PitchDetection::getNumSamplesNeeded(afr->sampleRate);
+
+		double pitch = 0.0;
+
+		for (int startSample = 0; pitch == 0.0 && startSample + numSamplesPerDetection < buffer.getNumSamples(); startSample += numSamplesPerDetection)
+		{
+			pitch = PitchDetection::detectPitch(buffer, startSample, numSamplesPerDetection, afr->sampleRate);
+		}
+
+		r.pitch = pitch;
+		r.rootNote = getRootNoteForPitch(pitch);
+	}
+
+	r.analysedFlags = flagsWithoutThumbnail;
+
+	cache->addResult(r);
+}
@@ -0,0 +1,129 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for cloused source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#ifndef PARALLEL_SAMPLE_ANALYSER_H_INCLUDED
+#define PARALLEL_SAMPLE_ANALYSER_H_INCLUDED
+
+/** Analyses a list of audio files using all available cores.
+*	@ingroup sampler
+*
+*	Every file is read only once and the data is used for all requested analysis types (pitch detection, peak value and thumbnail).
+*	The results are stored in a cache that is shared between all instances, so importing the same files again won't touch the disk.
+*
+*	This is used by the SampleImporter and the ThumbnailHandler.
+*/
+class ParallelSampleAnalyser
+{
+public:
+
+	enum AnalysisFlags
+	{
+		DetectPitch = 0x01,
+		CalculatePeak = 0x02,
+		CreateThumbnail = 0x04
+	};
+
+	/** The analysis data of a single file. */
+	struct Result
+	{
+		int64 hash = 0;
+		int analysedFlags = 0;
+
+		double pitch = 0.0;
+		int rootNote = -1;
+		float peak = 0.0f;
+	};
+
+	/** A cache that stores the analysis results for each file hash. */
+	class Cache
+	{
+	public:
+
+		/** Looks for a result with the given hash and copies it into the result if all flags are analysed. */
+		bool getResult(int64 hash, int flagsNeeded, Result& r) const;
+
+		void addResult(const Result& r);
+
+		void clear();
+
+	private:
+
+		CriticalSection lock;
+		HashMap<int64, Result> results;
+	};
+
+	/** Creates an analyser that uses the given format manager to create the readers.
+	*
+	*	If you want thumbnails, pass in the cache that will be used to store them.
+	*/
+	ParallelSampleAnalyser(AudioFormatManager& afm, int flags, AudioThumbnailCache* thumbnailCache=nullptr);
+
+	~ParallelSampleAnalyser();
+
+	/** Analyses all files and waits until every file is done.
+	*
+	*	If you call this from a background thread, pass it in so that the analysis can be cancelled.
+	*	The progress will be written to the given double pointer. Returns false if the analysis was cancelled.
+	*/
+	bool analyse(const StringArray& fileNames, Thread* callingThread=nullptr, double* progress=nullptr);
+
+	/** Returns the result for the file with the given index. */
+	const Result& getResult(int index) const { return results.getReference(index); }
+
+	/** Creates a hash from the file path, size and modification time. */
+	static int64 getFileHash(const File& f);
+
+	/** Returns the MIDI note number for the given frequency or -1 if it is not in the MIDI range. */
+	static int getRootNoteForPitch(double pitch);
+
+private:
+
+	class AnalysisJob;
+
+	void analyseFile(int index, const File& f);
+
+	AudioFormatManager& afm;
+	const int flags;
+	AudioThumbnailCache* thumbnailCache;
+
+	SharedResourcePointer<Cache> cache;
+
+	Array<Result> results;
+	StringArray filesToAnalyse;
+
+	ThreadPool pool;
+
+	JUCE_DECLARE_NON_COPYABLE(ParallelSampleAnalyser);
+};
+
+#endif
@@ -278,43 +278,23 @@ void SampleImporter::loadAudioFilesUsingFileName(Component *childComponentOfMain
 
 void SampleImporter::loadAudioFilesUsingPitchDetection(Component* /*childComponentOfMainEditor*/, ModulatorSampler *sampler, const StringArray &fileNames, bool /*useVelocityAutomap*/)
 {
-	Array<Range<double>> freqRanges;
+	// Detect the pitch and create the thumbnails in one pass over the files
+	ParallelSampleAnalyser analyser(sampler->getMainController()->getSampleManager().getModulatorSamplerSoundPool()->afm,
+									ParallelSampleAnalyser::DetectPitch | ParallelSampleAnalyser::CreateThumbnail,
+									&sampler->getCache());
 
-	freqRanges.add(Range<double>(0, MidiMessage::getMidiNoteInHertz(1)/2));
-
-	for(int i = 1; i < 126; i++)
-	{
-		const double thisPitch = MidiMessage::getMidiNoteInHertz(i);
-		const double nextPitch = MidiMessage::getMidiNoteInHertz(i+1);
-		const double prevPitch = MidiMessage::getMidiNoteInHertz(i-1);
-
-		const double lowerLimit = thisPitch - (thisPitch-prevPitch) * 0.5;
-		const double upperLimit = thisPitch + (nextPitch - thisPitch) * 0.5;
-
-		freqRanges.add(Range<double>(lowerLimit, upperLimit));		
-	}
-
-	const int numSamplesPerDetection = PitchDetection::getNumSamplesNeeded(sampler->Processor::getSampleRate());
-	AudioSampleBuffer pitchDetectionBuffer(2, numSamplesPerDetection);
+	analyser.analyse(fileNames);
 
 	const int startIndex = sampler->getNumSounds();
 
 	for(int i = 0; i < fileNames.size(); i++)
 	{
-		const double pitch = PitchDetection::detectPitch(File(fileNames[i]), pitchDetectionBuffer, sampler->Processor::getSampleRate());
-		int rootNote = -1;
+		const int rootNote = analyser.getResult(i).rootNote;
 
-		for(int j = 0; j <freqRanges.size(); j++)
-		{
-			if(freqRanges[j].contains(pitch))
-			{
-				debugToConsole(sampler, "Detected Root Note: " + MidiMessage::getMidiNoteName(j, true, true, 3));
-				rootNote = j;
-				break;
-			}
-		}
-
-		if(rootNote == -1) debugError(sampler, "Root note cannot be detected, skipping sample " + fileNames[i]);
+		if (rootNote != -1)
+			debugToConsole(sampler, "Detected Root Note: " + MidiMessage::getMidiNoteName(rootNote, true, true, 3));
+		else
+			debugError(sampler, "Root note cannot be detected, skipping sample " + fileNames[i]);
 		
 		SamplerSoundBasicData data;
 
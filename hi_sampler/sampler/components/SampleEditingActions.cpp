@@ -292,20 +292,63 @@ public:
 		addBasicComponents(false);
 	}
 
+	/** Scans the peak of a single sound so that the files can be read on all cores. */
+	class PeakScanJob : public ThreadPoolJob
+	{
+	public:
+
+		PeakScanJob(ModulatorSamplerSound* sound_) :
+			ThreadPoolJob("Scan peak"),
+			sound(sound_)
+		{}
+
+		JobStatus runJob() override
+		{
+			if (sound.get() != nullptr && !shouldExit())
+				sound->calculateNormalizedPeak();
+
+			return jobHasFinished;
+		}
+
+	private:
+
+		WeakReference<ModulatorSamplerSound> sound;
+	};
+
 	void run() override
 	{
 		Array<WeakReference<ModulatorSamplerSound>> soundList = handler->getSelection().getItemArray();
 
+		showStatusMessage("Scanning the peak values of " + String(soundList.size()) + " samples");
+
+		ThreadPool pool(jmax<int>(1, SystemStats::getNumCpus()));
+
 		for (int i = 0; i < soundList.size(); i++)
 		{
-			if (soundList[i].get() == nullptr) continue;
+			// Only the sounds that are about to be normalized need a peak
+			if (soundList[i].get() != nullptr && !(bool)soundList[i]->getProperty(ModulatorSamplerSound::Normalized))
+				pool.addJob(new PeakScanJob(soundList[i].get()), true);
+		}
+
+		const int numJobs = pool.getNumJobs();
 
+		while (pool.getNumJobs() > 0)
+		{
 			if (threadShouldExit())
+			{
+				pool.removeAllJobs(true, 5000);
 				return;
+			}
 
-			setProgress((double)i / (double)soundList.size());
+			setProgress((double)(numJobs - pool.getNumJobs()) / (double)jmax<int>(1, numJobs));
+
+			Thread::sleep(20);
+		}
+
+		for (int i = 0; i < soundList.size(); i++)
+		{
+			if (soundList[i].get() == nullptr) continue;
 
-			showStatusMessage("Normalizing " + soundList[i]->getProperty(ModulatorSamplerSound::FileName).toString());
 			soundList[i].get()->toggleBoolProperty(ModulatorSamplerSound::Normalized, dontSendNotification);
 		};
 	}
@@ -131,15 +131,6 @@ void SampleComponent::changeListenerCallback(SafeChangeBroadcaster *b)
 
 #pragma warning( pop )
 
-void SampleComponent::timerCallback()
-{
-	transparency *= 0.9f;
-	if(transparency <= 0.3f)
-	{
-		stopTimer();
-	}
-}
-
 void SampleComponent::drawSampleRectangle(Graphics &g, Rectangle<int> areaInt)
 {
     if(sound.get() == nullptr) return;
@@ -199,6 +190,26 @@ void SampleComponent::drawSampleRectangle(Graphics &g, Rectangle<int> areaInt)
     }
 }
 
+bool SampleComponent::hasVelocityCrossfade() const
+{
+	if (sound.get() == nullptr) return false;
+
+	return (int)sound->getProperty(ModulatorSamplerSound::LowerVelocityXFade) != 0 ||
+		   (int)sound->getProperty(ModulatorSamplerSound::UpperVelocityXFade) != 0;
+}
+
+Rectangle<int> SampleComponent::getKeyVelocityArea() const
+{
+	if (sound.get() == nullptr) return Rectangle<int>();
+
+	const int lowKey = sound->getProperty(ModulatorSamplerSound::KeyLow);
+	const int highKey = sound->getProperty(ModulatorSamplerSound::KeyHigh);
+	const int lowVelo = sound->getProperty(ModulatorSamplerSound::VeloLow);
+	const int highVelo = sound->getProperty(ModulatorSamplerSound::VeloHigh);
+
+	return Rectangle<int>(lowKey, lowVelo, 1 + highKey - lowKey, 1 + highVelo - lowVelo);
+}
+
 bool SampleComponent::needsToBeDrawn()
 {
 	const bool enoughSiblings = numOverlayerSiblings > 4;
@@ -214,6 +225,7 @@ SamplerSoundMap::SamplerSoundMap(ModulatorSampler *ownerSampler_):
 	handler(ownerSampler->getSampleEditHandler()),
 	notePosition(-1),
 	veloPosition(-1),
+	fullRedrawNeeded(true),
 	selectedSounds(new SelectedItemSet<WeakReference<SampleComponent>>()),
 	sampleLasso(new LassoComponent<WeakReference<SampleComponent>>())
 {
@@ -245,7 +257,11 @@ void SamplerSoundMap::changeListenerCallback(ChangeBroadcaster *b)
 
 		for(int i = 0; i < sampleComponents.size(); i++)
 		{
-			sampleComponents[i]->setSelected(false);
+			if (sampleComponents[i]->isSelected())
+			{
+				sampleComponents[i]->setSelected(false);
+				invalidateArea(sampleComponents[i]->getBoundsInParent());
+			}
 		}
 
 		Array<WeakReference<SampleComponent>> selectedSampleComponents = selectedSounds->getItemArray();
@@ -255,6 +271,7 @@ void SamplerSoundMap::changeListenerCallback(ChangeBroadcaster *b)
 			if (selectedSampleComponents[i].get() != nullptr)
 			{
 				selectedSampleComponents[i]->setSelected(true);
+				invalidateArea(selectedSampleComponents[i]->getBoundsInParent());
 
 				if (selectedSampleComponents[i]->getSound() != nullptr)
 				{
@@ -262,8 +279,6 @@ void SamplerSoundMap::changeListenerCallback(ChangeBroadcaster *b)
 				}
 			}
 		}
-
-        refreshGraphics();
 	}
 	else if (dynamic_cast<ModulatorSamplerSound*>(b) != nullptr)
 	{
@@ -409,9 +424,12 @@ void SamplerSoundMap::refreshSelectedSoundsFromLasso()
 {
 	lassoSelectedComponents.clear();
 
-	for (int i = 0; i < sampleComponents.size(); i++)
+	Array<int> candidates;
+	sampleGrid.getIndexesInArea(getKeyVelocityAreaForPixels(currentLassoRectangle), candidates);
+
+	for (int i = 0; i < candidates.size(); i++)
 	{
-		SampleComponent *c = sampleComponents[i];
+		SampleComponent *c = sampleComponents[candidates[i]];
 
 		Rectangle<int> sampleBounds = c->getBoundsInParent();
 
@@ -422,7 +440,77 @@ void SamplerSoundMap::refreshSelectedSoundsFromLasso()
 	}
 }
 
+void SamplerSoundMap::timerCallback()
+{
+	for (int i = animatedComponents.size() - 1; i >= 0; i--)
+	{
+		SampleComponent *c = animatedComponents[i].get();
+
+		if (c == nullptr)
+		{
+			animatedComponents.remove(i);
+			continue;
+		}
+
+		if (!c->decayNoteOnAnimation())
+		{
+			animatedComponents.remove(i);
+		}
+
+		invalidateArea(c->getBoundsInParent());
+	}
+
+	updateSnapshot();
+
+	if (animatedComponents.size() == 0)
+	{
+		stopTimer();
+	}
+}
+
+void SamplerSoundMap::updateSnapshot()
+{
+	if (getWidth() <= 0 || getHeight() <= 0) return;
+
+	if (currentSnapshot.getWidth() != getWidth() || currentSnapshot.getHeight() != getHeight())
+	{
+		fullRedrawNeeded = true;
+	}
+
+	if (fullRedrawNeeded)
+	{
+		currentSnapshot = Image(Image::RGB, getWidth(), getHeight(), true);
+
+		Graphics g2(currentSnapshot);
+
+		drawSoundMap(g2);
+
+		repaint();
+	}
+	else if (!dirtyArea.isEmpty())
+	{
+		// Pad the area so that the outlines of neighbouring sounds are restored too
+		const Rectangle<int> area = dirtyArea.expanded(1).getIntersection(getLocalBounds());
+
+		Graphics g2(currentSnapshot);
+
+		g2.reduceClipRegion(area);
+
+		drawSoundMap(g2, area);
+
+		repaint(area);
+	}
+
+	fullRedrawNeeded = false;
+	dirtyArea = Rectangle<int>();
+}
+
 void SamplerSoundMap::drawSoundMap(Graphics &g)
+{
+	drawSoundMap(g, getLocalBounds());
+}
+
+void SamplerSoundMap::drawSoundMap(Graphics &g, Rectangle<int> area)
 {
     g.fillAll(Colour(0xFF333333));
     
@@ -478,14 +566,52 @@ void SamplerSoundMap::drawSoundMap(Graphics &g)
         //g.drawLine(i * noteWidth, 0, i * noteWidth, (float)getHeight(), 1.0f);
     }
     
-    for(int i = 0; i < sampleComponents.size(); i++)
-    {
-        SampleComponent *c = sampleComponents[i];
-		
-		if (!c->isVisible()) continue;
+	Array<int> indexes;
 
-		c->drawSampleRectangle(g, c->getBoundsInParent());
-    }
+	if (area.contains(getLocalBounds()))
+	{
+		indexes.ensureStorageAllocated(sampleComponents.size());
+
+		for (int i = 0; i < sampleComponents.size(); i++)
+			indexes.add(i);
+	}
+	else
+	{
+		sampleGrid.getIndexesInArea(getKeyVelocityAreaForPixels(area), indexes);
+	}
+
+	ScopedLock sl(ownerSampler->getExportLock());
+
+	RectangleBatch fills;
+	RectangleBatch outlines;
+
+	for (int i = 0; i < indexes.size(); i++)
+	{
+		SampleComponent *c = sampleComponents[indexes[i]];
+
+		if (!c->isVisible() || c->getSound() == nullptr) continue;
+
+		const Rectangle<int> bounds = c->getBoundsInParent();
+
+		if (!bounds.intersects(area)) continue;
+
+		if (c->hasVelocityCrossfade())
+		{
+			// Keep the drawing order for the few sounds that need a path
+			fills.flush(g);
+			outlines.flush(g);
+
+			c->drawSampleRectangle(g, bounds);
+		}
+		else
+		{
+			fills.add(c->getColourForSound(false), bounds);
+			outlines.addOutline(c->getColourForSound(true), bounds);
+		}
+	}
+
+	fills.flush(g);
+	outlines.flush(g);
 }
 
 void SamplerSoundMap::paint(Graphics &g)
@@ -596,7 +722,8 @@ void SamplerSoundMap::updateSampleComponentWithSound(ModulatorSamplerSound *soun
 
 void SamplerSoundMap::updateSampleComponent(int index)
 {
-	const ModulatorSamplerSound *s = sampleComponents[index]->getSound();
+	SampleComponent *c = sampleComponents[index];
+	const ModulatorSamplerSound *s = c->getSound();
 
 	if(s != nullptr)
 	{
@@ -611,9 +738,17 @@ void SamplerSoundMap::updateSampleComponent(int index)
 		const int y = getHeight() - (int)s->getProperty(ModulatorSamplerSound::VeloHigh) * velocityHeight - velocityHeight;
 		const int y_max = getHeight() - (int)s->getProperty(ModulatorSamplerSound::VeloLow) * velocityHeight;
 
-		sampleComponents[index]->setSampleBounds((int)x, (int)y, (int)(x_max - x), (int)(y_max-y));
-		
-        refreshGraphics();
+		sampleGrid.setArea(index, c->getKeyVelocityArea());
+
+		const Rectangle<int> oldBounds = c->getBoundsInParent();
+
+		c->setSampleBounds((int)x, (int)y, (int)(x_max - x), (int)(y_max-y));
+
+		if (oldBounds != c->getBoundsInParent())
+		{
+			invalidateArea(oldBounds);
+			invalidateArea(c->getBoundsInParent());
+		}
 	}
 }
 
@@ -632,6 +767,7 @@ void SamplerSoundMap::updateSoundData()
 	if(newSamplesDetected())
 	{
 		sampleComponents.clear();
+		sampleGrid.clear();
 
 		for(int i = 0; i < ownerSampler->getNumSounds(); i++)
 		{
@@ -640,10 +776,8 @@ void SamplerSoundMap::updateSoundData()
 			sampleComponents.add(c);
 		}
 	}
-	else
-	{
-		refreshGraphics();
-	}
+
+	refreshGraphics();
 
 	updateSampleComponents();
 }
@@ -674,7 +808,7 @@ void SamplerSoundMap::mouseDown(const MouseEvent &e)
 		sampleLasso->beginLasso(e.getEventRelativeTo(this), this);
 	}
     
-    refreshGraphics();
+    repaint();
 }
 
 void SamplerSoundMap::mouseUp(const MouseEvent &e)
@@ -719,7 +853,7 @@ void SamplerSoundMap::mouseUp(const MouseEvent &e)
 		milliSecondsSinceLastLassoCheck = 0;
 	}
 
-    refreshGraphics();
+    repaint();
 }
 
 void SamplerSoundMap::mouseExit(const MouseEvent &)
@@ -831,7 +965,7 @@ void SamplerSoundMap::mouseDrag(const MouseEvent &e)
 		sampleLasso->dragLasso(e);
 	}
     
-    refreshGraphics();
+    repaint();
 }
 
 void SamplerSoundMap::setPressedKeys(const uint8 *pressedKeyData)
@@ -845,13 +979,21 @@ void SamplerSoundMap::setPressedKeys(const uint8 *pressedKeyData)
 
 		if(newNote)
 		{
-			for(int j = 0; j < sampleComponents.size(); j++)
+			Array<int> candidates;
+			sampleGrid.getIndexesInArea(Rectangle<int>(number, velocity, 1, 1), candidates);
+
+			for(int j = 0; j < candidates.size(); j++)
 			{
-				if(sampleComponents[j]->isVisible() && sampleComponents[j]->getSound() != nullptr &&
-					sampleComponents[j]->getSound()->appliesToMessage(1, number, velocity) &&
-					sampleComponents[j]->getSound()->appliesToRRGroup(ownerSampler->getSamplerDisplayValues().currentGroup))
+				SampleComponent *c = sampleComponents[candidates[j]];
+
+				if(c->isVisible() && c->getSound() != nullptr &&
+					c->getSound()->appliesToMessage(1, number, velocity) &&
+					c->getSound()->appliesToRRGroup(ownerSampler->getSamplerDisplayValues().currentGroup))
 				{
-					sampleComponents[j]->triggerNoteOnAnimation(velocity);
+					c->triggerNoteOnAnimation(velocity);
+
+					animatedComponents.addIfNotAlreadyThere(c);
+					invalidateArea(c->getBoundsInParent());
 				}
 			}
 		}
@@ -860,20 +1002,50 @@ void SamplerSoundMap::setPressedKeys(const uint8 *pressedKeyData)
 
 	}
 
+	if (animatedComponents.size() != 0 && !isTimerRunning())
+	{
+		startTimer(30);
+	}
+
 	repaint();
 }
 	
 
 SampleComponent* SamplerSoundMap::getSampleComponentAt(Point<int> point)
 {
-	for(int i = 0; i < sampleComponents.size(); i++)
+	Array<int> candidates;
+	sampleGrid.getIndexesInArea(getKeyVelocityAreaForPixels(Rectangle<int>(point.getX(), point.getY(), 1, 1)), candidates);
+
+	for(int i = 0; i < candidates.size(); i++)
 	{
-		if (sampleComponents[i]->isVisible() && sampleComponents[i]->samplePathContains(point)) return sampleComponents[i];
+		SampleComponent *c = sampleComponents[candidates[i]];
+
+		if (c->isVisible() && c->samplePathContains(point)) return c;
 	}
 
 	return nullptr;
 };
 
+Rectangle<int> SamplerSoundMap::getKeyVelocityAreaForPixels(Rectangle<int> pixelArea) const
+{
+	const float noteWidth = (float)getWidth() / 128.0f;
+	const int velocityHeight = getHeight() / 128;
+
+	if (noteWidth <= 0.0f || velocityHeight == 0)
+	{
+		return Rectangle<int>(0, 0, 128, 128);
+	}
+
+	// The sample bounds are truncated to whole pixels, so add one key / velocity step on each side
+	const int lowKey = (int)((float)pixelArea.getX() / noteWidth) - 1;
+	const int highKey = (int)((float)pixelArea.getRight() / noteWidth) + 1;
+
+	const int lowVelo = (getHeight() - pixelArea.getBottom()) / velocityHeight - 2;
+	const int highVelo = (getHeight() - pixelArea.getY()) / velocityHeight + 1;
+
+	return Rectangle<int>::leftTopRightBottom(lowKey, lowVelo, highKey + 1, highVelo + 1);
+}
+
 void SamplerSoundMap::checkEventForSampleDragging(const MouseEvent &e)
 {
 	sampleDraggingEnabled = e.mods.isAltDown() && e.mods.isLeftButtonDown() && selectedSounds->getNumSelected() != 0;
@@ -908,9 +1080,13 @@ void SamplerSoundMap::setSelectedIds(const Array<ModulatorSamplerSound*> newSele
 {
 	selectedSounds->deselectAll();
 
+	Array<ModulatorSamplerSound*> sortedSelection(newSelectionList);
+	DefaultElementComparator<ModulatorSamplerSound*> comparator;
+	sortedSelection.sort(comparator);
+
 	for(int i = 0; i < sampleComponents.size(); i++)
 	{
-		if(newSelectionList.contains(sampleComponents[i]->getSound()))
+		if(sortedSelection.indexOfSorted(comparator, sampleComponents[i]->getSound()) != -1)
 		{
 			selectedSounds->addToSelection(sampleComponents[i]);
 		}
@@ -936,6 +1112,134 @@ void SamplerSoundMap::soloGroup(int groupIndex)
 }
 
 
+void SamplerSoundMap::SampleGrid::clear()
+{
+	for (int i = 0; i < NumCells * NumCells; i++)
+	{
+		cells[i].clearQuick();
+	}
+
+	cellAreas.clearQuick();
+}
+
+void SamplerSoundMap::SampleGrid::setArea(int index, Rectangle<int> keyVelocityArea)
+{
+	const Rectangle<int> newCellArea = getCellArea(keyVelocityArea);
+	const Rectangle<int> oldCellArea = cellAreas[index];
+
+	if (newCellArea == oldCellArea) return;
+
+	DefaultElementComparator<int> comparator;
+
+	for (int x = oldCellArea.getX(); x < oldCellArea.getRight(); x++)
+	{
+		for (int y = oldCellArea.getY(); y < oldCellArea.getBottom(); y++)
+		{
+			Array<int> &cell = cells[x * NumCells + y];
+			cell.remove(cell.indexOfSorted(comparator, index));
+		}
+	}
+
+	for (int x = newCellArea.getX(); x < newCellArea.getRight(); x++)
+	{
+		for (int y = newCellArea.getY(); y < newCellArea.getBottom(); y++)
+		{
+			cells[x * NumCells + y].addUsingDefaultSort(index);
+		}
+	}
+
+	while (cellAreas.size() <= index)
+	{
+		cellAreas.add(Rectangle<int>());
+	}
+
+	cellAreas.set(index, newCellArea);
+}
+
+void SamplerSoundMap::SampleGrid::getIndexesInArea(Rectangle<int> keyVelocityArea, Array<int> &indexes) const
+{
+	const Rectangle<int> cellArea = getCellArea(keyVelocityArea);
+
+	if (cellArea.isEmpty()) return;
+
+	const int numBefore = indexes.size();
+
+	for (int x = cellArea.getX(); x < cellArea.getRight(); x++)
+	{
+		for (int y = cellArea.getY(); y < cellArea.getBottom(); y++)
+		{
+			indexes.addArray(cells[x * NumCells + y]);
+		}
+	}
+
+	// Sounds that span multiple cells are found more than once
+	if (cellArea.getWidth() * cellArea.getHeight() > 1 && indexes.size() > numBefore)
+	{
+		indexes.sort();
+
+		int numUnique = 1;
+
+		for (int i = 1; i < indexes.size(); i++)
+		{
+			if (indexes.getUnchecked(i) != indexes.getUnchecked(numUnique - 1))
+			{
+				indexes.setUnchecked(numUnique++, indexes.getUnchecked(i));
+			}
+		}
+
+		indexes.removeRange(numUnique, indexes.size() - numUnique);
+	}
+}
+
+Rectangle<int> SamplerSoundMap::SampleGrid::getCellArea(Rectangle<int> keyVelocityArea)
+{
+	const Rectangle<int> clipped = keyVelocityArea.getIntersection(Rectangle<int>(0, 0, 128, 128));
+
+	if (clipped.isEmpty()) return Rectangle<int>();
+
+	return Rectangle<int>::leftTopRightBottom(clipped.getX() / CellSize,
+											  clipped.getY() / CellSize,
+											  (clipped.getRight() - 1) / CellSize + 1,
+											  (clipped.getBottom() - 1) / CellSize + 1);
+}
+
+void SamplerSoundMap::RectangleBatch::add(Colour c, Rectangle<int> r)
+{
+	for (int i = 0; i < entries.size(); i++)
+	{
+		if (entries[i]->colour == c)
+		{
+			entries[i]->rectangles.addWithoutMerging(r);
+			return;
+		}
+	}
+
+	Entry *e = new Entry();
+	e->colour = c;
+	e->rectangles.addWithoutMerging(r);
+
+	entries.add(e);
+}
+
+void SamplerSoundMap::RectangleBatch::addOutline(Colour c, Rectangle<int> r)
+{
+	add(c, r.withHeight(1));
+	add(c, r.withTop(r.getBottom() - 1));
+	add(c, r.withWidth(1));
+	add(c, r.withLeft(r.getRight() - 1));
+}
+
+void SamplerSoundMap::RectangleBatch::flush(Graphics &g)
+{
+	for (int i = 0; i < entries.size(); i++)
+	{
+		g.setColour(entries[i]->colour);
+		g.fillRectList(entries[i]->rectangles);
+	}
+
+	entries.clear();
+}
+
 bool SamplerSoundMap::newSamplesDetected()
 {
 	if(ownerSampler->getNumSounds() != sampleComponents.size()) return true;
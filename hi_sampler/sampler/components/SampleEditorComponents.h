@@ -190,10 +190,11 @@ private:
 
 
 /** A simple rectangle which represents a ModulatorSamplerSound within a SamplerSoundMap.
+*
+*	This is not a Component: the SamplerSoundMap draws all rectangles itself and drives the note on animation from its own timer.
 *	@ingroup components
 */
-class SampleComponent: public Timer,
-					   public SafeChangeListener
+class SampleComponent: public SafeChangeListener
 {
 public:
 
@@ -206,14 +207,18 @@ public:
 		masterReference.clear();
 	};
 
-	void timerCallback();
-
 	void changeListenerCallback(SafeChangeBroadcaster *b);
 
 	void triggerNoteOnAnimation(int velocity)
 	{
 		transparency = 0.3f + 0.7f * sound->getGainValueForVelocityXFade(velocity);
-		startTimer(30);
+	}
+
+	/** Fades out the note on highlight. Returns false when the animation is finished. */
+	bool decayNoteOnAnimation()
+	{
+		transparency = jmax<float>(0.3f, transparency * 0.9f);
+		return transparency > 0.3f;
 	}
 
 	Colour getColourForSound(bool wantsOutlineColour) const
@@ -243,6 +248,12 @@ public:
 
     void drawSampleRectangle(Graphics &g, Rectangle<int> area);
 
+	/** Returns true if the sound has a velocity crossfade and can't be drawn as plain rectangle. */
+	bool hasVelocityCrossfade() const;
+
+	/** Returns the area of the sound in the key / velocity plane (x = key, y = velocity). */
+	Rectangle<int> getKeyVelocityArea() const;
+
 	const ModulatorSamplerSound *getSound() const noexcept { return sound; };
 
 	ModulatorSamplerSound *getSound() noexcept { return sound.get(); };
@@ -336,21 +347,7 @@ public:
 		sampleComponents.clear();
 	};
 
-	void timerCallback() override
-	{
-		if (getWidth() > 0 && getHeight() > 0)
-		{
-			currentSnapshot = Image(Image::RGB, getWidth(), getHeight(), true);
-
-			Graphics g2(currentSnapshot);
-
-			drawSoundMap(g2);
-
-			repaint();
-		}
-
-        stopTimer();
-	}
+	void timerCallback() override;
 
 	void modifierKeysChanged(const ModifierKeys &modifiers) override;
 
@@ -418,12 +415,24 @@ public:
 		repaint();
 	};
 
+	/** Redraws the whole sound map snapshot. */
     void refreshGraphics()
     {
+		fullRedrawNeeded = true;
         if(!isTimerRunning()) startTimer(50);
     }
+
+	/** Redraws only the given area of the sound map snapshot. */
+	void invalidateArea(Rectangle<int> area)
+	{
+		dirtyArea = dirtyArea.getUnion(area);
+		if (!isTimerRunning()) startTimer(50);
+	}
     
     void drawSoundMap(Graphics &g);
+
+	/** Draws the part of the sound map within the given area. Only the sounds that overlap the area are drawn. */
+	void drawSoundMap(Graphics &g, Rectangle<int> area);
     
 	const ModulatorSampler* getSampler() const { return ownerSampler; }
 
@@ -440,9 +449,69 @@ private:
 		int hiVel;
 	};
 
+	/** A coarse grid over the key / velocity plane that indexes the sample components.
+	*
+	*	Each cell covers 8 keys x 8 velocity steps and stores the sorted indexes of all components that overlap it,
+	*	so hit-testing, lasso selection and partial redraws only look at the sounds near the area instead of the whole map.
+	*/
+	class SampleGrid
+	{
+	public:
+
+		enum
+		{
+			CellSize = 8,
+			NumCells = 128 / CellSize
+		};
+
+		void clear();
+
+		/** Sets the key / velocity area of the component with the given index. Pass an empty area to remove it. */
+		void setArea(int index, Rectangle<int> keyVelocityArea);
+
+		/** Adds the (ascending, unique) indexes of all components whose cells overlap the key / velocity area. */
+		void getIndexesInArea(Rectangle<int> keyVelocityArea, Array<int> &indexes) const;
+
+	private:
+
+		static Rectangle<int> getCellArea(Rectangle<int> keyVelocityArea);
+
+		Array<int> cells[NumCells * NumCells];
+		Array<Rectangle<int>> cellAreas;
+	};
+
+	/** Collects the sample rectangles of a redraw and fills them with one colour change per distinct colour. */
+	class RectangleBatch
+	{
+	public:
+
+		void add(Colour c, Rectangle<int> r);
+
+		/** Adds the one pixel outline of the rectangle. */
+		void addOutline(Colour c, Rectangle<int> r);
+
+		void flush(Graphics &g);
+
+	private:
+
+		struct Entry
+		{
+			Colour colour;
+			RectangleList<int> rectangles;
+		};
+
+		OwnedArray<Entry> entries;
+	};
+
 	/** checks if the sampler contains new samples that are not displayed yet. */
 	bool newSamplesDetected();
 
+	/** Converts a pixel area to the (slightly larger) key / velocity area that is used to query the grid. */
+	Rectangle<int> getKeyVelocityAreaForPixels(Rectangle<int> pixelArea) const;
+
+	/** Renders the invalidated parts of the snapshot. */
+	void updateSnapshot();
+
 	SampleComponent* getSampleComponentAt(Point<int> point);
 
 	void checkEventForSampleDragging(const MouseEvent &e);
@@ -469,6 +538,9 @@ private:
 	Array<int> selectedIds;
 	OwnedArray<SampleComponent> sampleComponents;
 
+	SampleGrid sampleGrid;
+	Array<WeakReference<SampleComponent>> animatedComponents;
+
 	Array<WeakReference<SampleComponent>> lassoSelectedComponents;
 
 	ScopedPointer<SelectedItemSet<WeakReference<SampleComponent>>> selectedSounds;
@@ -479,6 +551,8 @@ private:
 	uint32 milliSecondsSinceLastLassoCheck;
     
     Image currentSnapshot;
+	Rectangle<int> dirtyArea;
+	bool fullRedrawNeeded;
 };
 
 /** A wrapper class around a SamplerSoundMap which adds a keyboard that can be clicked to trigger the note. 
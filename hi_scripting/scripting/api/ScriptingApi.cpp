@@ -1660,16 +1660,18 @@ var ScriptingApi::Sampler::getSampleMapList() const
 
 	Array<File> childFiles;
 
-	rootDir.findChildFiles(childFiles, File::findFiles, true, "*.xml");
+	rootDir.findChildFiles(childFiles, File::findFiles, true, "*.xml;*" + SampleMap::getBinaryFileExtension());
 
 
 	for (int i = 0; i < childFiles.size(); i++)
 	{
-		auto n = childFiles[i].getRelativePathFrom(rootDir).upToFirstOccurrenceOf(".xml", false, true);
+		auto n = childFiles[i].getRelativePathFrom(rootDir).upToLastOccurrenceOf(childFiles[i].getFileExtension(), false, true);
 
 		n = n.replace(File::separatorString, "/");
 
-		sampleMapNames.add(n);
+		// A sample map might be stored as XML and binary file
+		if (!sampleMapNames.contains(var(n)))
+			sampleMapNames.add(n);
 
 		//sampleMapNames.add(childFiles[i].getFileNameWithoutExtension());
 	}
@@ -2197,16 +2199,9 @@ ScriptingObjects::ScriptingModulator *ScriptingApi::Synth::getModulator(const St
 {
 	if(getScriptProcessor()->objectsCanBeCreated())
 	{
-		Processor::Iterator<Modulator> it(owner);
-
-		Modulator *m;
-		
-		while((m = it.getNextProcessor()) != 0)
+		if (Modulator *m = getProcessor()->getMainController()->getProcessorRegistry().getFirstProcessorWithId<Modulator>(name, owner))
 		{
-			if(m->getId() == name)
-			{
-				return new ScriptingObjects::ScriptingModulator(getScriptProcessor(), m);	
-			}
+			return new ScriptingObjects::ScriptingModulator(getScriptProcessor(), m);
 		}
 
 		reportScriptError(name + " was not found. ");
@@ -2229,16 +2224,9 @@ ScriptingObjects::ScriptingMidiProcessor *ScriptingApi::Synth::getMidiProcessor(
 
 	if(getScriptProcessor()->objectsCanBeCreated())
 	{
-		Processor::Iterator<MidiProcessor> it(owner);
-
-		MidiProcessor *mp;
-		
-		while((mp = it.getNextProcessor()) != nullptr)
+		if (MidiProcessor *mp = getProcessor()->getMainController()->getProcessorRegistry().getFirstProcessorWithId<MidiProcessor>(name, owner))
 		{
-			if(mp->getId() == name)
-			{
-				return new ScriptingObjects::ScriptingMidiProcessor(getScriptProcessor(), mp);	
-			}
+			return new ScriptingObjects::ScriptingMidiProcessor(getScriptProcessor(), mp);
 		}
 
         reportScriptError(name + " was not found. ");
@@ -2259,17 +2247,9 @@ ScriptingObjects::ScriptingSynth *ScriptingApi::Synth::getChildSynth(const Strin
 {
 	if(getScriptProcessor()->objectsCanBeCreated())
 	{
-		Processor::Iterator<ModulatorSynth> it(owner);
-
-		ModulatorSynth *m;
-		
-
-		while((m = it.getNextProcessor()) != 0)
+		if (ModulatorSynth *m = getProcessor()->getMainController()->getProcessorRegistry().getFirstProcessorWithId<ModulatorSynth>(name, owner))
 		{
-			if(m->getId() == name)
-			{
-				return new ScriptingObjects::ScriptingSynth(getScriptProcessor(), m);	
-			}
+			return new ScriptingObjects::ScriptingSynth(getScriptProcessor(), m);
 		}
         
         reportScriptError(name + " was not found. ");
@@ -2334,17 +2314,9 @@ ScriptingObjects::ScriptingEffect *ScriptingApi::Synth::getEffect(const String &
 {
 	if(getScriptProcessor()->objectsCanBeCreated())
 	{
-		Processor::Iterator<EffectProcessor> it(owner);
-
-		EffectProcessor *fx;
-		
-
-		while((fx = it.getNextProcessor()) != nullptr)
+		if (EffectProcessor *fx = getProcessor()->getMainController()->getProcessorRegistry().getFirstProcessorWithId<EffectProcessor>(name, owner))
 		{
-			if(fx->getId() == name)
-			{
-				return new ScriptEffect(getScriptProcessor(), fx);	
-			}
+			return new ScriptEffect(getScriptProcessor(), fx);
 		}
 
         reportScriptError(name + " was not found. ");
@@ -2359,18 +2331,10 @@ ScriptingObjects::ScriptingEffect *ScriptingApi::Synth::getEffect(const String &
 
 ScriptingObjects::ScriptingAudioSampleProcessor * ScriptingApi::Synth::getAudioSampleProcessor(const String &name)
 {
-	Processor::Iterator<AudioSampleProcessor> it(owner);
-
-		AudioSampleProcessor *asp;
-
-
-		while ((asp = it.getNextProcessor()) != nullptr)
-		{
-			if (dynamic_cast<Processor*>(asp)->getId() == name)
-			{
-				return new ScriptAudioSampleProcessor(getScriptProcessor(), asp);
-			}
-		}
+	if (AudioSampleProcessor *asp = getProcessor()->getMainController()->getProcessorRegistry().getFirstProcessorWithId<AudioSampleProcessor>(name, owner))
+	{
+		return new ScriptAudioSampleProcessor(getScriptProcessor(), asp);
+	}
 
         reportScriptError(name + " was not found. ");
 		RETURN_IF_NO_THROW(new ScriptAudioSampleProcessor(getScriptProcessor(), nullptr))
@@ -2382,15 +2346,9 @@ ScriptingObjects::ScriptingTableProcessor *ScriptingApi::Synth::getTableProcesso
 {
 	if (getScriptProcessor()->objectsCanBeCreated())
 	{
-		Processor::Iterator<LookupTableProcessor> it(owner);
-
-		while (LookupTableProcessor *lut = it.getNextProcessor())
+		if (LookupTableProcessor *lut = getProcessor()->getMainController()->getProcessorRegistry().getFirstProcessorWithId<LookupTableProcessor>(name, owner))
 		{
-			if (dynamic_cast<Processor*>(lut)->getId() == name)
-			{
-				
-				return new ScriptTableProcessor(getScriptProcessor(), lut);
-			}
+			return new ScriptTableProcessor(getScriptProcessor(), lut);
 		}
 
         reportScriptError(name + " was not found. ");
@@ -2407,15 +2365,9 @@ ScriptingApi::Sampler * ScriptingApi::Synth::getSampler(const String &name)
 {
 	if (getScriptProcessor()->objectsCanBeCreated())
 	{
-		Processor::Iterator<ModulatorSampler> it(owner);
-
-		while (ModulatorSampler *s = it.getNextProcessor())
+		if (ModulatorSampler *s = getProcessor()->getMainController()->getProcessorRegistry().getFirstProcessorWithId<ModulatorSampler>(name, owner))
 		{
-			if (s->getId() == name)
-			{
-				
-				return new Sampler(getScriptProcessor(), s);
-			}
+			return new Sampler(getScriptProcessor(), s);
 		}
 
         reportScriptError(name + " was not found. ");
@@ -2432,15 +2384,9 @@ ScriptingApi::Synth::ScriptSlotFX* ScriptingApi::Synth::getSlotFX(const String&
 {
 	if (getScriptProcessor()->objectsCanBeCreated())
 	{
-		Processor::Iterator<SlotFX> it(owner);
-
-		while (SlotFX *s = it.getNextProcessor())
+		if (SlotFX *s = getProcessor()->getMainController()->getProcessorRegistry().getFirstProcessorWithId<SlotFX>(name, owner))
 		{
-			if (s->getId() == name)
-			{
-
-				return new ScriptSlotFX(getScriptProcessor(), s);
-			}
+			return new ScriptSlotFX(getScriptProcessor(), s);
 		}
 
 		reportScriptError(name + " was not found. ");
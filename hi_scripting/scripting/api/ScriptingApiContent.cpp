@@ -1575,24 +1575,14 @@ void ScriptingApi::Content::ScriptTable::connectToOtherTable(const String &other
 	MidiProcessor* mp = dynamic_cast<MidiProcessor*>(getProcessor());
 	if (mp == nullptr) return;
 
-	Processor::Iterator<Processor> it(mp->getOwnerSynth(), false);
-
-	Processor *p;
-
-	while ((p = it.getNextProcessor()) != nullptr)
+	if (LookupTableProcessor* lut = mp->getMainController()->getProcessorRegistry().getFirstProcessorWithId<LookupTableProcessor>(otherTableId, mp->getOwnerSynth()))
 	{
-		if (dynamic_cast<LookupTableProcessor*>(p) != nullptr && p->getId() == otherTableId)
-		{
-			useOtherTable = true;
+		useOtherTable = true;
 
-			
-
-			referencedTable = dynamic_cast<LookupTableProcessor*>(p)->getTable(index);
-			connectedProcessor = p;
-
-			return;
-		}
+		referencedTable = lut->getTable(index);
+		connectedProcessor = dynamic_cast<Processor*>(lut);
 
+		return;
 	}
 
 	useOtherTable = false;
@@ -1737,20 +1727,11 @@ void ScriptingApi::Content::ScriptSliderPack::connectToOtherSliderPack(const Str
 	MidiProcessor* mp = dynamic_cast<MidiProcessor*>(getProcessor());
 	if (mp == nullptr) return;
 
-	Processor::Iterator<Processor> it(mp->getOwnerSynth(), false);
-
-	Processor *p;
-
-	while ((p = it.getNextProcessor()) != nullptr)
+	if (SliderPackProcessor* spp = mp->getMainController()->getProcessorRegistry().getFirstProcessorWithId<SliderPackProcessor>(newPackId, mp->getOwnerSynth()))
 	{
-		if ((dynamic_cast<SliderPackProcessor*>(p) != nullptr) && p->getId() == newPackId)
-		{
-			existingData = dynamic_cast<SliderPackProcessor*>(p)->getSliderPackData(otherPackIndex);
+		existingData = spp->getSliderPackData(otherPackIndex);
 
-			
-
-			return;
-		}
+		return;
 	}
 
 	existingData = nullptr;
@@ -2628,19 +2609,11 @@ void ScriptingApi::Content::ScriptAudioWaveform::connectToAudioSampleProcessor(S
 
 	if (mp == nullptr) return;
 
-	Processor::Iterator<Processor> it(mp->getOwnerSynth(), false);
-
-	Processor *p;
-
-	while ((p = it.getNextProcessor()) != nullptr)
+	if (AudioSampleProcessor* asp = mp->getMainController()->getProcessorRegistry().getFirstProcessorWithId<AudioSampleProcessor>(processorId, mp->getOwnerSynth()))
 	{
-		if (dynamic_cast<AudioSampleProcessor*>(p) != nullptr && p->getId() == processorId)
-		{
-			connectedProcessor = p;
-
-			return;
-		}
+		connectedProcessor = dynamic_cast<Processor*>(asp);
 
+		return;
 	}
 
 	connectedProcessor = nullptr;
@@ -1279,36 +1279,30 @@ public:
 			delayedBufferL = new VariantBuffer(samplesPerBlock);
 			delayedBufferR = new VariantBuffer(samplesPerBlock);
 
-			delayL.prepareToPlay(sampleRate);
-			delayR.prepareToPlay(sampleRate);
+			delayL.prepareToPlay(sampleRate, samplesPerBlock);
+			delayR.prepareToPlay(sampleRate, samplesPerBlock);
 		}
 
 		void processBlock(float **data, int numChannels, int numSamples) override
 		{
 			if (numChannels == 2)
 			{
-				const float *inL = data[0];
-				const float *inR = data[1];
-
 				float *l = delayedBufferL->buffer.getWritePointer(0);
 				float *r = delayedBufferR->buffer.getWritePointer(0);
 
-				while (--numSamples >= 0)
-				{
-					*l++ = delayL.getDelayedValue(*inL++);
-					*r++ = delayL.getDelayedValue(*inR++);
-				}
+				FloatVectorOperations::copy(l, data[0], numSamples);
+				FloatVectorOperations::copy(r, data[1], numSamples);
+
+				delayL.processBlock(l, numSamples);
+				delayR.processBlock(r, numSamples);
 			}
 			else
 			{
-				const float *inL = data[0];
-
 				float *l = delayedBufferL->buffer.getWritePointer(0);
 
-				while (--numSamples >= 0)
-				{
-					*l++ = delayL.getDelayedValue(*inL++);
-				}
+				FloatVectorOperations::copy(l, data[0], numSamples);
+
+				delayL.processBlock(l, numSamples);
 			}
 			
 		}
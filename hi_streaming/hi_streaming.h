@@ -78,6 +78,33 @@ Set this to true if you add this module to your existing C++ project and don't e
 #define STANDALONE_STREAMING 1
 #endif
 
+/** Config: HISE_SHARE_POOL_DATA_BETWEEN_INSTANCES
+
+Set this to true if multiple instances of the same plugin should share the preload buffers of monolithic samples, the impulse responses and the images.
+This reduces the memory usage when the plugin is loaded more than once in the same process (eg. multiple instances in a DAW session).
+*/
+#ifndef HISE_SHARE_POOL_DATA_BETWEEN_INSTANCES
+#define HISE_SHARE_POOL_DATA_BETWEEN_INSTANCES 0
+#endif
+
+/** Config: HISE_COMPRESS_PRELOAD_BUFFERS
+
+Set this to true in order to keep the preload buffers of monolithic samples HLAC compressed in memory. Only the first samples (HISE_DECODED_PRELOAD_SIZE)
+are kept decoded so that the voice can start immediately, the rest of the preload area is decoded by the background thread when the streaming buffers are filled.
+This takes precedence over sharing the preload buffers between instances.
+*/
+#ifndef HISE_COMPRESS_PRELOAD_BUFFERS
+#define HISE_COMPRESS_PRELOAD_BUFFERS 0
+#endif
+
+/** Config: HISE_DECODED_PRELOAD_SIZE
+
+The amount of samples that are kept decoded at the start of a compressed preload buffer (the sample start modulation range is added to this value).
+*/
+#ifndef HISE_DECODED_PRELOAD_SIZE
+#define HISE_DECODED_PRELOAD_SIZE 4096
+#endif
+
 namespace hise
 {
 using namespace juce;
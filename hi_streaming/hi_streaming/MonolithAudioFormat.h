@@ -300,6 +300,12 @@ public:
 	{
 		return multiChannelSampleInformation[channelIndex][sampleIndex].fileName;
 	}
+
+	/** Returns the monolith file that contains the samples for the given channel. */
+	File getMonolithFile(int channelIndex) const
+	{
+		return isPositiveAndBelow(channelIndex, (int)monolithicFiles.size()) ? monolithicFiles[channelIndex] : File();
+	}
     
     int64 getMonolithOffset(int sampleIndex) const
     {
@@ -390,6 +396,12 @@ public:
 		return multiChannelSampleInformation[channelIndex][sampleIndex].fileName;
 	}
 
+	/** Returns the monolith file that contains the samples for the given channel. */
+	File getMonolithFile(int channelIndex) const
+	{
+		return isPositiveAndBelow(channelIndex, (int)monolithicFiles.size()) ? monolithicFiles[channelIndex] : File();
+	}
+
 	int64 getMonolithOffset(int sampleIndex) const
 	{
 		return multiChannelSampleInformation[0][sampleIndex].start;
@@ -30,6 +30,50 @@
 *   ===========================================================================
 */
 
+// ==================================================================================================== SharedPreloadBufferCache methods
+
+SharedPreloadBufferCache::Entry::Ptr SharedPreloadBufferCache::getEntry(const String& key, int numChannels, int numSamples)
+{
+	ScopedLock sl(lock);
+
+	for (auto e : entries)
+	{
+		if (e->key == key)
+		{
+			jassert(e->buffer.getNumChannels() == numChannels);
+			jassert(e->buffer.getNumSamples() == numSamples);
+
+			return e;
+		}
+	}
+
+	Entry::Ptr newEntry = new Entry(key, numChannels, numSamples);
+
+	entries.add(newEntry);
+
+	return newEntry;
+}
+
+void SharedPreloadBufferCache::releaseEntry(Entry::Ptr& entryToRelease)
+{
+	ScopedLock sl(lock);
+
+	Entry* e = entryToRelease.get();
+
+	entryToRelease = nullptr;
+
+	// Only the cache holds a reference...
+	if (e != nullptr && e->getReferenceCount() == 1)
+		entries.removeObject(e);
+}
+
+int SharedPreloadBufferCache::getNumEntries() const
+{
+	ScopedLock sl(lock);
+
+	return entries.size();
+}
+
 // ==================================================================================================== StreamingSamplerSound methods
 
 StreamingSamplerSound::StreamingSamplerSound(const String &fileNameToLoad, StreamingSamplerSoundPool *pool) :
@@ -85,6 +129,7 @@ StreamingSamplerSound::StreamingSamplerSound(MonolithInfoToUse *info, int channe
 StreamingSamplerSound::~StreamingSamplerSound()
 {
 	masterReference.clear();
+	releaseSharedPreloadBuffer();
 	fileReader.closeFileHandles();
 }
 
@@ -95,6 +140,8 @@ void StreamingSamplerSound::setReversed(bool shouldBeReversed)
 		if (shouldBeReversed)
 		{
 			loadEntireSample();
+			detachSharedPreloadBuffer();
+			decompressPreloadBuffer();
 			preloadBuffer.reverse(0, preloadBuffer.getNumSamples());
 			reversed = true;
 		}
@@ -139,6 +186,8 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 		preloadSize = 0;
 
 		preloadBuffer = hlac::HiseSampleBuffer(!fileReader.isMonolithic(), fileReader.isStereo() ? 2 : 1, 0);
+		releaseSharedPreloadBuffer();
+		compressPreloadBuffer();
 
 		return;
 	}
@@ -160,7 +209,27 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 
 	fileReader.openFileHandles();
 
+	if (sampleRate <= 0.0)
+	{
+		if (AudioFormatReader *reader = fileReader.getReader())
+		{
+			sampleRate = reader->sampleRate;
+			sampleEnd = jmin<int>(sampleEnd, (int)reader->lengthInSamples);
+			sampleLength = sampleEnd - sampleStart;
+			loopEnd = jmin(loopEnd, sampleEnd);
+		}
+	}
+
+#if HISE_SHARE_POOL_DATA_BETWEEN_INSTANCES && !HISE_COMPRESS_PRELOAD_BUFFERS
+	if (fileReader.isMonolithic())
+	{
+		loadSharedPreloadBuffer();
+		return;
+	}
+#endif
+
 	preloadBuffer = hlac::HiseSampleBuffer(!fileReader.isMonolithic(), fileReader.isStereo() ? 2 : 1, 0);
+	releaseSharedPreloadBuffer();
 
 	try
 	{
@@ -178,25 +247,20 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 		return;
 	}
 
-	preloadBuffer.clear();
+	fillPreloadBuffer(preloadBuffer);
+	compressPreloadBuffer();
+}
 
-	if (sampleRate <= 0.0)
-	{
-		if (AudioFormatReader *reader = fileReader.getReader())
-		{
-			sampleRate = reader->sampleRate;
-			sampleEnd = jmin<int>(sampleEnd, (int)reader->lengthInSamples);
-			sampleLength = sampleEnd - sampleStart;
-			loopEnd = jmin(loopEnd, sampleEnd);
-		}
-	}
+void StreamingSamplerSound::fillPreloadBuffer(hlac::HiseSampleBuffer& bufferToFill)
+{
+	bufferToFill.clear();
 
 	if (loopEnabled && (loopEnd - loopStart > 0) && sampleLength < internalPreloadSize)
 	{
 		int samplesToFill = internalPreloadSize;
 		int offsetInPreloadBuffer = 0;
 
-		fileReader.readFromDisk(preloadBuffer, 0, sampleLength, sampleStart + monolithOffset, true);
+		fileReader.readFromDisk(bufferToFill, 0, sampleLength, sampleStart + monolithOffset, true);
 
 		const int samplesPerFillOp = (loopEnd - loopStart);
 
@@ -209,7 +273,7 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 			{
 				const int samplesThisTime = jmin<int>(samplesToFill, samplesPerFillOp);
 
-				fileReader.readFromDisk(preloadBuffer, offsetInPreloadBuffer, samplesThisTime, loopStart, true);
+				fileReader.readFromDisk(bufferToFill, offsetInPreloadBuffer, samplesThisTime, loopStart, true);
 
 				offsetInPreloadBuffer += samplesThisTime;
 				samplesToFill -= samplesThisTime;
@@ -226,8 +290,123 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 	{
 		auto samplesToRead = jmin<int>(sampleLength, internalPreloadSize);
 
-		fileReader.readFromDisk(preloadBuffer, 0, samplesToRead, sampleStart + monolithOffset, true);
+		fileReader.readFromDisk(bufferToFill, 0, samplesToRead, sampleStart + monolithOffset, true);
+	}
+}
+
+void StreamingSamplerSound::loadSharedPreloadBuffer()
+{
+#if HISE_SHARE_POOL_DATA_BETWEEN_INSTANCES
+	jassert(fileReader.isMonolithic());
+
+	const int numChannels = fileReader.isStereo() ? 2 : 1;
+
+	String key;
+
+	key << fileReader.getMonolithIdentifier() << ":" << sampleStart << ":" << sampleLength << ":" << internalPreloadSize;
+
+	if (loopEnabled)
+		key << ":" << loopStart << ":" << loopEnd;
+
+	SharedPreloadBufferCache::Entry::Ptr newEntry;
+
+	try
+	{
+		newEntry = sharedPreloadCache->getEntry(key, numChannels, internalPreloadSize);
+	}
+	catch (std::exception e)
+	{
+		preloadBuffer = hlac::HiseSampleBuffer(false, numChannels, 0);
+		releaseSharedPreloadBuffer();
+
+		throw StreamingSamplerSound::LoadingError(getFileName(), "Preload error (max memory exceeded).");
 	}
+
+	{
+		ScopedLock sl(newEntry->loadLock);
+
+		if (!newEntry->loaded)
+		{
+			fillPreloadBuffer(newEntry->buffer);
+			newEntry->loaded = true;
+		}
+	}
+
+	int16* data[2] = { static_cast<int16*>(newEntry->buffer.getWritePointer(0, 0)),
+					   numChannels > 1 ? static_cast<int16*>(newEntry->buffer.getWritePointer(1, 0)) : nullptr };
+
+	// Point to the new data before releasing the old entry...
+	preloadBuffer = hlac::HiseSampleBuffer(data, numChannels, internalPreloadSize);
+
+	releaseSharedPreloadBuffer();
+	sharedPreloadBuffer = newEntry;
+#endif
+}
+
+void StreamingSamplerSound::detachSharedPreloadBuffer()
+{
+#if HISE_SHARE_POOL_DATA_BETWEEN_INSTANCES
+	if (sharedPreloadBuffer == nullptr)
+		return;
+
+	hlac::HiseSampleBuffer ownBuffer(preloadBuffer.isFloatingPoint(), preloadBuffer.getNumChannels(), preloadBuffer.getNumSamples());
+	hlac::HiseSampleBuffer::copy(ownBuffer, preloadBuffer, 0, 0, preloadBuffer.getNumSamples());
+
+	preloadBuffer = std::move(ownBuffer);
+
+	releaseSharedPreloadBuffer();
+#endif
+}
+
+void StreamingSamplerSound::releaseSharedPreloadBuffer()
+{
+#if HISE_SHARE_POOL_DATA_BETWEEN_INSTANCES
+	if (sharedPreloadBuffer != nullptr)
+		sharedPreloadCache->releaseEntry(sharedPreloadBuffer);
+#endif
+}
+
+void StreamingSamplerSound::compressPreloadBuffer()
+{
+#if HISE_COMPRESS_PRELOAD_BUFFERS
+	compressedPreloadBuffer.clear();
+
+	// HLAC only stores 16bit data, so float buffers stay decoded
+	if (preloadBuffer.isFloatingPoint())
+		return;
+
+	const int numDecoded = jmin(preloadBuffer.getNumSamples(), sampleStartMod + HISE_DECODED_PRELOAD_SIZE);
+	const int numToCompress = preloadBuffer.getNumSamples() - numDecoded;
+
+	// Not worth the overhead...
+	if (numToCompress < COMPRESSION_BLOCK_SIZE)
+		return;
+
+	compressedPreloadBuffer.compress(preloadBuffer, numDecoded, numToCompress);
+
+	hlac::HiseSampleBuffer decodedStart(false, preloadBuffer.getNumChannels(), numDecoded);
+	hlac::HiseSampleBuffer::copy(decodedStart, preloadBuffer, 0, 0, numDecoded);
+
+	preloadBuffer = std::move(decodedStart);
+#endif
+}
+
+void StreamingSamplerSound::decompressPreloadBuffer()
+{
+#if HISE_COMPRESS_PRELOAD_BUFFERS
+	if (compressedPreloadBuffer.getNumSamples() == 0)
+		return;
+
+	const int numDecoded = preloadBuffer.getNumSamples();
+
+	hlac::HiseSampleBuffer fullBuffer(false, preloadBuffer.getNumChannels(), numDecoded + compressedPreloadBuffer.getNumSamples());
+	hlac::HiseSampleBuffer::copy(fullBuffer, preloadBuffer, 0, 0, numDecoded);
+
+	compressedPreloadBuffer.decodeAll(fullBuffer, numDecoded);
+	compressedPreloadBuffer.clear();
+
+	preloadBuffer = std::move(fullBuffer);
+#endif
 }
 
 
@@ -236,6 +415,13 @@ size_t StreamingSamplerSound::getActualPreloadSize() const
 {
 	auto bytesPerSample = fileReader.isMonolithic() ? sizeof(int16) : sizeof(float);
 
+#if HISE_COMPRESS_PRELOAD_BUFFERS
+	if (compressedPreloadBuffer.getNumSamples() != 0)
+	{
+		return hasActiveState() ? (size_t)(preloadBuffer.getNumSamples() * preloadBuffer.getNumChannels()) * bytesPerSample + compressedPreloadBuffer.getMemoryUsage() + (size_t)(loopBuffer.getNumSamples() *loopBuffer.getNumChannels()) * bytesPerSample : 0;
+	}
+#endif
+
 	return hasActiveState() ? (size_t)(internalPreloadSize *preloadBuffer.getNumChannels()) * bytesPerSample + (size_t)(loopBuffer.getNumSamples() *loopBuffer.getNumChannels()) * bytesPerSample : 0;
 }
 
@@ -635,6 +821,18 @@ void StreamingSamplerSound::fillInternal(hlac::HiseSampleBuffer &sampleBuffer, i
 		{
 			hlac::HiseSampleBuffer::copy(sampleBuffer, preloadBuffer, offsetInBuffer, indexInPreloadBuffer, samplesToCopy);
 		}
+#if HISE_COMPRESS_PRELOAD_BUFFERS
+		else if (compressedPreloadBuffer.getNumSamples() != 0)
+		{
+			// Copy what's left in the decoded part and decompress the rest
+			const int numDecoded = preloadBuffer.getNumSamples();
+			const int numFromDecodedPart = jlimit(0, samplesToCopy, numDecoded - indexInPreloadBuffer);
+
+			hlac::HiseSampleBuffer::copy(sampleBuffer, preloadBuffer, offsetInBuffer, indexInPreloadBuffer, numFromDecodedPart);
+
+			compressedPreloadBuffer.decode(sampleBuffer, offsetInBuffer + numFromDecodedPart, indexInPreloadBuffer + numFromDecodedPart - numDecoded, samplesToCopy - numFromDecodedPart);
+		}
+#endif
 		else
 		{
 			jassertfalse;
@@ -650,6 +848,107 @@ void StreamingSamplerSound::fillInternal(hlac::HiseSampleBuffer &sampleBuffer, i
 	}
 }
 
+// =============================================================================================================================================== StreamingSamplerSound::CompressedPreloadBuffer methods
+
+void StreamingSamplerSound::CompressedPreloadBuffer::compress(const hlac::HiseSampleBuffer& source, int startSample, int numSamplesToCompress)
+{
+	jassert(!source.isFloatingPoint());
+	jassert(startSample + numSamplesToCompress <= source.getNumSamples());
+
+	clear();
+
+	if (numSamplesToCompress <= 0)
+		return;
+
+	numChannels = source.getNumChannels();
+
+	// The encoder expects float data, the conversion is lossless for 16bit values
+	AudioSampleBuffer floatData(numChannels, numSamplesToCompress);
+
+	for (int i = 0; i < numChannels; i++)
+		hlac::CompressionHelpers::fastInt16ToFloat(source.getReadPointer(i, startSample), floatData.getWritePointer(i), numSamplesToCompress);
+
+	numBlocks = numSamplesToCompress / COMPRESSION_BLOCK_SIZE + 1;
+	blockOffsets.calloc(numBlocks + 1);
+
+	hlac::HlacEncoder encoder;
+
+	auto options = hlac::HlacEncoder::CompressorOptions::getPreset(hlac::HlacEncoder::CompressorOptions::Presets::Diff);
+	encoder.setOptions(options);
+
+	{
+		MemoryOutputStream output(data, false);
+		encoder.compress(floatData, output, blockOffsets);
+	}
+
+	numSamples = numSamplesToCompress;
+}
+
+void StreamingSamplerSound::CompressedPreloadBuffer::decode(hlac::HiseSampleBuffer& destination, int startSampleInDestination, int startSampleInSource, int numSamplesToDecode) const
+{
+	jassert(startSampleInSource >= 0);
+	jassert(startSampleInSource + numSamplesToDecode <= numSamples);
+	jassert(startSampleInDestination + numSamplesToDecode <= destination.getNumSamples());
+
+	numSamplesToDecode = jmin(numSamplesToDecode, numSamples - startSampleInSource);
+
+	if (numSamplesToDecode <= 0)
+		return;
+
+	const bool decodeStereo = numChannels == 2;
+
+	MemoryInputStream input(data, false);
+
+	hlac::HlacDecoder decoder;
+	decoder.setupForDecompression();
+
+	const int blockIndex = startSampleInSource / COMPRESSION_BLOCK_SIZE;
+
+	decoder.seekToPosition(input, (uint32)startSampleInSource, blockOffsets[blockIndex]);
+
+	// The decoder writes until the end of the buffer, so give it a view with the exact size
+	if (destination.isFloatingPoint())
+	{
+		float* d[2] = { static_cast<float*>(destination.getWritePointer(0, startSampleInDestination)),
+						decodeStereo ? static_cast<float*>(destination.getWritePointer(1, startSampleInDestination)) : nullptr };
+
+		AudioSampleBuffer target(d, numChannels, numSamplesToDecode);
+		hlac::HiseSampleBuffer view(target);
+
+		decoder.decode(view, decodeStereo, input, startSampleInSource, numSamplesToDecode);
+	}
+	else
+	{
+		int16* d[2] = { static_cast<int16*>(destination.getWritePointer(0, startSampleInDestination)),
+						decodeStereo ? static_cast<int16*>(destination.getWritePointer(1, startSampleInDestination)) : nullptr };
+
+		hlac::HiseSampleBuffer view(d, numChannels, numSamplesToDecode);
+
+		decoder.decode(view, decodeStereo, input, startSampleInSource, numSamplesToDecode);
+	}
+
+	if (!decodeStereo && destination.getNumChannels() == 2)
+	{
+		const size_t bytesPerSample = destination.isFloatingPoint() ? sizeof(float) : sizeof(int16);
+
+		memcpy(destination.getWritePointer(1, startSampleInDestination), destination.getReadPointer(0, startSampleInDestination), bytesPerSample * numSamplesToDecode);
+	}
+}
+
+void StreamingSamplerSound::CompressedPreloadBuffer::decodeAll(hlac::HiseSampleBuffer& destination, int startSampleInDestination) const
+{
+	decode(destination, startSampleInDestination, 0, numSamples);
+}
+
+void StreamingSamplerSound::CompressedPreloadBuffer::clear()
+{
+	data.reset();
+	blockOffsets.free();
+	numBlocks = 0;
+	numSamples = 0;
+	numChannels = 0;
+}
+
 // =============================================================================================================================================== StreamingSamplerSound::FileReader methods
 
 
@@ -947,6 +1246,20 @@ AudioFormatReader* StreamingSamplerSound::FileReader::createMonolithicReaderForP
 	}
 }
 
+String StreamingSamplerSound::FileReader::getMonolithIdentifier() const
+{
+	if (monolithicInfo != nullptr)
+	{
+		String id;
+
+		id << monolithicInfo->getMonolithFile(monolithicChannelIndex).getFullPathName() << "@" << getMonolithOffset();
+
+		return id;
+	}
+
+	return String();
+}
+
 void StreamingSamplerSound::FileReader::setMonolithicInfo(MonolithInfoToUse* info, int channelIndex, int sampleIndex)
 {
 	monolithicInfo = info;
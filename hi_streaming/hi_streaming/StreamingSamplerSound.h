@@ -38,6 +38,55 @@
 
 // ==================================================================================================================================================
 
+/** A process wide cache for the preload buffers of monolithic samples.
+*
+*	If HISE_SHARE_POOL_DATA_BETWEEN_INSTANCES is enabled, every StreamingSamplerSound that is loaded from a monolith fetches its preload
+*	buffer from this cache (which is held by a SharedResourcePointer), so multiple instances of the same plugin only keep one copy in memory.
+*
+*	The key contains the monolith file, the offset and every property that changes the content of the preload buffer, so instance specific settings
+*	(preload size, sample range or loop points) simply end up in another entry. Reversed samples detach from the cache and use their own buffer.
+*/
+class SharedPreloadBufferCache
+{
+public:
+
+	/** A reference counted preload buffer. The sounds only use a view of the data, so don't resize it after it was loaded. */
+	class Entry : public ReferenceCountedObject
+	{
+	public:
+
+		typedef ReferenceCountedObjectPtr<Entry> Ptr;
+
+		Entry(const String& key_, int numChannels, int numSamples) :
+			key(key_),
+			buffer(false, numChannels, numSamples)
+		{};
+
+		const String key;
+		hlac::HiseSampleBuffer buffer;
+
+		/** Lock this while checking / filling the buffer so that two instances don't load the same entry. */
+		CriticalSection loadLock;
+		bool loaded = false;
+
+		JUCE_DECLARE_NON_COPYABLE(Entry);
+	};
+
+	/** Returns the entry for the given key or creates a new (unloaded) 16bit buffer with the given size. */
+	Entry::Ptr getEntry(const String& key, int numChannels, int numSamples);
+
+	/** Releases the reference and removes the entry from the cache if no other sound uses it. */
+	void releaseEntry(Entry::Ptr& entryToRelease);
+
+	/** Returns the number of buffers that are currently shared. */
+	int getNumEntries() const;
+
+private:
+
+	CriticalSection lock;
+	ReferenceCountedArray<Entry> entries;
+};
+
 /** A SamplerSound which provides buffered disk streaming using memory mapped file access and a preloaded sample start. */
 class StreamingSamplerSound : public SynthesiserSound
 {
@@ -291,6 +340,10 @@ private:
 
 
 		String getFileName(bool getFullPath);
+
+		/** Returns a string that identifies the monolith file and the position of the sample within it. */
+		String getMonolithIdentifier() const;
+
 		void checkFileReference();
 		int64 getHashCode() { return hashCode; };
 
@@ -415,6 +468,40 @@ private:
 
 	// ==============================================================================================================================================
 
+	/** Keeps a part of a 16bit preload buffer HLAC compressed in memory. */
+	class CompressedPreloadBuffer
+	{
+	public:
+
+		/** Compresses the given range of the source buffer (which must use 16bit data). */
+		void compress(const hlac::HiseSampleBuffer& source, int startSample, int numSamplesToCompress);
+
+		/** Decodes the samples into the destination buffer.
+		*
+		*	This creates a decoder on the stack (which allocates its work buffers), so only call this from the background thread.
+		*/
+		void decode(hlac::HiseSampleBuffer& destination, int startSampleInDestination, int startSampleInSource, int numSamplesToDecode) const;
+
+		/** Decodes all samples and writes it to the destination buffer at the given offset. */
+		void decodeAll(hlac::HiseSampleBuffer& destination, int startSampleInDestination) const;
+
+		void clear();
+
+		int getNumSamples() const noexcept { return numSamples; }
+
+		size_t getMemoryUsage() const noexcept { return data.getSize() + (size_t)numBlocks * sizeof(uint32); }
+
+	private:
+
+		MemoryBlock data;
+		HeapBlock<uint32> blockOffsets;
+		int numBlocks = 0;
+		int numSamples = 0;
+		int numChannels = 0;
+	};
+
+	// ==============================================================================================================================================
+
 	void loopChanged();
 	void lengthChanged();
 
@@ -428,6 +515,23 @@ private:
 	// used to wrap the read process for looping
 	void fillInternal(hlac::HiseSampleBuffer &sampleBuffer, int samplesToCopy, int uptime, int offsetInBuffer = 0) const;
 
+	/** Reads the sample start (and the loop if it fits) from the disk into the given buffer which must be already allocated. */
+	void fillPreloadBuffer(hlac::HiseSampleBuffer& bufferToFill);
+
+	/** Uses the preload buffer from the shared cache (and loads it if it's not there yet). */
+	void loadSharedPreloadBuffer();
+
+	/** Copies the shared preload buffer into an own buffer so that it can be modified. */
+	void detachSharedPreloadBuffer();
+
+	void releaseSharedPreloadBuffer();
+
+	/** Compresses everything after the decoded start of the preload buffer and shrinks the preload buffer. */
+	void compressPreloadBuffer();
+
+	/** Restores the full decoded preload buffer (eg. before it gets reversed). */
+	void decompressPreloadBuffer();
+
 
 	// ==============================================================================================================================================
 
@@ -441,6 +545,16 @@ private:
 	friend class SampleLoader;
 
 	hlac::HiseSampleBuffer preloadBuffer;
+
+#if HISE_SHARE_POOL_DATA_BETWEEN_INSTANCES
+	SharedResourcePointer<SharedPreloadBufferCache> sharedPreloadCache;
+	SharedPreloadBufferCache::Entry::Ptr sharedPreloadBuffer;
+#endif
+
+#if HISE_COMPRESS_PRELOAD_BUFFERS
+	CompressedPreloadBuffer compressedPreloadBuffer;
+#endif
+
 	double sampleRate;
 
 	int monolithOffset;
@@ -185,7 +185,11 @@ StereoChannelData SampleLoader::fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuf
 		const int indexBeforeWrap = jmax<int>(0, (int)(readIndexDouble));
 		const int numSamplesInFirstBuffer = localReadBuffer->getNumSamples() - indexBeforeWrap;
 
+		// Only copy the span that is needed for the interpolation (+1 for the interpolation partner of the last sample)
+		const int numSamplesNeeded = jmin<int>(voiceBuffer.getNumSamples(), maxSampleIndexForFillOperation - indexBeforeWrap + 1);
+
 		jassert(numSamplesInFirstBuffer >= 0);
+		jassert(numSamplesInFirstBuffer <= numSamplesNeeded);
 
 		if (numSamplesInFirstBuffer > 0)
 		{
@@ -197,9 +201,13 @@ StereoChannelData SampleLoader::fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuf
 
 		if ((numSamplesAvailableInSecondBuffer > 0) && (numSamplesAvailableInSecondBuffer <= localWriteBuffer->getNumSamples()))
 		{
-			const int numSamplesToCopyFromSecondBuffer = jmin<int>(numSamplesAvailableInSecondBuffer, voiceBuffer.getNumSamples() - offset);
+			const int numSamplesToCopyFromSecondBuffer = jmin<int>(numSamplesAvailableInSecondBuffer, numSamplesNeeded - offset);
 
-			if (writeBufferIsBeingFilled)
+			if (numSamplesToCopyFromSecondBuffer <= 0)
+			{
+				// Nothing to do (the span ends exactly at the wrap point)
+			}
+			else if (writeBufferIsBeingFilled)
 			{
 				voiceBuffer.clear(offset, numSamplesToCopyFromSecondBuffer);
 			}
@@ -207,6 +215,12 @@ StereoChannelData SampleLoader::fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuf
 			{
 				hlac::HiseSampleBuffer::copy(voiceBuffer, *localWriteBuffer, offset, 0, numSamplesToCopyFromSecondBuffer);
 			}
+
+			// The temp buffer isn't cleared anymore, so make sure there are no leftovers from the last copy operation
+			const int numSamplesToClear = numSamplesNeeded - offset - jmax<int>(0, numSamplesToCopyFromSecondBuffer);
+
+			if (numSamplesToClear > 0)
+				voiceBuffer.clear(numSamplesNeeded - numSamplesToClear, numSamplesToClear);
 		}
 		else
 		{
@@ -560,8 +574,86 @@ template <typename SignalType> void interpolateStereoSamples(const SignalType* i
 	}
 }
 
+template <typename SignalType> void interpolateStereoSamplesWithIndexes(const SignalType* inL, const SignalType* inR, const int* positions, const float* alphas, float* outL, float* outR, int numSamples, bool isFloat)
+{
+	const float gainFactor = isFloat ? 1.0f : (1.0f / (float)INT16_MAX);
+
+	for (int i = 0; i < numSamples; i++)
+	{
+		const int pos = positions[i];
+		const float alpha = alphas[i];
+		const float invAlpha = 1.0f - alpha;
+
+		const float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
+		const float r = ((float)inR[pos] * invAlpha + (float)inR[pos + 1] * alpha);
+
+		outL[i] = l * gainFactor;
+		outR[i] = r * gainFactor;
+	}
+}
+
+void StreamingSamplerVoice::InterpolationIndexes::setSize(int maxNumSamples)
+{
+	if (maxNumSamples > size)
+	{
+		positions.calloc(maxNumSamples);
+		alphas.calloc(maxNumSamples);
+		size = maxNumSamples;
+	}
+}
+
+void StreamingSamplerVoice::InterpolationIndexes::calculate(const float* pitchData, int startSample, double startAlpha, double uptimeDelta, int numSamples)
+{
+	jassert(numSamples <= size);
+
+	numSamples = jmin<int>(numSamples, size);
+
+	// This must yield exactly the same positions as interpolateStereoSamples()
+	float indexInBufferFloat = (float)startAlpha;
+
+	if (pitchData != nullptr)
+	{
+		pitchData += startSample;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			const int pos = int(indexInBufferFloat);
+			positions[i] = pos;
+			alphas[i] = indexInBufferFloat - (float)pos;
+
+			indexInBufferFloat += pitchData[i];
+		}
+	}
+	else
+	{
+		const float uptimeDeltaFloat = (float)uptimeDelta;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			const int pos = int(indexInBufferFloat);
+			positions[i] = pos;
+			alphas[i] = indexInBufferFloat - (float)pos;
+
+			indexInBufferFloat += uptimeDeltaFloat;
+		}
+	}
+
+	numCalculated = numSamples;
+}
 
 void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int startSample, int numSamples)
+{
+	renderInternal(outputBuffer, startSample, numSamples, nullptr);
+}
+
+void StreamingSamplerVoice::renderNextBlockWithSharedIndexes(AudioSampleBuffer &outputBuffer, int startSample, int numSamples, const InterpolationIndexes& sharedIndexes)
+{
+	jassert(sharedIndexes.numCalculated == numSamples);
+
+	renderInternal(outputBuffer, startSample, numSamples, &sharedIndexes);
+}
+
+void StreamingSamplerVoice::renderInternal(AudioSampleBuffer &outputBuffer, int startSample, int numSamples, const InterpolationIndexes* sharedIndexes)
 {
 	const StreamingSamplerSound *sound = loader.getLoadedSound();
 
@@ -580,9 +672,8 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 
 		jassert(tempVoiceBuffer != nullptr);
 
-		tempVoiceBuffer->clear();
-
-		// Copy the not resampled values into the voice buffer.
+		// This returns pointers directly into the preload / streaming buffer if the span is contiguous
+		// and only copies the needed samples into the temp buffer at the wrap points (so there's no need to clear it).
 		StereoChannelData data = loader.fillVoiceBuffer(*tempVoiceBuffer, pitchCounter + startAlpha);
 
 		float* outL = outputBuffer.getWritePointer(0, startSample);
@@ -603,14 +694,20 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 			const float* const inL = static_cast<const float*>(data.leftChannel);
 			const float* const inR = static_cast<const float*>(data.rightChannel);
 
-			interpolateStereoSamples(inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, true);
+			if (sharedIndexes != nullptr)
+				interpolateStereoSamplesWithIndexes(inL, inR, sharedIndexes->positions.getData(), sharedIndexes->alphas.getData(), outL, outR, numSamples, true);
+			else
+				interpolateStereoSamples(inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, true);
 		}
 		else
 		{
 			const int16* const inL = static_cast<const int16*>(data.leftChannel);
 			const int16* const inR = static_cast<const int16*>(data.rightChannel);
 
-			interpolateStereoSamples(inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, false);
+			if (sharedIndexes != nullptr)
+				interpolateStereoSamplesWithIndexes(inL, inR, sharedIndexes->positions.getData(), sharedIndexes->alphas.getData(), outL, outR, numSamples, false);
+			else
+				interpolateStereoSamples(inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, false);
 
 		}
 
@@ -72,6 +72,12 @@ public:
 
 	void setStreamingBufferDataType(bool shouldBeFloat);
 
+	/** Returns the sample data for the next block.
+	*
+	*	If the requested span lies within the current read buffer, the returned data points directly into the
+	*	preload or streaming buffer. Only if the span wraps around the buffer end, the needed samples are copied
+	*	into the given voiceBuffer and the returned data points to it.
+	*/
 	StereoChannelData fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuffer, double numSamples) const;
 
 	/** Advances the read index and returns `false` if the streaming thread is blocked. */
@@ -223,6 +229,32 @@ public:
 	/** Adds it's output to the outputBuffer. */
 	void renderNextBlock(AudioSampleBuffer &outputBuffer, int startSample, int numSamples) override;
 
+	/** Precalculated interpolation positions and weights for one block.
+	*
+	*	If multiple voices play the same position with the same pitch (eg. the mic positions of a multimic sample),
+	*	the interpolation positions only need to be calculated once and can be passed to every voice.
+	*/
+	struct InterpolationIndexes
+	{
+		/** Allocates the arrays. Call this in prepareToPlay(). */
+		void setSize(int maxNumSamples);
+
+		/** Calculates the positions relative to the start of the data that is returned by the SampleLoader. */
+		void calculate(const float* pitchData, int startSample, double startAlpha, double uptimeDelta, int numSamples);
+
+		HeapBlock<int> positions;
+		HeapBlock<float> alphas;
+
+		int size = 0;
+		int numCalculated = 0;
+	};
+
+	/** Same as renderNextBlock(), but uses the precalculated interpolation positions instead of calculating them for this voice. 
+	*
+	*	The indexes must be calculated with the pitch data and uptime delta of this voice.
+	*/
+	void renderNextBlockWithSharedIndexes(AudioSampleBuffer &outputBuffer, int startSample, int numSamples, const InterpolationIndexes& sharedIndexes);
+
 	/** You can pass a pointer with float values containing pitch information for each sample.
 	*
 	*	The array size should be exactly the number of samples that are calculated in the current renderNextBlock method.
@@ -275,6 +307,8 @@ public:
 
 private:
 
+	void renderInternal(AudioSampleBuffer &outputBuffer, int startSample, int numSamples, const InterpolationIndexes* sharedIndexes);
+
 	double pitchCounter = 0.0;
 
 	hlac::HiseSampleBuffer* tvb = nullptr;